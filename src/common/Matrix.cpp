@@ -133,6 +133,106 @@ void Matrix4::multiply(const Matrix4 &a, const Matrix4 &b, Matrix4 &t)
 	multiply(a, b, t.e);
 }
 
+// The SIMD paths below do the same multiplies and adds in the same order as
+// the scalar templates, so their results match.
+
+void Matrix4::transformXY(Vector2 *dst, const Vector2 *src, int size) const
+{
+	int i = 0;
+
+#if defined(LOVE_SIMD_SSE)
+
+	// Two vertices per iteration: [x0 y0 x1 y1].
+	const __m128 c0 = _mm_setr_ps(e[0], e[1], e[0], e[1]);
+	const __m128 c1 = _mm_setr_ps(e[4], e[5], e[4], e[5]);
+	const __m128 c3 = _mm_setr_ps(e[12], e[13], e[12], e[13]);
+
+	for (; i + 2 <= size; i += 2)
+	{
+		__m128 v = _mm_loadu_ps(&src[i].x);
+		__m128 xs = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 0, 0));
+		__m128 ys = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 1, 1));
+
+		__m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xs, c0), _mm_mul_ps(ys, c1)), c3);
+		_mm_storeu_ps(&dst[i].x, r);
+	}
+
+#elif defined(LOVE_SIMD_NEON)
+
+	// Four vertices per iteration, de-interleaved into x and y lanes.
+	for (; i + 4 <= size; i += 4)
+	{
+		float32x4x2_t v = vld2q_f32(&src[i].x);
+
+		float32x4x2_t r;
+		r.val[0] = vaddq_f32(vaddq_f32(vmulq_n_f32(v.val[0], e[0]), vmulq_n_f32(v.val[1], e[4])), vdupq_n_f32(e[12]));
+		r.val[1] = vaddq_f32(vaddq_f32(vmulq_n_f32(v.val[0], e[1]), vmulq_n_f32(v.val[1], e[5])), vdupq_n_f32(e[13]));
+
+		vst2q_f32(&dst[i].x, r);
+	}
+
+#endif
+
+	for (; i < size; i++)
+	{
+		float x = (e[0]*src[i].x) + (e[4]*src[i].y) + (e[12]);
+		float y = (e[1]*src[i].x) + (e[5]*src[i].y) + (e[13]);
+
+		dst[i].x = x;
+		dst[i].y = y;
+	}
+}
+
+void Matrix4::transformXY0(Vector3 *dst, const Vector2 *src, int size) const
+{
+	int i = 0;
+
+#if defined(LOVE_SIMD_SSE)
+
+	// Each vertex is computed as [x y z _]. The unused 4th lane spills into
+	// the next vertex, which is written afterwards, so the last vertex is left
+	// to the scalar loop.
+	const __m128 c0 = _mm_loadu_ps(&e[0]);
+	const __m128 c1 = _mm_loadu_ps(&e[4]);
+	const __m128 c3 = _mm_loadu_ps(&e[12]);
+
+	for (; i + 1 < size; i++)
+	{
+		__m128 xs = _mm_set1_ps(src[i].x);
+		__m128 ys = _mm_set1_ps(src[i].y);
+
+		__m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xs, c0), _mm_mul_ps(ys, c1)), c3);
+		_mm_storeu_ps(&dst[i].x, r);
+	}
+
+#elif defined(LOVE_SIMD_NEON)
+
+	for (; i + 4 <= size; i += 4)
+	{
+		float32x4x2_t v = vld2q_f32(&src[i].x);
+
+		float32x4x3_t r;
+		r.val[0] = vaddq_f32(vaddq_f32(vmulq_n_f32(v.val[0], e[0]), vmulq_n_f32(v.val[1], e[4])), vdupq_n_f32(e[12]));
+		r.val[1] = vaddq_f32(vaddq_f32(vmulq_n_f32(v.val[0], e[1]), vmulq_n_f32(v.val[1], e[5])), vdupq_n_f32(e[13]));
+		r.val[2] = vaddq_f32(vaddq_f32(vmulq_n_f32(v.val[0], e[2]), vmulq_n_f32(v.val[1], e[6])), vdupq_n_f32(e[14]));
+
+		vst3q_f32(&dst[i].x, r);
+	}
+
+#endif
+
+	for (; i < size; i++)
+	{
+		float x = (e[0]*src[i].x) + (e[4]*src[i].y) + (e[12]);
+		float y = (e[1]*src[i].x) + (e[5]*src[i].y) + (e[13]);
+		float z = (e[2]*src[i].x) + (e[6]*src[i].y) + (e[14]);
+
+		dst[i].x = x;
+		dst[i].y = y;
+		dst[i].z = z;
+	}
+}
+
 // | e0 e4 e8  e12 |
 // | e1 e5 e9  e13 |
 // | e2 e6 e10 e14 |
@@ -197,6 +197,12 @@ class Matrix4
 	template <typename Vdst, typename Vsrc>
 	void transformXY(Vdst *dst, const Vsrc *src, int size) const;
 
+	/**
+	 * Tightly packed version of the above, using SIMD instructions when
+	 * available. Results are identical to the generic version.
+	 **/
+	void transformXY(Vector2 *dst, const Vector2 *src, int size) const;
+
 	/**
 	 * Transforms an array of 2-component vertices by this Matrix, and stores
 	 * them in an array of 3-component vertices.
@@ -204,6 +210,12 @@ class Matrix4
 	template <typename Vdst, typename Vsrc>
 	void transformXY0(Vdst *dst, const Vsrc *src, int size) const;
 
+	/**
+	 * Tightly packed version of the above, using SIMD instructions when
+	 * available. Results are identical to the generic version.
+	 **/
+	void transformXY0(Vector3 *dst, const Vector2 *src, int size) const;
+
 	/**
 	 * Transforms an array of 3-component vertices by this Matrix. The source
 	 * and destination arrays may be the same.
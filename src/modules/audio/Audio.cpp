@@ -33,6 +33,7 @@ namespace audio
 {
 
 static bool requestRecPermission = false;
+static bool offlineAudio = false;
 
 void setRequestRecordingPermission(bool rec)
 {
@@ -44,6 +45,16 @@ bool getRequestRecordingPermission()
 	return requestRecPermission;
 }
 
+void setOfflineAudio(bool offline)
+{
+	offlineAudio = offline;
+}
+
+bool getOfflineAudio()
+{
+	return offlineAudio;
+}
+
 bool hasRecordingPermission()
 {
 #if defined(LOVE_ANDROID)
@@ -87,6 +98,29 @@ void Audio::setPlaybackDevice(const char */*name*/)
 	throw love::Exception("Re-setting output device is not supported.");
 }
 
+void Audio::render(love::sound::SoundData */*target*/, int /*start*/, int /*count*/)
+{
+	throw love::Exception("Rendering audio is only supported by the offline audio module.");
+}
+
+void Audio::setSourceStates(const std::vector<Source*> &sources, const float *states)
+{
+	for (size_t i = 0; i < sources.size(); i++)
+	{
+		Source *s = sources[i];
+		const float *state = states + i * SOURCE_STATE_COMPONENTS;
+
+		if (s->getChannelCount() == 1)
+		{
+			s->setPosition((float *) &state[0]);
+			s->setVelocity((float *) &state[3]);
+		}
+
+		s->setVolume(state[6]);
+		s->setPitch(state[7]);
+	}
+}
+
 StringMap<Audio::DistanceModel, Audio::DISTANCE_MAX_ENUM>::Entry Audio::distanceModelEntries[] =
 {
 	{"none", Audio::DISTANCE_NONE},
@@ -73,6 +73,17 @@ void requestRecordingPermission();
  */
 void showRecordingPermissionMissingDialog();
 
+/*
+ * Sets whether the offline (software-mixed, render-only) audio module
+ * should be used instead of one which plays to an audio device.
+ */
+void setOfflineAudio(bool offline);
+
+/*
+ * Gets whether the offline audio module will be used.
+ */
+bool getOfflineAudio();
+
 /**
  * The Audio module is responsible for playing back raw sound samples.
  **/
@@ -313,6 +324,28 @@ class Audio : public Module
 	 */
 	virtual void setPlaybackDevice(const char *name);
 
+	/**
+	 * Mixes all playing Sources and writes the result over a range of samples
+	 * of the given SoundData, replacing what was there. The Sources advance
+	 * by that many samples at the SoundData's sample rate. Only supported by
+	 * the offline audio module.
+	 **/
+	virtual void render(love::sound::SoundData *target, int start, int count);
+
+	/**
+	 * Number of floats per Source in setSourceStates data: position (3),
+	 * velocity (3), volume and pitch.
+	 **/
+	static const int SOURCE_STATE_COMPONENTS = 8;
+
+	/**
+	 * Sets the position, velocity, volume and pitch of many Sources at once.
+	 * Position and velocity are ignored for multi-channel Sources.
+	 * @param sources The Sources to update.
+	 * @param states SOURCE_STATE_COMPONENTS floats for each Source.
+	 **/
+	virtual void setSourceStates(const std::vector<Source*> &sources, const float *states);
+
 protected:
 
 	Audio(const char *name);
@@ -20,6 +20,9 @@
 
 #include "RecordingDevice.h"
 
+// C++
+#include <algorithm>
+
 namespace love
 {
 namespace audio
@@ -35,5 +38,20 @@ RecordingDevice::~RecordingDevice()
 {
 }
 
+int RecordingDevice::getReadableSampleCount(const love::sound::SoundData *soundData, int start, int count) const
+{
+	if (soundData->getChannelCount() != getChannelCount() || soundData->getBitDepth() != getBitDepth())
+		throw love::Exception("SoundData must have the same format as the recording (%d channels, %d bits per sample).", getChannelCount(), getBitDepth());
+
+	int capacity = soundData->getSampleCount();
+	if (start < 0 || start > capacity)
+		throw love::Exception("Invalid start sample: %d", start);
+
+	if (count < 0)
+		count = capacity - start;
+
+	return std::max(std::min(std::min(count, capacity - start), getSampleCount()), 0);
+}
+
 } //audio
 } //love
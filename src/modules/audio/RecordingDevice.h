@@ -66,6 +66,17 @@ class RecordingDevice : public love::Object
 	 **/
 	virtual love::sound::SoundData *getData() = 0;
 
+	/**
+	 * Retrieves recorded data into an existing SoundData instead of creating
+	 * a new one, so it can be reused each time the device is polled.
+	 * @param soundData SoundData with the same format as the recording.
+	 * @param start The first sample in the SoundData to write to.
+	 * @param count The maximum number of samples to read, or -1 for as many
+	 * as fit after start.
+	 * @return The number of samples written to the SoundData.
+	 **/
+	virtual int getData(love::sound::SoundData *soundData, int start, int count) = 0;
+
 	/**
 	 * @return C string device name.
 	 **/ 
@@ -101,6 +112,14 @@ class RecordingDevice : public love::Object
 	 **/
 	virtual bool isRecording() const = 0;
 
+protected:
+
+	/**
+	 * Validates the arguments of getData(soundData, start, count).
+	 * @return The number of samples which can be read into the SoundData.
+	 **/
+	int getReadableSampleCount(const love::sound::SoundData *soundData, int start, int count) const;
+
 }; //RecordingDevice
 
 } //audio
@@ -39,6 +39,7 @@ class RecordingDevice : public love::audio::RecordingDevice
 	virtual bool start(int samples, int sampleRate, int bitDepth, int channels);
 	virtual void stop();
 	virtual love::sound::SoundData *getData();
+	virtual int getData(love::sound::SoundData *soundData, int start, int count);
 	virtual const char *getName() const;
 	virtual int getMaxSamples() const;
 	virtual int getSampleCount() const;
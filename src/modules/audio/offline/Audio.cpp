@@ -0,0 +1,379 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "Audio.h"
+#include "common/Exception.h"
+
+// C++
+#include <algorithm>
+#include <limits>
+
+namespace love
+{
+namespace audio
+{
+namespace offline
+{
+
+Audio::Audio()
+	: love::audio::Audio("love.audio.offline")
+	, volume(1.0f)
+	, position()
+	, orientation()
+	, velocity()
+	, dopplerScale(1.0f)
+	, distanceModel(DISTANCE_INVERSE_CLAMPED)
+	, loopback(new RecordingDevice(this))
+{
+	// Same defaults as OpenAL's listener.
+	orientation[2] = -1.0f;
+	orientation[4] = 1.0f;
+
+	capture.push_back(loopback);
+}
+
+Audio::~Audio()
+{
+	for (Source *s : active)
+		s->release();
+
+	loopback->release();
+}
+
+love::audio::Source *Audio::newSource(love::sound::Decoder *decoder)
+{
+	return new Source(this, decoder);
+}
+
+love::audio::Source *Audio::newSource(love::sound::SoundData *soundData)
+{
+	return new Source(this, soundData);
+}
+
+love::audio::Source *Audio::newSource(int sampleRate, int bitDepth, int channels, int buffers)
+{
+	return new Source(this, sampleRate, bitDepth, channels, buffers);
+}
+
+int Audio::getActiveSourceCount() const
+{
+	thread::Lock l(mutex);
+	return (int) active.size();
+}
+
+int Audio::getMaxSources() const
+{
+	return std::numeric_limits<int>::max();
+}
+
+bool Audio::play(love::audio::Source *source)
+{
+	return source->play();
+}
+
+bool Audio::play(const std::vector<love::audio::Source*> &sources)
+{
+	bool success = true;
+	for (love::audio::Source *s : sources)
+		success = s->play() && success;
+	return success;
+}
+
+void Audio::stop(love::audio::Source *source)
+{
+	source->stop();
+}
+
+void Audio::stop(const std::vector<love::audio::Source*> &sources)
+{
+	for (love::audio::Source *s : sources)
+		s->stop();
+}
+
+void Audio::stop()
+{
+	std::vector<Source *> sources;
+
+	{
+		auto l = lock();
+		sources = active;
+		for (Source *s : sources)
+			s->retain();
+	}
+
+	for (Source *s : sources)
+	{
+		s->stop();
+		s->release();
+	}
+}
+
+void Audio::pause(love::audio::Source *source)
+{
+	source->pause();
+}
+
+void Audio::pause(const std::vector<love::audio::Source*> &sources)
+{
+	for (love::audio::Source *s : sources)
+		s->pause();
+}
+
+std::vector<love::audio::Source*> Audio::pause()
+{
+	std::vector<love::audio::Source*> paused;
+
+	{
+		auto l = lock();
+		for (Source *s : active)
+		{
+			if (s->isPlaying())
+				paused.push_back(s);
+		}
+	}
+
+	// Paused Sources stay in the active list (and retained) until stopped.
+	for (love::audio::Source *s : paused)
+		s->pause();
+
+	return paused;
+}
+
+void Audio::setVolume(float volume)
+{
+	this->volume = volume;
+}
+
+float Audio::getVolume() const
+{
+	return volume;
+}
+
+void Audio::getPosition(float *v) const
+{
+	for (int i = 0; i < 3; i++)
+		v[i] = position[i];
+}
+
+void Audio::setPosition(float *v)
+{
+	auto l = lock();
+	for (int i = 0; i < 3; i++)
+		position[i] = v[i];
+}
+
+void Audio::getOrientation(float *v) const
+{
+	for (int i = 0; i < 6; i++)
+		v[i] = orientation[i];
+}
+
+void Audio::setOrientation(float *v)
+{
+	auto l = lock();
+	for (int i = 0; i < 6; i++)
+		orientation[i] = v[i];
+}
+
+void Audio::getVelocity(float *v) const
+{
+	for (int i = 0; i < 3; i++)
+		v[i] = velocity[i];
+}
+
+void Audio::setVelocity(float *v)
+{
+	for (int i = 0; i < 3; i++)
+		velocity[i] = v[i];
+}
+
+void Audio::setDopplerScale(float scale)
+{
+	if (scale >= 0.0f)
+		dopplerScale = scale;
+}
+
+float Audio::getDopplerScale() const
+{
+	return dopplerScale;
+}
+
+const std::vector<love::audio::RecordingDevice*> &Audio::getRecordingDevices()
+{
+	return capture;
+}
+
+Audio::DistanceModel Audio::getDistanceModel() const
+{
+	return distanceModel;
+}
+
+void Audio::setDistanceModel(DistanceModel distanceModel)
+{
+	this->distanceModel = distanceModel;
+}
+
+bool Audio::setEffect(const char *, std::map<Effect::Parameter, float> &)
+{
+	return false;
+}
+
+bool Audio::unsetEffect(const char *)
+{
+	return false;
+}
+
+bool Audio::getEffect(const char *, std::map<Effect::Parameter, float> &)
+{
+	return false;
+}
+
+bool Audio::getActiveEffects(std::vector<std::string> &) const
+{
+	return false;
+}
+
+int Audio::getMaxSceneEffects() const
+{
+	return 0;
+}
+
+int Audio::getMaxSourceEffects() const
+{
+	return 0;
+}
+
+bool Audio::isEFXsupported() const
+{
+	return false;
+}
+
+bool Audio::setOutputSpatialization(bool, const char *)
+{
+	return false;
+}
+
+bool Audio::getOutputSpatialization(const char *&filter) const
+{
+	filter = nullptr;
+	return false;
+}
+
+void Audio::getOutputSpatializationFilters(std::vector<std::string> &) const
+{
+}
+
+void Audio::pauseContext()
+{
+}
+
+void Audio::resumeContext()
+{
+}
+
+std::string Audio::getPlaybackDevice()
+{
+	return "";
+}
+
+void Audio::getPlaybackDevices(std::vector<std::string> &/*list*/)
+{
+}
+
+void Audio::render(love::sound::SoundData *target, int start, int count)
+{
+	int channels = target->getChannelCount();
+	if (channels != 1 && channels != 2)
+		throw love::Exception("Audio can only be rendered to mono or stereo SoundData.");
+
+	if (start < 0 || count < 0 || start + count > target->getSampleCount())
+		throw love::Exception("Render range is out of bounds of the SoundData.");
+
+	if (count == 0)
+		return;
+
+	int sampleRate = target->getSampleRate();
+
+	auto l = lock();
+
+	Listener listener;
+	for (int i = 0; i < 3; i++)
+	{
+		listener.position[i] = position[i];
+		listener.forward[i] = orientation[i];
+		listener.up[i] = orientation[i + 3];
+	}
+	listener.distanceModel = distanceModel;
+
+	mixBuffer.assign((size_t) count * 2, 0.0f);
+
+	for (size_t i = 0; i < active.size();)
+	{
+		Source *s = active[i];
+		if (s->mix(mixBuffer.data(), count, sampleRate, listener))
+			i++;
+		else
+		{
+			active.erase(active.begin() + i);
+			s->release();
+		}
+	}
+
+	if (volume != 1.0f)
+	{
+		for (float &sample : mixBuffer)
+			sample *= volume;
+	}
+
+	StrongRef<love::sound::SoundData> mixed(new love::sound::SoundData(mixBuffer.data(), count, sampleRate, 32, 2), Acquire::NORETAIN);
+
+	loopback->write(mixed);
+
+	if (channels == 1)
+		mixed.set(mixed->convert(32, 1), Acquire::NORETAIN);
+
+	// The mix replaces the target's samples rather than adding to them.
+	target->copyFrom(mixed, 0, count, start);
+}
+
+void Audio::addSource(Source *source)
+{
+	source->retain();
+	active.push_back(source);
+}
+
+void Audio::removeSource(Source *source)
+{
+	auto it = std::find(active.begin(), active.end(), source);
+	if (it != active.end())
+	{
+		active.erase(it);
+		source->release();
+	}
+}
+
+thread::Lock Audio::lock()
+{
+	return thread::Lock(mutex);
+}
+
+} // offline
+} // audio
+} // love
@@ -0,0 +1,139 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_AUDIO_OFFLINE_AUDIO_H
+#define LOVE_AUDIO_OFFLINE_AUDIO_H
+
+// LOVE
+#include "audio/Audio.h"
+#include "thread/threads.h"
+
+#include "Source.h"
+#include "RecordingDevice.h"
+
+// STL
+#include <vector>
+
+namespace love
+{
+namespace audio
+{
+namespace offline
+{
+
+/**
+ * Audio module which mixes Sources in software instead of playing them. Audio
+ * only advances when render is called, so it can be produced faster than real
+ * time and deterministically, e.g. for replays or headless tests.
+ **/
+class Audio : public love::audio::Audio
+{
+public:
+
+	Audio();
+	virtual ~Audio();
+
+	// Implements Audio.
+	love::audio::Source *newSource(love::sound::Decoder *decoder) override;
+	love::audio::Source *newSource(love::sound::SoundData *soundData) override;
+	love::audio::Source *newSource(int sampleRate, int bitDepth, int channels, int buffers) override;
+	int getActiveSourceCount() const override;
+	int getMaxSources() const override;
+	bool play(love::audio::Source *source) override;
+	bool play(const std::vector<love::audio::Source*> &sources) override;
+	void stop(love::audio::Source *source) override;
+	void stop(const std::vector<love::audio::Source*> &sources) override;
+	void stop() override;
+	void pause(love::audio::Source *source) override;
+	void pause(const std::vector<love::audio::Source*> &sources) override;
+	std::vector<love::audio::Source*> pause() override;
+	void setVolume(float volume) override;
+	float getVolume() const override;
+
+	void getPosition(float *v) const override;
+	void setPosition(float *v) override;
+	void getOrientation(float *v) const override;
+	void setOrientation(float *v) override;
+	void getVelocity(float *v) const override;
+	void setVelocity(float *v) override;
+
+	void setDopplerScale(float scale) override;
+	float getDopplerScale() const override;
+
+	const std::vector<love::audio::RecordingDevice*> &getRecordingDevices() override;
+
+	DistanceModel getDistanceModel() const override;
+	void setDistanceModel(DistanceModel distanceModel) override;
+
+	bool setEffect(const char *, std::map<Effect::Parameter, float> &params) override;
+	bool unsetEffect(const char *) override;
+	bool getEffect(const char *, std::map<Effect::Parameter, float> &params) override;
+	bool getActiveEffects(std::vector<std::string> &list) const override;
+	int getMaxSceneEffects() const override;
+	int getMaxSourceEffects() const override;
+	bool isEFXsupported() const override;
+
+	bool setOutputSpatialization(bool enable, const char *filter = nullptr) override;
+	bool getOutputSpatialization(const char *&filter) const override;
+	void getOutputSpatializationFilters(std::vector<std::string> &list) const override;
+
+	void pauseContext() override;
+	void resumeContext() override;
+
+	std::string getPlaybackDevice() override;
+	void getPlaybackDevices(std::vector<std::string> &list) override;
+
+	void render(love::sound::SoundData *target, int start, int count) override;
+
+	// Used by Sources to (un)register themselves as playing or paused. The
+	// lock must be held while calling these.
+	void addSource(Source *source);
+	void removeSource(Source *source);
+
+	thread::Lock lock();
+
+private:
+
+	float volume;
+	float position[3];
+	float orientation[6];
+	float velocity[3];
+	float dopplerScale;
+	DistanceModel distanceModel;
+
+	// Playing and paused Sources, retained while they're in this list.
+	std::vector<Source*> active;
+
+	// Scratch stereo mix buffer, reused between render calls.
+	std::vector<float> mixBuffer;
+
+	thread::MutexRef mutex;
+
+	// Records the output of render.
+	RecordingDevice *loopback;
+	std::vector<love::audio::RecordingDevice*> capture;
+
+}; // Audio
+
+} // offline
+} // audio
+} // love
+
+#endif // LOVE_AUDIO_OFFLINE_AUDIO_H
@@ -0,0 +1,245 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "RecordingDevice.h"
+#include "Audio.h"
+#include "common/Exception.h"
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace love
+{
+namespace audio
+{
+namespace offline
+{
+
+RecordingDevice::RecordingDevice(Audio *audio)
+	: audio(audio)
+	, recording(false)
+	, readPos(0)
+	, writePos(0)
+	, resamplePosition(0.0)
+	, resampleLast()
+{
+}
+
+RecordingDevice::~RecordingDevice()
+{
+}
+
+bool RecordingDevice::start(int samples, int sampleRate, int bitDepth, int channels)
+{
+	if ((bitDepth != 8 && bitDepth != 16 && bitDepth != 32) || (channels != 1 && channels != 2))
+		throw love::Exception("Recording %d channels with %d bits per sample is not supported.", channels, bitDepth);
+
+	if (samples <= 0)
+		throw love::Exception("Invalid number of samples.");
+
+	if (sampleRate <= 0)
+		throw love::Exception("Invalid sample rate.");
+
+	auto l = audio->lock();
+
+	this->samples = samples;
+	this->sampleRate = sampleRate;
+	this->bitDepth = bitDepth;
+	this->channels = channels;
+
+	buffer.resize((size_t) samples * (bitDepth / 8) * channels);
+	readPos = 0;
+	writePos = 0;
+	resamplePosition = 0.0;
+	resampleLast[0] = resampleLast[1] = 0.0f;
+	recording = true;
+
+	return true;
+}
+
+void RecordingDevice::stop()
+{
+	auto l = audio->lock();
+
+	recording = false;
+	readPos = 0;
+	writePos = 0;
+}
+
+love::sound::SoundData *RecordingDevice::getData()
+{
+	auto l = audio->lock();
+
+	if (!isRecording())
+		return nullptr;
+
+	int count = getSampleCount();
+	if (count == 0)
+		return nullptr;
+
+	love::sound::SoundData *soundData = new love::sound::SoundData(count, sampleRate, bitDepth, channels);
+	getData(soundData, 0, count);
+
+	return soundData;
+}
+
+int RecordingDevice::getData(love::sound::SoundData *soundData, int start, int count)
+{
+	// Same lock as start, stop and write, since start reallocates the buffer.
+	// SDL mutexes are recursive, so getData() can call this with it held.
+	auto l = audio->lock();
+
+	if (!isRecording())
+		return 0;
+
+	count = getReadableSampleCount(soundData, start, count);
+	if (count == 0)
+		return 0;
+
+	size_t frameSize = (size_t) (bitDepth / 8 * channels);
+	size_t size = (size_t) count * frameSize;
+	uint8 *dst = (uint8 *) soundData->getData() + start * frameSize;
+
+	size_t offset = (size_t) (readPos % buffer.size());
+	size_t first = std::min(size, buffer.size() - offset);
+
+	memcpy(dst, buffer.data() + offset, first);
+	memcpy(dst + first, buffer.data(), size - first);
+
+	readPos += size;
+
+	return count;
+}
+
+void RecordingDevice::write(const love::sound::SoundData *mixed)
+{
+	if (!recording)
+		return;
+
+	StrongRef<love::sound::SoundData> data;
+
+	if (mixed->getSampleRate() != sampleRate)
+	{
+		data.set(resample(mixed), Acquire::NORETAIN);
+		if (data.get() == nullptr)
+			return;
+	}
+	else
+		data.set((love::sound::SoundData *) mixed);
+
+	if (data->getBitDepth() != bitDepth || data->getChannelCount() != channels)
+		data.set(data->convert(bitDepth, channels), Acquire::NORETAIN);
+
+	size_t frameSize = (size_t) (bitDepth / 8 * channels);
+	size_t space = buffer.size() - (size_t) (writePos - readPos);
+	size_t size = std::min(data->getSize(), space);
+	size -= size % frameSize;
+
+	size_t offset = (size_t) (writePos % buffer.size());
+	size_t first = std::min(size, buffer.size() - offset);
+	const uint8 *src = (const uint8 *) data->getData();
+
+	memcpy(buffer.data() + offset, src, first);
+	memcpy(buffer.data(), src + first, size - first);
+
+	writePos += size;
+}
+
+love::sound::SoundData *RecordingDevice::resample(const love::sound::SoundData *mixed)
+{
+	// Linear interpolation like SoundData::resample, except the first frame of
+	// each render is interpolated from the last frame of the previous one.
+	const float *in = (const float *) mixed->getData();
+	int64 frames = mixed->getSampleCount();
+	double step = (double) mixed->getSampleRate() / (double) sampleRate;
+
+	if (frames == 0)
+		return nullptr;
+
+	resampleBuffer.clear();
+
+	for (; resamplePosition < (double) (frames - 1); resamplePosition += step)
+	{
+		int64 i = (int64) std::floor(resamplePosition);
+		float t = (float) (resamplePosition - (double) i);
+
+		for (int c = 0; c < 2; c++)
+		{
+			float a = i < 0 ? resampleLast[c] : in[i * 2 + c];
+			float b = in[(i + 1) * 2 + c];
+			resampleBuffer.push_back(a + (b - a) * t);
+		}
+	}
+
+	resamplePosition -= (double) frames;
+	resampleLast[0] = in[(frames - 1) * 2 + 0];
+	resampleLast[1] = in[(frames - 1) * 2 + 1];
+
+	if (resampleBuffer.empty())
+		return nullptr;
+
+	return new love::sound::SoundData(resampleBuffer.data(), (int) (resampleBuffer.size() / 2), sampleRate, 32, 2);
+}
+
+const char *RecordingDevice::getName() const
+{
+	return "Loopback";
+}
+
+int RecordingDevice::getSampleCount() const
+{
+	auto l = audio->lock();
+
+	if (!isRecording())
+		return 0;
+
+	return (int) ((writePos - readPos) / (bitDepth / 8 * channels));
+}
+
+int RecordingDevice::getMaxSamples() const
+{
+	return samples;
+}
+
+int RecordingDevice::getSampleRate() const
+{
+	return sampleRate;
+}
+
+int RecordingDevice::getBitDepth() const
+{
+	return bitDepth;
+}
+
+int RecordingDevice::getChannelCount() const
+{
+	return channels;
+}
+
+bool RecordingDevice::isRecording() const
+{
+	return recording;
+}
+
+} // offline
+} // audio
+} // love
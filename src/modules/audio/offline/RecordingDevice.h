@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_AUDIO_OFFLINE_RECORDING_DEVICE_H
+#define LOVE_AUDIO_OFFLINE_RECORDING_DEVICE_H
+
+// LOVE
+#include "common/int.h"
+#include "audio/RecordingDevice.h"
+#include "sound/SoundData.h"
+
+// C++
+#include <atomic>
+#include <vector>
+
+namespace love
+{
+namespace audio
+{
+namespace offline
+{
+
+class Audio;
+
+/**
+ * Records the output of the offline Audio module's render calls into a ring
+ * buffer. The buffer is guarded by the Audio module's lock, so reading it
+ * back waits for a render in progress at most. Samples which don't fit in
+ * the buffer are dropped, like with a real capture device.
+ **/
+class RecordingDevice : public love::audio::RecordingDevice
+{
+public:
+
+	RecordingDevice(Audio *audio);
+	virtual ~RecordingDevice();
+
+	bool start(int samples, int sampleRate, int bitDepth, int channels) override;
+	void stop() override;
+	love::sound::SoundData *getData() override;
+	int getData(love::sound::SoundData *soundData, int start, int count) override;
+	const char *getName() const override;
+	int getSampleCount() const override;
+	int getMaxSamples() const override;
+	int getSampleRate() const override;
+	int getBitDepth() const override;
+	int getChannelCount() const override;
+	bool isRecording() const override;
+
+	/**
+	 * Appends rendered audio to the ring buffer. Called by Audio::render with
+	 * its lock held.
+	 * @param mixed Interleaved stereo float samples.
+	 **/
+	void write(const love::sound::SoundData *mixed);
+
+private:
+
+	/**
+	 * Resamples stereo float samples to the recording sample rate.
+	 * @return Nullptr if the rendered audio was too short to produce a sample.
+	 **/
+	love::sound::SoundData *resample(const love::sound::SoundData *mixed);
+
+	Audio *audio;
+
+	int samples = DEFAULT_SAMPLES;
+	int sampleRate = DEFAULT_SAMPLE_RATE;
+	int bitDepth = DEFAULT_BIT_DEPTH;
+	int channels = DEFAULT_CHANNELS;
+
+	std::atomic<bool> recording;
+
+	std::vector<uint8> buffer;
+
+	// Total bytes read and written. Positions in the buffer are these modulo
+	// its size.
+	uint64 readPos;
+	uint64 writePos;
+
+	// Position of the next resampled frame relative to the start of the next
+	// rendered audio, and the last rendered frame. Carried over between
+	// renders so the resampled audio is continuous.
+	double resamplePosition;
+	float resampleLast[2];
+	std::vector<float> resampleBuffer;
+
+}; // RecordingDevice
+
+} // offline
+} // audio
+} // love
+
+#endif // LOVE_AUDIO_OFFLINE_RECORDING_DEVICE_H
@@ -0,0 +1,895 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#include "Source.h"
+#include "Audio.h"
+#include "common/Exception.h"
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace love
+{
+namespace audio
+{
+namespace offline
+{
+
+// Lowpass cutoffs used to approximate the EFX filter bands.
+static const float FILTER_LOW_CUTOFF = 250.0f;
+static const float FILTER_HIGH_CUTOFF = 5000.0f;
+
+static const int DEFAULT_BUFFERS = 8;
+static const int MAX_BUFFERS = 64;
+
+// Centre and surround channels are mixed into stereo at -3dB and LFE is
+// dropped (ITU-R BS.775). Each side is normalized so full scale input can't
+// clip.
+static const float DOWNMIX_SIDE = 0.70710678f;
+static const float DOWNMIX_51 = 1.0f / (1.0f + 2.0f * DOWNMIX_SIDE);
+static const float DOWNMIX_71 = 1.0f / (1.0f + 3.0f * DOWNMIX_SIDE);
+
+// Left and right weights of each channel, in OpenAL's channel order.
+static const float DOWNMIX_MONO[1][2] = {{1.0f, 1.0f}};
+static const float DOWNMIX_STEREO[2][2] = {{1.0f, 0.0f}, {0.0f, 1.0f}};
+static const float DOWNMIX_5_1[6][2] =
+{
+	{DOWNMIX_51, 0.0f}, // Front left
+	{0.0f, DOWNMIX_51}, // Front right
+	{DOWNMIX_51 * DOWNMIX_SIDE, DOWNMIX_51 * DOWNMIX_SIDE}, // Centre
+	{0.0f, 0.0f}, // LFE
+	{DOWNMIX_51 * DOWNMIX_SIDE, 0.0f}, // Surround left
+	{0.0f, DOWNMIX_51 * DOWNMIX_SIDE}, // Surround right
+};
+static const float DOWNMIX_7_1[8][2] =
+{
+	{DOWNMIX_71, 0.0f}, // Front left
+	{0.0f, DOWNMIX_71}, // Front right
+	{DOWNMIX_71 * DOWNMIX_SIDE, DOWNMIX_71 * DOWNMIX_SIDE}, // Centre
+	{0.0f, 0.0f}, // LFE
+	{DOWNMIX_71 * DOWNMIX_SIDE, 0.0f}, // Rear left
+	{0.0f, DOWNMIX_71 * DOWNMIX_SIDE}, // Rear right
+	{DOWNMIX_71 * DOWNMIX_SIDE, 0.0f}, // Side left
+	{0.0f, DOWNMIX_71 * DOWNMIX_SIDE}, // Side right
+};
+
+static const float (*getDownmixWeights(int channels))[2]
+{
+	switch (channels)
+	{
+	case 1:
+		return DOWNMIX_MONO;
+	case 2:
+		return DOWNMIX_STEREO;
+	case 6:
+		return DOWNMIX_5_1;
+	case 8:
+		return DOWNMIX_7_1;
+	default:
+		return nullptr;
+	}
+}
+
+static void checkFormat(int bitDepth, int channels)
+{
+	// Like the OpenAL module, only the channel layouts OpenAL defines work.
+	if ((bitDepth != 8 && bitDepth != 16 && bitDepth != 32) || getDownmixWeights(channels) == nullptr)
+		throw love::Exception("%d-channel Sources with %d bits per sample are not supported.", channels, bitDepth);
+}
+
+// Appends interleaved integer or float samples as normalized floats.
+static void appendSamples(std::vector<float> &dst, const void *src, int bitDepth, size_t count)
+{
+	size_t offset = dst.size();
+	dst.resize(offset + count);
+	float *out = dst.data() + offset;
+
+	if (bitDepth == 32)
+		memcpy(out, src, count * sizeof(float));
+	else if (bitDepth == 16)
+	{
+		const int16 *s = (const int16 *) src;
+		for (size_t i = 0; i < count; i++)
+			out[i] = (float) s[i] / (float) LOVE_INT16_MAX;
+	}
+	else
+	{
+		const uint8 *s = (const uint8 *) src;
+		for (size_t i = 0; i < count; i++)
+			out[i] = ((float) s[i] - 128.0f) / 127.0f;
+	}
+}
+
+static float dot(const float *a, const float *b)
+{
+	return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+Source::Source(Audio *audio, love::sound::SoundData *soundData)
+	: love::audio::Source(Source::TYPE_STATIC)
+	, audio(audio)
+	, sampleRate(soundData->getSampleRate())
+	, channels(soundData->getChannelCount())
+	, bitDepth(soundData->getBitDepth())
+	, buffers(0)
+{
+	checkFormat(bitDepth, channels);
+
+	if (bitDepth == 32)
+		staticData.set(soundData);
+	else
+		staticData.set(soundData->convert(32, channels), Acquire::NORETAIN);
+
+	reset();
+}
+
+Source::Source(Audio *audio, love::sound::Decoder *decoder)
+	: love::audio::Source(Source::TYPE_STREAM)
+	, audio(audio)
+	, sampleRate(decoder->getSampleRate())
+	, channels(decoder->getChannelCount())
+	, bitDepth(decoder->getBitDepth())
+	, buffers(DEFAULT_BUFFERS)
+	, decoder(decoder)
+{
+	checkFormat(bitDepth, channels);
+	reset();
+}
+
+Source::Source(Audio *audio, int sampleRate, int bitDepth, int channels, int buffers)
+	: love::audio::Source(Source::TYPE_QUEUE)
+	, audio(audio)
+	, sampleRate(sampleRate)
+	, channels(channels)
+	, bitDepth(bitDepth)
+	, buffers(buffers)
+{
+	checkFormat(bitDepth, channels);
+
+	if (this->buffers < 1)
+		this->buffers = DEFAULT_BUFFERS;
+	if (this->buffers > MAX_BUFFERS)
+		this->buffers = MAX_BUFFERS;
+
+	reset();
+}
+
+Source::Source(const Source &s)
+	: love::audio::Source(s.sourceType)
+	, audio(s.audio)
+	, sampleRate(s.sampleRate)
+	, channels(s.channels)
+	, bitDepth(s.bitDepth)
+	, buffers(s.buffers)
+	, staticData(s.staticData)
+	, hasFilter(s.hasFilter)
+	, filterParams(s.filterParams)
+	, filterType(s.filterType)
+	, filterVolume(s.filterVolume)
+	, filterLowGain(s.filterLowGain)
+	, filterHighGain(s.filterHighGain)
+	, pitch(s.pitch)
+	, volume(s.volume)
+	, coneInnerAngle(s.coneInnerAngle)
+	, coneOuterAngle(s.coneOuterAngle)
+	, coneOuterVolume(s.coneOuterVolume)
+	, coneOuterHighGain(s.coneOuterHighGain)
+	, relative(s.relative)
+	, looping(s.looping)
+	, minVolume(s.minVolume)
+	, maxVolume(s.maxVolume)
+	, referenceDistance(s.referenceDistance)
+	, rolloffFactor(s.rolloffFactor)
+	, maxDistance(s.maxDistance)
+	, absorptionFactor(s.absorptionFactor)
+{
+	if (sourceType == TYPE_STREAM)
+		decoder.set(s.decoder->clone(), Acquire::NORETAIN);
+
+	for (int i = 0; i < 3; i++)
+	{
+		positionv[i] = s.positionv[i];
+		velocity[i] = s.velocity[i];
+		direction[i] = s.direction[i];
+	}
+
+	reset();
+}
+
+Source::~Source()
+{
+}
+
+love::audio::Source *Source::clone()
+{
+	return new Source(*this);
+}
+
+bool Source::play()
+{
+	auto l = audio->lock();
+
+	if (state == STATE_STOPPED)
+		audio->addSource(this);
+
+	state = STATE_PLAYING;
+	finished = false;
+	return true;
+}
+
+void Source::stop()
+{
+	auto l = audio->lock();
+
+	if (state == STATE_STOPPED)
+		return;
+
+	state = STATE_STOPPED;
+	reset();
+
+	// This may release the last reference to this Source.
+	audio->removeSource(this);
+}
+
+void Source::pause()
+{
+	auto l = audio->lock();
+
+	if (state == STATE_PLAYING)
+		state = STATE_PAUSED;
+}
+
+bool Source::isPlaying() const
+{
+	return state == STATE_PLAYING;
+}
+
+bool Source::isFinished() const
+{
+	return finished;
+}
+
+bool Source::update()
+{
+	return state != STATE_STOPPED;
+}
+
+void Source::setPitch(float pitch)
+{
+	this->pitch = pitch;
+}
+
+float Source::getPitch() const
+{
+	return pitch;
+}
+
+void Source::setVolume(float volume)
+{
+	this->volume = volume;
+}
+
+float Source::getVolume() const
+{
+	return volume;
+}
+
+void Source::seek(double offset, Unit unit)
+{
+	double frame = unit == UNIT_SAMPLES ? offset : offset * sampleRate;
+	frame = std::max(frame, 0.0);
+
+	// Done outside the lock, since the first seek may scan the whole stream.
+	if (sourceType == TYPE_STREAM)
+		decoder->prepareSeeking();
+
+	auto l = audio->lock();
+
+	switch (sourceType)
+	{
+	case TYPE_STATIC:
+		position = std::min(frame, (double) getFrameCount());
+		break;
+	case TYPE_STREAM:
+		decoder->seek(frame / sampleRate);
+		pcm.clear();
+		pcmOffset = (int64) frame;
+		position = frame;
+		break;
+	case TYPE_QUEUE:
+	default:
+		// Queued data can't be seeked, like with the OpenAL backend.
+		break;
+	}
+}
+
+double Source::tell(Unit unit)
+{
+	if (sourceType == TYPE_STREAM && looping)
+		decoder->prepareSeeking();
+
+	auto l = audio->lock();
+
+	double frame = position;
+
+	// Looping streams keep counting decoded frames across loops.
+	if (sourceType == TYPE_STREAM && looping)
+	{
+		double duration = decoder->getDuration() * sampleRate;
+		if (duration > 0.0)
+			frame = fmod(frame, duration);
+	}
+
+	return unit == UNIT_SAMPLES ? frame : frame / sampleRate;
+}
+
+double Source::getDuration(Unit unit)
+{
+	double frames = -1.0;
+
+	if (sourceType == TYPE_STATIC)
+		frames = (double) getFrameCount();
+	else if (sourceType == TYPE_STREAM)
+	{
+		double seconds = decoder->getDuration();
+		if (seconds >= 0.0)
+			frames = seconds * sampleRate;
+	}
+
+	if (frames < 0.0)
+		return -1.0;
+
+	return unit == UNIT_SAMPLES ? frames : frames / sampleRate;
+}
+
+void Source::setPosition(float *v)
+{
+	for (int i = 0; i < 3; i++)
+		positionv[i] = v[i];
+}
+
+void Source::getPosition(float *v) const
+{
+	for (int i = 0; i < 3; i++)
+		v[i] = positionv[i];
+}
+
+void Source::setVelocity(float *v)
+{
+	for (int i = 0; i < 3; i++)
+		velocity[i] = v[i];
+}
+
+void Source::getVelocity(float *v) const
+{
+	for (int i = 0; i < 3; i++)
+		v[i] = velocity[i];
+}
+
+void Source::setDirection(float *v)
+{
+	for (int i = 0; i < 3; i++)
+		direction[i] = v[i];
+}
+
+void Source::getDirection(float *v) const
+{
+	for (int i = 0; i < 3; i++)
+		v[i] = direction[i];
+}
+
+void Source::setCone(float innerAngle, float outerAngle, float outerVolume, float outerHighGain)
+{
+	coneInnerAngle = innerAngle;
+	coneOuterAngle = outerAngle;
+	coneOuterVolume = outerVolume;
+	coneOuterHighGain = outerHighGain;
+}
+
+void Source::getCone(float &innerAngle, float &outerAngle, float &outerVolume, float &outerHighGain) const
+{
+	innerAngle = coneInnerAngle;
+	outerAngle = coneOuterAngle;
+	outerVolume = coneOuterVolume;
+	outerHighGain = coneOuterHighGain;
+}
+
+void Source::setRelative(bool enable)
+{
+	relative = enable;
+}
+
+bool Source::isRelative() const
+{
+	return relative;
+}
+
+void Source::setLooping(bool enable)
+{
+	if (sourceType == TYPE_QUEUE)
+		throw love::Exception("Queueable Sources can not be looped.");
+
+	looping = enable;
+}
+
+bool Source::isLooping() const
+{
+	return looping;
+}
+
+void Source::setMinVolume(float volume)
+{
+	minVolume = volume;
+}
+
+float Source::getMinVolume() const
+{
+	return minVolume;
+}
+
+void Source::setMaxVolume(float volume)
+{
+	maxVolume = volume;
+}
+
+float Source::getMaxVolume() const
+{
+	return maxVolume;
+}
+
+void Source::setReferenceDistance(float distance)
+{
+	referenceDistance = distance;
+}
+
+float Source::getReferenceDistance() const
+{
+	return referenceDistance;
+}
+
+void Source::setRolloffFactor(float factor)
+{
+	rolloffFactor = factor;
+}
+
+float Source::getRolloffFactor() const
+{
+	return rolloffFactor;
+}
+
+void Source::setMaxDistance(float distance)
+{
+	maxDistance = distance;
+}
+
+float Source::getMaxDistance() const
+{
+	return maxDistance;
+}
+
+void Source::setAirAbsorptionFactor(float factor)
+{
+	absorptionFactor = factor;
+}
+
+float Source::getAirAbsorptionFactor() const
+{
+	return absorptionFactor;
+}
+
+int Source::getChannelCount() const
+{
+	return channels;
+}
+
+int Source::getFreeBufferCount() const
+{
+	if (sourceType != TYPE_QUEUE)
+		return 0;
+
+	return std::max(buffers - (int) queuedEnds.size(), 0);
+}
+
+bool Source::queue(void *data, size_t length, int dataSampleRate, int dataBitDepth, int dataChannels)
+{
+	if (sourceType != TYPE_QUEUE)
+		throw love::Exception("Only queueable Sources can be queued with sound data.");
+
+	if (dataSampleRate != sampleRate || dataBitDepth != bitDepth || dataChannels != channels)
+		throw love::Exception("Queued sound data must have same format as sound Source.");
+
+	size_t frameSize = (size_t) (bitDepth / 8 * channels);
+	if (length % frameSize != 0)
+		throw love::Exception("Data length must be a multiple of sample size (%d bytes).", (int) frameSize);
+
+	if (length == 0)
+		return true;
+
+	auto l = audio->lock();
+
+	if (getFreeBufferCount() == 0)
+		return false;
+
+	appendSamples(pcm, data, bitDepth, length / (bitDepth / 8));
+	queuedEnds.push_back(getFrameCount());
+
+	return true;
+}
+
+bool Source::setFilter(const std::map<Filter::Parameter, float> &params)
+{
+	auto l = audio->lock();
+	setFilterParams(params);
+	hasFilter = true;
+	return true;
+}
+
+bool Source::setFilter()
+{
+	auto l = audio->lock();
+	hasFilter = false;
+	filterParams.clear();
+	return true;
+}
+
+bool Source::getFilter(std::map<Filter::Parameter, float> &params)
+{
+	if (!hasFilter)
+		return false;
+
+	params = filterParams;
+	return true;
+}
+
+bool Source::setEffect(const char *)
+{
+	return false;
+}
+
+bool Source::setEffect(const char *, const std::map<Filter::Parameter, float> &)
+{
+	return false;
+}
+
+bool Source::unsetEffect(const char *)
+{
+	return false;
+}
+
+bool Source::getEffect(const char *, std::map<Filter::Parameter, float> &)
+{
+	return false;
+}
+
+bool Source::getActiveEffects(std::vector<std::string> &) const
+{
+	return false;
+}
+
+bool Source::mix(float *out, int frames, int outSampleRate, const Listener &listener)
+{
+	if (state == STATE_PAUSED)
+		return true;
+	else if (state != STATE_PLAYING)
+		return false;
+
+	float gains[2];
+	computeGains(listener, gains);
+
+	if (hasFilter)
+		computeFilter(outSampleRate);
+
+	double step = (double) pitch * sampleRate / outSampleRate;
+	double loopLength = (double) getFrameCount();
+	bool ended = false;
+
+	const float (*downmix)[2] = getDownmixWeights(channels);
+
+	for (int i = 0; i < frames; i++)
+	{
+		int64 f = (int64) position;
+		const float *a = nullptr;
+		const float *b = nullptr;
+
+		if (!getFrames(f, a, b))
+		{
+			ended = true;
+			break;
+		}
+
+		float t = (float) (position - (double) f);
+		float left = 0.0f;
+		float right = 0.0f;
+
+		for (int c = 0; c < channels; c++)
+		{
+			float sample = a[c] + (b[c] - a[c]) * t;
+
+			if (hasFilter)
+				sample = applyFilter(sample, c);
+
+			left += sample * downmix[c][0];
+			right += sample * downmix[c][1];
+		}
+
+		out[i * 2 + 0] += left * gains[0];
+		out[i * 2 + 1] += right * gains[1];
+
+		position += step;
+
+		if (sourceType == TYPE_STATIC && looping && position >= loopLength)
+			position = fmod(position, loopLength);
+	}
+
+	if (ended)
+	{
+		state = STATE_STOPPED;
+		finished = true;
+		reset();
+		return false;
+	}
+
+	discardFrames((int64) position);
+	return true;
+}
+
+void Source::reset()
+{
+	state = STATE_STOPPED;
+	position = 0.0;
+
+	if (sourceType == TYPE_STREAM)
+		decoder->rewind();
+
+	pcm.clear();
+	pcmOffset = 0;
+	queuedEnds.clear();
+
+	filterLowState.assign(channels, 0.0f);
+	filterHighState.assign(channels, 0.0f);
+}
+
+int64 Source::getFrameCount() const
+{
+	if (sourceType == TYPE_STATIC)
+		return staticData->getSampleCount();
+
+	// The end of the currently decoded or queued data.
+	return pcmOffset + (int64) (pcm.size() / channels);
+}
+
+bool Source::getFrames(int64 frame, const float *&a, const float *&b)
+{
+	if (sourceType == TYPE_STATIC)
+	{
+		int64 count = getFrameCount();
+		if (frame >= count)
+			return false;
+
+		int64 next = frame + 1;
+		if (next >= count)
+			next = looping ? 0 : frame;
+
+		const float *data = (const float *) staticData->getData();
+		a = data + frame * channels;
+		b = data + next * channels;
+		return true;
+	}
+
+	if (!fillStream(frame))
+		return false;
+
+	// Filling may reallocate the buffer, so get pointers afterwards.
+	int64 next = fillStream(frame + 1) ? frame + 1 : frame;
+
+	a = pcm.data() + (frame - pcmOffset) * channels;
+	b = pcm.data() + (next - pcmOffset) * channels;
+	return true;
+}
+
+bool Source::fillStream(int64 frame)
+{
+	bool rewound = false;
+
+	while (frame >= getFrameCount())
+	{
+		if (sourceType != TYPE_STREAM)
+			return false;
+
+		int decoded = std::max(decoder->decode(), 0);
+
+		if (decoded > 0)
+		{
+			appendSamples(pcm, decoder->getBuffer(), bitDepth, decoded / (bitDepth / 8));
+			rewound = false;
+		}
+		else if (looping && !rewound && decoder->rewind())
+			rewound = true;
+		else
+			return false;
+	}
+
+	return true;
+}
+
+void Source::discardFrames(int64 frame)
+{
+	if (sourceType == TYPE_STATIC)
+		return;
+
+	frame = std::min(frame, getFrameCount());
+
+	if (frame > pcmOffset)
+	{
+		pcm.erase(pcm.begin(), pcm.begin() + (frame - pcmOffset) * channels);
+		pcmOffset = frame;
+	}
+
+	while (!queuedEnds.empty() && queuedEnds.front() <= frame)
+		queuedEnds.pop_front();
+}
+
+void Source::computeGains(const Listener &listener, float gains[2]) const
+{
+	float gain = volume;
+
+	if (channels != 1)
+	{
+		gains[0] = gains[1] = std::min(std::max(gain, minVolume), maxVolume);
+		return;
+	}
+
+	// Relative Sources are positioned in the default listener space.
+	float d[3];
+	float right[3] = {1.0f, 0.0f, 0.0f};
+
+	if (relative)
+	{
+		for (int i = 0; i < 3; i++)
+			d[i] = positionv[i];
+	}
+	else
+	{
+		const float *f = listener.forward;
+		const float *u = listener.up;
+
+		for (int i = 0; i < 3; i++)
+			d[i] = positionv[i] - listener.position[i];
+
+		right[0] = f[1] * u[2] - f[2] * u[1];
+		right[1] = f[2] * u[0] - f[0] * u[2];
+		right[2] = f[0] * u[1] - f[1] * u[0];
+	}
+
+	float distance = sqrtf(dot(d, d));
+
+	// Distance attenuation, using the formulas from the OpenAL specification.
+	float ref = referenceDistance;
+	float dist = distance;
+
+	switch (listener.distanceModel)
+	{
+	case Audio::DISTANCE_INVERSE_CLAMPED:
+		dist = std::min(std::max(dist, ref), maxDistance);
+		// Fallthrough.
+	case Audio::DISTANCE_INVERSE:
+		if (ref + rolloffFactor * (dist - ref) > 0.0f)
+			gain *= ref / (ref + rolloffFactor * (dist - ref));
+		break;
+	case Audio::DISTANCE_LINEAR_CLAMPED:
+		dist = std::min(std::max(dist, ref), maxDistance);
+		// Fallthrough.
+	case Audio::DISTANCE_LINEAR:
+		if (maxDistance > ref)
+			gain *= std::max(1.0f - rolloffFactor * (dist - ref) / (maxDistance - ref), 0.0f);
+		break;
+	case Audio::DISTANCE_EXPONENT_CLAMPED:
+		dist = std::min(std::max(dist, ref), maxDistance);
+		// Fallthrough.
+	case Audio::DISTANCE_EXPONENT:
+		if (dist > 0.0f && ref > 0.0f)
+			gain *= powf(dist / ref, -rolloffFactor);
+		break;
+	case Audio::DISTANCE_NONE:
+	default:
+		break;
+	}
+
+	// Directional cone, angles are the full cone widths in radians.
+	float dirLength = sqrtf(dot(direction, direction));
+	if (dirLength > 0.0f && distance > 0.0f)
+	{
+		float cosAngle = -dot(direction, d) / (dirLength * distance);
+		float angle = acosf(std::min(std::max(cosAngle, -1.0f), 1.0f));
+		float inner = coneInnerAngle * 0.5f;
+		float outer = coneOuterAngle * 0.5f;
+
+		if (angle >= outer)
+			gain *= coneOuterVolume;
+		else if (angle > inner)
+			gain *= 1.0f + (coneOuterVolume - 1.0f) * (angle - inner) / (outer - inner);
+	}
+
+	gain = std::min(std::max(gain, minVolume), maxVolume);
+
+	// Equal-power panning based on how far the Source is to the right.
+	float pan = 0.0f;
+	float rightLength = sqrtf(dot(right, right));
+	if (distance > 0.0f && rightLength > 0.0f)
+		pan = dot(d, right) / (distance * rightLength);
+
+	float angle = (pan + 1.0f) * (float) LOVE_M_PI_4;
+	gains[0] = gain * cosf(angle);
+	gains[1] = gain * sinf(angle);
+}
+
+void Source::computeFilter(int outSampleRate)
+{
+	filterLowCoefficient = 1.0f - expf(-2.0f * (float) LOVE_M_PI * FILTER_LOW_CUTOFF / outSampleRate);
+	filterHighCoefficient = 1.0f - expf(-2.0f * (float) LOVE_M_PI * FILTER_HIGH_CUTOFF / outSampleRate);
+}
+
+void Source::setFilterParams(const std::map<Filter::Parameter, float> &params)
+{
+	auto get = [&](Filter::Parameter p, float def)
+	{
+		auto it = params.find(p);
+		return it != params.end() ? it->second : def;
+	};
+
+	filterParams = params;
+	filterType = (Filter::Type) (int) get(Filter::FILTER_TYPE, (float) Filter::TYPE_BASIC);
+	filterVolume = get(Filter::FILTER_VOLUME, 1.0f);
+	filterLowGain = get(Filter::FILTER_LOWGAIN, 1.0f);
+	filterHighGain = get(Filter::FILTER_HIGHGAIN, 1.0f);
+}
+
+float Source::applyFilter(float sample, int channel)
+{
+	float &low = filterLowState[channel];
+	float &high = filterHighState[channel];
+
+	low += filterLowCoefficient * (sample - low);
+	high += filterHighCoefficient * (sample - high);
+
+	switch (filterType)
+	{
+	case Filter::TYPE_LOWPASS:
+		sample = high + filterHighGain * (sample - high);
+		break;
+	case Filter::TYPE_HIGHPASS:
+		sample = filterLowGain * low + (sample - low);
+		break;
+	case Filter::TYPE_BANDPASS:
+		sample = filterLowGain * low + (high - low) + filterHighGain * (sample - high);
+		break;
+	case Filter::TYPE_BASIC:
+	default:
+		break;
+	}
+
+	return sample * filterVolume;
+}
+
+} // offline
+} // audio
+} // love
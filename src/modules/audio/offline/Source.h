@@ -0,0 +1,219 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#ifndef LOVE_AUDIO_OFFLINE_SOURCE_H
+#define LOVE_AUDIO_OFFLINE_SOURCE_H
+
+// LOVE
+#include "common/math.h"
+#include "common/Object.h"
+#include "audio/Audio.h"
+#include "audio/Source.h"
+#include "audio/Filter.h"
+#include "sound/SoundData.h"
+#include "sound/Decoder.h"
+
+// STL
+#include <deque>
+#include <limits>
+#include <map>
+#include <vector>
+
+namespace love
+{
+namespace audio
+{
+namespace offline
+{
+
+class Audio;
+
+/**
+ * Listener state used while mixing, captured once per render call.
+ **/
+struct Listener
+{
+	float position[3];
+	float forward[3];
+	float up[3];
+	love::audio::Audio::DistanceModel distanceModel;
+};
+
+/**
+ * A Source which is mixed in software by the offline Audio module. Static
+ * Sources keep their data as float samples, streaming and queueable Sources
+ * keep a window of converted samples which is refilled while mixing.
+ **/
+class Source : public love::audio::Source
+{
+public:
+
+	Source(Audio *audio, love::sound::SoundData *soundData);
+	Source(Audio *audio, love::sound::Decoder *decoder);
+	Source(Audio *audio, int sampleRate, int bitDepth, int channels, int buffers);
+	Source(const Source &s);
+	virtual ~Source();
+
+	love::audio::Source *clone() override;
+	bool play() override;
+	void stop() override;
+	void pause() override;
+	bool isPlaying() const override;
+	bool isFinished() const override;
+	bool update() override;
+	void setPitch(float pitch) override;
+	float getPitch() const override;
+	void setVolume(float volume) override;
+	float getVolume() const override;
+	void seek(double offset, Unit unit) override;
+	double tell(Unit unit) override;
+	double getDuration(Unit unit) override;
+	void setPosition(float *v) override;
+	void getPosition(float *v) const override;
+	void setVelocity(float *v) override;
+	void getVelocity(float *v) const override;
+	void setDirection(float *v) override;
+	void getDirection(float *v) const override;
+	void setCone(float innerAngle, float outerAngle, float outerVolume, float outerHighGain) override;
+	void getCone(float &innerAngle, float &outerAngle, float &outerVolume, float &outerHighGain) const override;
+	void setRelative(bool enable) override;
+	bool isRelative() const override;
+	void setLooping(bool looping) override;
+	bool isLooping() const override;
+	void setMinVolume(float volume) override;
+	float getMinVolume() const override;
+	void setMaxVolume(float volume) override;
+	float getMaxVolume() const override;
+	void setReferenceDistance(float distance) override;
+	float getReferenceDistance() const override;
+	void setRolloffFactor(float factor) override;
+	float getRolloffFactor() const override;
+	void setMaxDistance(float distance) override;
+	float getMaxDistance() const override;
+	void setAirAbsorptionFactor(float factor) override;
+	float getAirAbsorptionFactor() const override;
+	int getChannelCount() const override;
+
+	int getFreeBufferCount() const override;
+	bool queue(void *data, size_t length, int dataSampleRate, int dataBitDepth, int dataChannels) override;
+
+	bool setFilter(const std::map<Filter::Parameter, float> &params) override;
+	bool setFilter() override;
+	bool getFilter(std::map<Filter::Parameter, float> &params) override;
+
+	bool setEffect(const char *effect) override;
+	bool setEffect(const char *effect, const std::map<Filter::Parameter, float> &params) override;
+	bool unsetEffect(const char *effect) override;
+	bool getEffect(const char *effect, std::map<Filter::Parameter, float> &params) override;
+	bool getActiveEffects(std::vector<std::string> &list) const override;
+
+	/**
+	 * Adds the next frames of this Source to an interleaved stereo buffer.
+	 * @param out The stereo buffer to mix into.
+	 * @param frames The number of stereo frames to produce.
+	 * @param outSampleRate The sample rate of the output buffer.
+	 * @param listener The listener to spatialize mono Sources against.
+	 * @return False once the Source has stopped playing.
+	 **/
+	bool mix(float *out, int frames, int outSampleRate, const Listener &listener);
+
+private:
+
+	enum State
+	{
+		STATE_STOPPED,
+		STATE_PLAYING,
+		STATE_PAUSED
+	};
+
+	void reset();
+	int64 getFrameCount() const;
+	bool getFrames(int64 frame, const float *&a, const float *&b);
+	bool fillStream(int64 frame);
+	void discardFrames(int64 frame);
+	void computeGains(const Listener &listener, float gains[2]) const;
+	void computeFilter(int outSampleRate);
+	void setFilterParams(const std::map<Filter::Parameter, float> &params);
+	float applyFilter(float sample, int channel);
+
+	Audio *audio;
+
+	int sampleRate;
+	int channels;
+	int bitDepth;
+	int buffers;
+
+	State state = STATE_STOPPED;
+	bool finished = false;
+
+	// Float32 copy of the data of static Sources, shared between clones.
+	StrongRef<love::sound::SoundData> staticData;
+	StrongRef<love::sound::Decoder> decoder;
+
+	// Decoded or queued float samples of streaming and queueable Sources,
+	// starting at frame pcmOffset.
+	std::vector<float> pcm;
+	int64 pcmOffset = 0;
+
+	// End frames of data queued with queue(), for getFreeBufferCount.
+	std::deque<int64> queuedEnds;
+
+	// Playback position in frames of the source data.
+	double position = 0.0;
+
+	bool hasFilter = false;
+	std::map<Filter::Parameter, float> filterParams;
+	Filter::Type filterType = Filter::TYPE_BASIC;
+	float filterVolume = 1.0f;
+	float filterLowGain = 1.0f;
+	float filterHighGain = 1.0f;
+
+	// One-pole lowpass coefficients and states used to split the signal into
+	// low, middle and high bands.
+	float filterLowCoefficient = 0.0f;
+	float filterHighCoefficient = 0.0f;
+	std::vector<float> filterLowState;
+	std::vector<float> filterHighState;
+
+	float pitch = 1.0f;
+	float volume = 1.0f;
+	float positionv[3] = {0.0f, 0.0f, 0.0f};
+	float velocity[3] = {0.0f, 0.0f, 0.0f};
+	float direction[3] = {0.0f, 0.0f, 0.0f};
+	float coneInnerAngle = LOVE_TORAD(360.0f);
+	float coneOuterAngle = LOVE_TORAD(360.0f);
+	float coneOuterVolume = 0.0f;
+	float coneOuterHighGain = 1.0f;
+	bool relative = false;
+	bool looping = false;
+	float minVolume = 0.0f;
+	float maxVolume = 1.0f;
+	float referenceDistance = 1.0f;
+	float rolloffFactor = 1.0f;
+	float maxDistance = std::numeric_limits<float>::max();
+	float absorptionFactor = 0.0f;
+
+}; // Source
+
+} // offline
+} // audio
+} // love
+
+#endif // LOVE_AUDIO_OFFLINE_SOURCE_H
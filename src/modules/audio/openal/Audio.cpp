@@ -74,6 +74,9 @@ void Audio::PoolThread::setFinish()
 
 ALenum Audio::getFormat(int bitDepth, int channels)
 {
+	if (bitDepth == 32)
+		return getFloatFormat(channels);
+
 	if (bitDepth != 8 && bitDepth != 16)
 		return AL_NONE;
 
@@ -93,6 +96,35 @@ ALenum Audio::getFormat(int bitDepth, int channels)
 	return AL_NONE;
 }
 
+ALenum Audio::getFloatFormat(int channels)
+{
+#ifndef AL_FORMAT_MONO_FLOAT32
+	constexpr ALenum AL_FORMAT_MONO_FLOAT32 = 0x10010;
+	constexpr ALenum AL_FORMAT_STEREO_FLOAT32 = 0x10011;
+#endif
+#ifndef AL_FORMAT_51CHN32
+	constexpr ALenum AL_FORMAT_51CHN32 = 0x120C;
+	constexpr ALenum AL_FORMAT_71CHN32 = 0x1212;
+#endif
+
+	if (!alIsExtensionPresent("AL_EXT_FLOAT32"))
+		return AL_NONE;
+
+	if (channels == 1)
+		return AL_FORMAT_MONO_FLOAT32;
+	else if (channels == 2)
+		return AL_FORMAT_STEREO_FLOAT32;
+	else if (alIsExtensionPresent("AL_EXT_MCFORMATS"))
+	{
+		if (channels == 6)
+			return AL_FORMAT_51CHN32;
+		else if (channels == 8)
+			return AL_FORMAT_71CHN32;
+	}
+
+	return AL_NONE;
+}
+
 static const char *getDeviceSpecifier(ALCdevice *device)
 {
 #ifndef ALC_ALL_DEVICES_SPECIFIER
@@ -356,6 +388,11 @@ std::vector<love::audio::Source*> Audio::pause()
 	return Source::pause(pool);
 }
 
+void Audio::setSourceStates(const std::vector<love::audio::Source*> &sources, const float *states)
+{
+	Source::setStates(sources, states);
+}
+
 void Audio::pauseContext()
 {
 #ifdef LOVE_ANDROID
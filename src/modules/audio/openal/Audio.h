@@ -73,7 +73,8 @@ class Audio : public love::audio::Audio
 	 * Gets the OpenAL format identifier based on number of
 	 * channels and bits.
 	 * @param channels.
-	 * @param bitDepth Either 8-bit samples, or 16-bit samples.
+	 * @param bitDepth Either 8-bit samples, 16-bit samples, or 32-bit float
+	 * samples (requires AL_EXT_FLOAT32).
 	 * @return One of AL_FORMAT_*, or AL_NONE if unsupported format.
 	 **/
 	static ALenum getFormat(int bitDepth, int channels);
@@ -132,8 +133,12 @@ class Audio : public love::audio::Audio
 	void getPlaybackDevices(std::vector<std::string> &list) override;
 	void setPlaybackDevice(const char *name) override;
 
+	void setSourceStates(const std::vector<love::audio::Source*> &sources, const float *states) override;
+
 private:
 
+	static ALenum getFloatFormat(int channels);
+
 	std::vector<ALint> computeContextAttribs();
 	void initializeEFX();
 
@@ -111,6 +111,21 @@ love::sound::SoundData *RecordingDevice::getData()
 	return soundData;
 }
 
+int RecordingDevice::getData(love::sound::SoundData *soundData, int start, int count)
+{
+	if (!isRecording())
+		return 0;
+
+	count = getReadableSampleCount(soundData, start, count);
+	if (count == 0)
+		return 0;
+
+	size_t frameSize = (size_t) (bitDepth / 8 * channels);
+	alcCaptureSamples(device, (uint8 *) soundData->getData() + start * frameSize, count);
+
+	return count;
+}
+
 int RecordingDevice::getSampleCount() const
 {
 	if (!isRecording())
@@ -508,6 +508,11 @@ float Source::getVolume() const
 
 void Source::seek(double offset, Source::Unit unit)
 {
+	// Seeking may need to scan the whole stream the first time, which
+	// shouldn't stall the other sources' streaming.
+	if (sourceType == TYPE_STREAM)
+		decoder->prepareSeeking();
+
 	Lock l = pool->lock();
 
 	int offsetSamples = 0;
@@ -610,6 +615,9 @@ double Source::tell(Source::Unit unit)
 
 double Source::getDuration(Unit unit)
 {
+	if (sourceType == TYPE_STREAM)
+		decoder->prepareSeeking();
+
 	Lock l = pool->lock();
 
 	switch (sourceType)
@@ -1105,6 +1113,58 @@ void Source::stop(Pool *pool)
 	stop(pool->getPlayingSources());
 }
 
+void Source::setStates(const std::vector<love::audio::Source*> &sources, const float *states)
+{
+	if (sources.size() == 0)
+		return;
+
+	Pool *pool = ((Source*) sources[0])->pool;
+	Lock l = pool->lock();
+
+	// Defer all changes so the mixer applies them at once, instead of locking
+	// and updating its copy of the source for every call.
+#ifdef AL_SOFT_deferred_updates
+	static bool hasDeferredUpdates = alIsExtensionPresent("AL_SOFT_deferred_updates") == AL_TRUE;
+	static auto alDeferUpdatesSOFT = hasDeferredUpdates ? (LPALDEFERUPDATESSOFT) alGetProcAddress("alDeferUpdatesSOFT") : nullptr;
+	static auto alProcessUpdatesSOFT = hasDeferredUpdates ? (LPALPROCESSUPDATESSOFT) alGetProcAddress("alProcessUpdatesSOFT") : nullptr;
+
+	if (alDeferUpdatesSOFT && alProcessUpdatesSOFT)
+		alDeferUpdatesSOFT();
+#endif
+
+	for (size_t i = 0; i < sources.size(); i++)
+	{
+		Source *source = (Source*) sources[i];
+		const float *state = states + i * Audio::SOURCE_STATE_COMPONENTS;
+
+		if (source->channels == 1)
+		{
+			source->setFloatv(source->position, &state[0]);
+			source->setFloatv(source->velocity, &state[3]);
+		}
+
+		source->volume = state[6];
+		source->pitch = state[7];
+
+		if (source->valid)
+		{
+			if (source->channels == 1)
+			{
+				alSourcefv(source->source, AL_POSITION, source->position);
+				alSourcefv(source->source, AL_VELOCITY, source->velocity);
+			}
+
+			alSourcef(source->source, AL_GAIN, source->volume);
+			alSourcef(source->source, AL_PITCH, source->pitch);
+		}
+	}
+
+#ifdef AL_SOFT_deferred_updates
+	if (alDeferUpdatesSOFT && alProcessUpdatesSOFT)
+		alProcessUpdatesSOFT();
+#endif
+}
+
 void Source::reset()
 {
 	alSourcei(source, AL_BUFFER, AL_NONE);
@@ -172,6 +172,8 @@ class Source : public love::audio::Source
 	static std::vector<love::audio::Source*> pause(Pool *pool);
 	static void stop(Pool *pool);
 
+	static void setStates(const std::vector<love::audio::Source*> &sources, const float *states);
+
 private:
 
 	void reset();
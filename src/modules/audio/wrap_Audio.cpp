@@ -24,12 +24,14 @@
 
 #include "openal/Audio.h"
 #include "null/Audio.h"
+#include "offline/Audio.h"
 
 #include "common/runtime.h"
 
 // C++
 #include <iostream>
 #include <cmath>
+#include <limits>
 
 namespace love
 {
@@ -208,6 +210,51 @@ int w_pause(lua_State *L)
 	return 0;
 }
 
+int w_setSourceStates(lua_State *L)
+{
+	luaL_checktype(L, 1, LUA_TTABLE);
+	std::vector<Source*> sources = readSourceList(L, 1);
+
+	const int components = Audio::SOURCE_STATE_COMPONENTS;
+	size_t count = sources.size() * components;
+
+	std::vector<float> values;
+	const float *states = nullptr;
+
+	if (luax_istype(L, 2, Data::type))
+	{
+		Data *data = luax_checktype<Data>(L, 2);
+		if (data->getSize() < count * sizeof(float))
+			return luaL_error(L, "Data must contain at least %d floats for %d Sources.", (int) count, (int) sources.size());
+		states = (const float *) data->getData();
+	}
+	else
+	{
+		luaL_checktype(L, 2, LUA_TTABLE);
+		if (luax_objlen(L, 2) < count)
+			return luaL_error(L, "Table must contain at least %d numbers for %d Sources.", (int) count, (int) sources.size());
+
+		values.resize(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			lua_rawgeti(L, 2, (int) i + 1);
+			values[i] = (float) luaL_checknumber(L, -1);
+			lua_pop(L, 1);
+		}
+		states = values.data();
+	}
+
+	for (size_t i = 0; i < sources.size(); i++)
+	{
+		float pitch = states[i * components + 7];
+		if (!(pitch > 0.0f) || pitch > std::numeric_limits<float>::max())
+			return luaL_error(L, "Pitch has to be non-zero, positive, finite number.");
+	}
+
+	luax_catchexcept(L, [&]() { instance()->setSourceStates(sources, states); });
+	return 0;
+}
+
 int w_setVolume(lua_State *L)
 {
 	float v = (float)luaL_checknumber(L, 1);
@@ -627,6 +674,43 @@ int w_setPlaybackDevice(lua_State* L)
 	return 0;
 }
 
+int w_render(lua_State *L)
+{
+	love::sound::SoundData *target = nullptr;
+	int start = 0;
+	int count = 0;
+
+	// Either overwrites a range of an existing SoundData, or creates one.
+	if (luax_istype(L, 1, love::sound::SoundData::type))
+	{
+		target = luax_totype<love::sound::SoundData>(L, 1);
+		target->retain();
+		start = (int) luaL_optinteger(L, 2, 0);
+		count = (int) luaL_optinteger(L, 3, target->getSampleCount() - start);
+	}
+	else
+	{
+		count = (int) luaL_checkinteger(L, 1);
+		int sampleRate = (int) luaL_optinteger(L, 2, love::sound::Decoder::DEFAULT_SAMPLE_RATE);
+		int bitDepth = (int) luaL_optinteger(L, 3, 32);
+		int channels = (int) luaL_optinteger(L, 4, love::sound::Decoder::DEFAULT_CHANNELS);
+
+		if (count <= 0)
+			return luaL_error(L, "Invalid sample count: %d", count);
+
+		luax_catchexcept(L, [&]() { target = new love::sound::SoundData(count, sampleRate, bitDepth, channels); });
+	}
+
+	luax_catchexcept(L,
+		[&]() { instance()->render(target, start, count); },
+		[&](bool shoulderror) { if (shoulderror) target->release(); }
+	);
+
+	luax_pushtype(L, target);
+	target->release();
+	return 1;
+}
+
 // List of functions to wrap.
 static const luaL_Reg functions[] =
 {
@@ -636,6 +720,7 @@ static const luaL_Reg functions[] =
 	{ "play", w_play },
 	{ "stop", w_stop },
 	{ "pause", w_pause },
+	{ "setSourceStates", w_setSourceStates },
 	{ "setVolume", w_setVolume },
 	{ "getVolume", w_getVolume },
 	{ "setPosition", w_setPosition },
@@ -664,6 +749,7 @@ static const luaL_Reg functions[] =
 	{ "getPlaybackDevice", w_getPlaybackDevice },
 	{ "getPlaybackDevices", w_getPlaybackDevices },
 	{ "setPlaybackDevice", w_setPlaybackDevice },
+	{ "render", w_render },
 
 	{ 0, 0 }
 };
@@ -679,7 +765,18 @@ extern "C" int luaopen_love_audio(lua_State *L)
 {
 	Audio *instance = instance();
 
-	if (instance == nullptr)
+	if (instance == nullptr && getOfflineAudio())
+	{
+		try
+		{
+			instance = new love::audio::offline::Audio();
+		}
+		catch(love::Exception &e)
+		{
+			std::cout << e.what() << std::endl;
+		}
+	}
+	else if (instance == nullptr)
 	{
 		// Try OpenAL first.
 		try
@@ -691,7 +788,7 @@ extern "C" int luaopen_love_audio(lua_State *L)
 			std::cout << e.what() << std::endl;
 		}
 	}
-	else
+	else if (instance != nullptr)
 		instance->retain();
 
 	if (instance == nullptr)
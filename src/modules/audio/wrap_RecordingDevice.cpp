@@ -79,6 +79,20 @@ int w_RecordingDevice_stop(lua_State *L)
 int w_RecordingDevice_getData(lua_State *L)
 {
 	RecordingDevice *d = luax_checkrecordingdevice(L, 1);
+
+	if (!lua_isnoneornil(L, 2))
+	{
+		love::sound::SoundData *t = luax_checktype<love::sound::SoundData>(L, 2);
+		int start = (int) luaL_optinteger(L, 3, 0);
+		int count = (int) luaL_optinteger(L, 4, -1);
+
+		int read = 0;
+		luax_catchexcept(L, [&](){ read = d->getData(t, start, count); });
+
+		lua_pushinteger(L, read);
+		return 1;
+	}
+
 	love::sound::SoundData *s = nullptr;
 
 	luax_catchexcept(L, [&](){ s = d->getData(); });
@@ -385,6 +385,30 @@ Rasterizer::DataType BMFontRasterizer::getDataType() const
 	return DATA_IMAGE;
 }
 
+uint64 BMFontRasterizer::getFaceHash() const
+{
+	uint64 hash = FACE_HASH_SEED;
+
+	// The map's iteration order isn't stable, so go through the pages by id.
+	std::vector<int> pages;
+	for (const auto &imagepair : images)
+		pages.push_back(imagepair.first);
+
+	std::sort(pages.begin(), pages.end());
+
+	for (int page : pages)
+	{
+		const image::ImageData *imagedata = images.at(page).get();
+		hash = hashBytes(hash, &page, sizeof(int));
+		hash = hashBytes(hash, imagedata->getData(), imagedata->getSize());
+	}
+
+	hash = hashBytes(hash, characters.data(), characters.size() * sizeof(BMFontCharacter));
+	hash = hashBytes(hash, &fontSize, sizeof(int));
+	hash = hashBytes(hash, &dpiScale, sizeof(float));
+	return hash;
+}
+
 TextShaper *BMFontRasterizer::newTextShaper()
 {
 	return new GenericShaper(this);
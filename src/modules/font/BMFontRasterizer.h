@@ -54,6 +54,7 @@ class BMFontRasterizer : public Rasterizer
 	bool hasGlyph(uint32 glyph) const override;
 	float getKerning(uint32 leftglyph, uint32 rightglyph) const override;
 	DataType getDataType() const override;
+	uint64 getFaceHash() const override;
 	TextShaper *newTextShaper() override;
 
 	static bool accepts(love::filesystem::FileData *fontdef);
@@ -181,6 +181,15 @@ Rasterizer::DataType ImageRasterizer::getDataType() const
 	return DATA_IMAGE;
 }
 
+uint64 ImageRasterizer::getFaceHash() const
+{
+	uint64 hash = hashBytes(FACE_HASH_SEED, imageData->getData(), imageData->getSize());
+	hash = hashBytes(hash, imageGlyphs.data(), imageGlyphs.size() * sizeof(ImageGlyphData));
+	hash = hashBytes(hash, &extraSpacing, sizeof(int));
+	hash = hashBytes(hash, &dpiScale, sizeof(float));
+	return hash;
+}
+
 TextShaper *ImageRasterizer::newTextShaper()
 {
 	return new GenericShaper(this);
@@ -50,6 +50,7 @@ class ImageRasterizer : public Rasterizer
 	int getGlyphCount() const override;
 	bool hasGlyph(uint32 glyph) const override;
 	DataType getDataType() const override;
+	uint64 getFaceHash() const override;
 	TextShaper *newTextShaper() override;
 
 
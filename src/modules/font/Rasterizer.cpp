@@ -112,5 +112,18 @@ float Rasterizer::getDPIScale() const
 	return dpiScale;
 }
 
+bool Rasterizer::isSDF() const
+{
+	return sdf;
+}
+
+uint64 Rasterizer::hashBytes(uint64 hash, const void *data, size_t size)
+{
+	const uint8 *bytes = (const uint8 *) data;
+	for (size_t i = 0; i < size; i++)
+		hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+	return hash;
+}
+
 } // font
 } // love
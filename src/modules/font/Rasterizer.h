@@ -137,14 +137,29 @@ class Rasterizer : public Object
 
 	virtual DataType getDataType() const = 0;
 
+	/**
+	 * Gets a hash of the source data and of the settings which affect the
+	 * rasterized glyphs (size, DPI scale, etc.)
+	 **/
+	virtual uint64 getFaceHash() const = 0;
+
 	virtual ptrdiff_t getHandle() const { return 0; }
 
 	virtual TextShaper *newTextShaper() = 0;
 
 	float getDPIScale() const;
 
+	/**
+	 * Whether glyphs are rasterized as signed distance fields.
+	 **/
+	bool isSDF() const;
+
 protected:
 
+	// FNV-1a, starting from FACE_HASH_SEED.
+	static uint64 hashBytes(uint64 hash, const void *data, size_t size);
+	static const uint64 FACE_HASH_SEED = 0xCBF29CE484222325ULL;
+
 	FontMetrics metrics = {};
 	float dpiScale = 1.0f;
 	bool sdf = false;
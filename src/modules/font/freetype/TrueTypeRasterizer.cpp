@@ -225,6 +225,17 @@ Rasterizer::DataType TrueTypeRasterizer::getDataType() const
 	return DATA_TRUETYPE;
 }
 
+uint64 TrueTypeRasterizer::getFaceHash() const
+{
+	const FT_Size_Metrics &s = face->size->metrics;
+	int32 settings[] = {(int32) s.x_ppem, (int32) s.y_ppem, (int32) s.x_scale, (int32) s.y_scale, (int32) hinting, sdf ? 1 : 0};
+
+	uint64 hash = hashBytes(FACE_HASH_SEED, data->getData(), data->getSize());
+	hash = hashBytes(hash, settings, sizeof(settings));
+	hash = hashBytes(hash, &dpiScale, sizeof(float));
+	return hash;
+}
+
 TextShaper *TrueTypeRasterizer::newTextShaper()
 {
 	return new HarfbuzzShaper(this);
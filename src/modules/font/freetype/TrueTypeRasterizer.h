@@ -56,6 +56,7 @@ class TrueTypeRasterizer : public love::font::TrueTypeRasterizer
 	bool hasGlyph(uint32 glyph) const override;
 	float getKerning(uint32 leftglyph, uint32 rightglyph) const override;
 	DataType getDataType() const override;
+	uint64 getFaceHash() const override;
 	TextShaper *newTextShaper() override;
 
 	ptrdiff_t getHandle() const override { return (ptrdiff_t) face; }
@@ -24,11 +24,14 @@
 #include "common/math.h"
 #include "common/Matrix.h"
 #include "Graphics.h"
+#include "data/ByteData.h"
+#include "image/ImageData.h"
 
 #include <math.h>
 #include <sstream>
 #include <algorithm> // for max
 #include <limits>
+#include <unordered_set>
 
 namespace love
 {
@@ -50,8 +53,36 @@ static inline love::font::TextShaper::GlyphIndex unpackGlyphIndex(uint64 packedi
 	return {(int) (packedindex & 0xFFFFFFFF), (int) (packedindex >> 32)};
 }
 
+static inline uint64 hashBytes(uint64 hash, const void *data, size_t size)
+{
+	// FNV-1a.
+	const uint8 *bytes = (const uint8 *) data;
+	for (size_t i = 0; i < size; i++)
+		hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+	return hash;
+}
+
+static uint64 hashTextLayout(const std::vector<love::font::ColoredString> &text, const Colorf &constantcolor, float wrap, int align)
+{
+	uint64 hash = 0xCBF29CE484222325ULL;
+
+	for (const auto &str : text)
+	{
+		hash = hashBytes(hash, str.str.data(), str.str.size());
+		hash = hashBytes(hash, &str.color, sizeof(Colorf));
+	}
+
+	hash = hashBytes(hash, &constantcolor, sizeof(Colorf));
+	hash = hashBytes(hash, &wrap, sizeof(float));
+	hash = hashBytes(hash, &align, sizeof(int));
+
+	return hash;
+}
+
 love::Type Font::type("Font", &Object::type);
 int Font::fontCount = 0;
+int Font::textLayoutCacheHits = 0;
+int Font::textLayoutCacheMisses = 0;
 
 const CommonFormat Font::vertexFormat = CommonFormat::XYf_STus_RGBAub;
 
@@ -59,8 +90,11 @@ Font::Font(love::font::Rasterizer *r, const SamplerState &s)
 	: shaper(r->newTextShaper(), Acquire::NORETAIN)
 	, textureWidth(128)
 	, textureHeight(128)
+	, usedArea(0)
 	, samplerState()
 	, dpiScale(r->getDPIScale())
+	, sdf(r->isSDF())
+	, glyphUseEpoch(0)
 	, textureCacheID(0)
 {
 	samplerState.minFilter = s.minFilter;
@@ -105,8 +139,11 @@ Font::~Font()
 
 Font::TextureSize Font::getNextTextureSize() const
 {
-	TextureSize size = {textureWidth, textureHeight};
+	return getNextTextureSize({textureWidth, textureHeight});
+}
 
+Font::TextureSize Font::getNextTextureSize(TextureSize size) const
+{
 	int maxsize = 2048;
 	auto gfx = Module::getInstance<Graphics>(Module::M_GRAPHICS);
 	if (gfx != nullptr)
@@ -135,18 +172,23 @@ bool Font::loadVolatile()
 	textureCacheID++;
 	glyphs.clear();
 	textures.clear();
+	pendingUploads.clear();
 	createTexture();
 	return true;
 }
 
 void Font::createTexture()
+{
+	createTexture(getNextTextureSize());
+}
+
+void Font::createTexture(TextureSize nextsize)
 {
 	auto gfx = Module::getInstance<graphics::Graphics>(Module::M_GRAPHICS);
 	gfx->flushBatchedDraws();
 
 	Texture *texture = nullptr;
 	TextureSize size = {textureWidth, textureHeight};
-	TextureSize nextsize = getNextTextureSize();
 	bool recreatetexture = false;
 
 	// If we have an existing texture already, we'll try replacing it with a
@@ -157,6 +199,13 @@ void Font::createTexture()
 		recreatetexture = true;
 		size = nextsize;
 		textures.pop_back();
+		pendingUploads.clear();
+	}
+	else
+	{
+		// The current texture is full, so its pending glyphs must be uploaded
+		// before glyphs start going to the new one.
+		uploadGlyphs();
 	}
 
 	Texture::Settings settings;
@@ -168,30 +217,8 @@ void Font::createTexture()
 
 	{
 		size_t datasize = getPixelFormatSliceSize(pixelFormat, size.width, size.height);
-		size_t pixelcount = size.width * size.height;
-
-		// Initialize the texture with transparent white for truetype fonts
-		// (since we keep luminance constant and vary alpha in those glyphs),
-		// and transparent black otherwise.
-		std::vector<uint8> emptydata(datasize, 0);
-
-		if (shaper->getRasterizers()[0]->getDataType() == font::Rasterizer::DATA_TRUETYPE)
-		{
-			if (pixelFormat == PIXELFORMAT_LA8_UNORM)
-			{
-				for (size_t i = 0; i < pixelcount; i++)
-					emptydata[i * 2 + 0] = 255;
-			}
-			else if (pixelFormat == PIXELFORMAT_RGBA8_UNORM)
-			{
-				for (size_t i = 0; i < pixelcount; i++)
-				{
-					emptydata[i * 4 + 0] = 255;
-					emptydata[i * 4 + 1] = 255;
-					emptydata[i * 4 + 2] = 255;
-				}
-			}
-		}
+		std::vector<uint8> emptydata(datasize);
+		fillEmptyPixels(emptydata.data(), (size_t) size.width * size.height);
 
 		Rect rect = {0, 0, size.width, size.height};
 		texture->replacePixels(emptydata.data(), emptydata.size(), 0, 0, rect, false);
@@ -202,7 +229,9 @@ void Font::createTexture()
 	textureWidth  = size.width;
 	textureHeight = size.height;
 
-	rowHeight = textureX = textureY = TEXTURE_PADDING;
+	resetSkyline();
+	pendingUploads.clear();
+	usedArea = 0;
 
 	// Re-add the old glyphs if we re-created the existing texture object.
 	if (recreatetexture)
@@ -215,16 +244,17 @@ void Font::createTexture()
 			glyphstoadd.push_back(unpackGlyphIndex(glyphpair.first));
 
 		glyphs.clear();
-		
-		for (auto glyphindex : glyphstoadd)
-			addGlyph(glyphindex);
+
+		addGlyphs(glyphstoadd);
 	}
 }
 
 void Font::unloadVolatile()
 {
+	clearTextLayouts();
 	glyphs.clear();
 	textures.clear();
+	pendingUploads.clear();
 }
 
 love::font::GlyphData *Font::getRasterizerGlyphData(love::font::TextShaper::GlyphIndex glyphindex, float &dpiscale)
@@ -234,73 +264,143 @@ love::font::GlyphData *Font::getRasterizerGlyphData(love::font::TextShaper::Glyp
 	return r->getGlyphDataForIndex(glyphindex.index);
 }
 
+void Font::addGlyphs(const std::vector<love::font::TextShaper::GlyphIndex> &glyphindices)
+{
+	struct PendingGlyph
+	{
+		love::font::TextShaper::GlyphIndex index;
+		StrongRef<love::font::GlyphData> data;
+		float dpiScale;
+	};
+
+	std::vector<PendingGlyph> pending;
+	pending.reserve(glyphindices.size());
+
+	for (auto glyphindex : glyphindices)
+	{
+		float dpiscale = getDPIScale();
+		love::font::GlyphData *gd = getRasterizerGlyphData(glyphindex, dpiscale);
+		pending.push_back({glyphindex, StrongRef<love::font::GlyphData>(gd, Acquire::NORETAIN), dpiscale});
+	}
+
+	// If the new glyphs clearly won't fit, grow the texture to a size that
+	// holds them now, rather than re-creating it (and re-adding every glyph)
+	// each time it fills up part way through.
+	int64 neededarea = 0;
+	for (const auto &p : pending)
+		neededarea += (int64) (p.data->getWidth() + TEXTURE_PADDING) * (p.data->getHeight() + TEXTURE_PADDING);
+
+	if (!textures.empty() && usedArea + neededarea > (int64) textureWidth * textureHeight)
+	{
+		// The skyline packer leaves some gaps under taller glyphs, so leave
+		// headroom beyond the exact area needed.
+		int64 target = (usedArea + neededarea) * 5 / 4;
+
+		TextureSize size = {textureWidth, textureHeight};
+		while ((int64) size.width * size.height < target)
+		{
+			TextureSize next = getNextTextureSize(size);
+			if (next.width == size.width && next.height == size.height)
+				break;
+			size = next;
+		}
+
+		if (size.width != textureWidth || size.height != textureHeight)
+			createTexture(size);
+	}
+
+	// Tallest first, so each row of the atlas wastes less space.
+	std::stable_sort(pending.begin(), pending.end(), [](const PendingGlyph &a, const PendingGlyph &b)
+	{
+		return a.data->getHeight() > b.data->getHeight();
+	});
+
+	// If the texture is grown part way through, the glyphs added so far are
+	// re-added to the new texture along with the older ones.
+	for (const auto &p : pending)
+		addGlyph(p.index, p.data, p.dpiScale);
+}
+
 const Font::Glyph &Font::addGlyph(love::font::TextShaper::GlyphIndex glyphindex)
 {
 	float glyphdpiscale = getDPIScale();
 	StrongRef<love::font::GlyphData> gd(getRasterizerGlyphData(glyphindex, glyphdpiscale), Acquire::NORETAIN);
+	return addGlyph(glyphindex, gd, glyphdpiscale);
+}
 
+const Font::Glyph &Font::addGlyph(love::font::TextShaper::GlyphIndex glyphindex, love::font::GlyphData *gd, float glyphdpiscale)
+{
 	int w = gd->getWidth();
 	int h = gd->getHeight();
 
-	if (w + TEXTURE_PADDING * 2 < textureWidth && h + TEXTURE_PADDING * 2 < textureHeight)
+	int textureX = 0;
+	int textureY = 0;
+	int skylineNode = -1;
+
+	if (w > 0 && h > 0)
 	{
-		if (textureX + w + TEXTURE_PADDING > textureWidth)
+		if (w + TEXTURE_PADDING * 2 >= textureWidth || h + TEXTURE_PADDING * 2 >= textureHeight)
 		{
-			// Out of space - new row!
-			textureX = TEXTURE_PADDING;
-			textureY += rowHeight;
-			rowHeight = TEXTURE_PADDING;
+			TextureSize nextsize = getNextTextureSize();
+			if (nextsize.width == textureWidth && nextsize.height == textureHeight)
+				throw love::Exception("Font glyph is too large to fit in the texture atlas.");
+
+			createTexture();
+			return addGlyph(glyphindex, gd, glyphdpiscale);
 		}
 
-		if (textureY + h + TEXTURE_PADDING > textureHeight)
+		if (!findSkylinePosition(w + TEXTURE_PADDING, h + TEXTURE_PADDING, textureX, textureY, skylineNode))
 		{
 			// Totally out of space - new texture!
 			createTexture();
 
-			// Makes sure the above code for checking if the glyph can fit at
-			// the current position in the texture is run again for this glyph.
-			return addGlyph(glyphindex);
+			// Makes sure the above code for checking if the glyph can fit
+			// in the texture is run again for this glyph.
+			return addGlyph(glyphindex, gd, glyphdpiscale);
 		}
 	}
 
 	Glyph g;
 
 	g.texture = nullptr;
+	g.lastUsed = glyphUseEpoch;
 	memset(g.vertices, 0, sizeof(GlyphVertex) * 4);
 
 	// Don't waste space for empty glyphs.
 	if (w > 0 && h > 0)
 	{
-		Texture *texture = textures.back();
-		g.texture = texture;
+		g.texture = textures.back();
 
-		Rect rect = {textureX, textureY, gd->getWidth(), gd->getHeight()};
+		if (pixelFormat != gd->getFormat() && !(pixelFormat == PIXELFORMAT_RGBA8_UNORM && gd->getFormat() == PIXELFORMAT_LA8_UNORM))
+			throw love::Exception("Cannot upload font glyphs to texture atlas: unexpected format conversion.");
 
-		if (pixelFormat != gd->getFormat())
-		{
-			if (!(pixelFormat == PIXELFORMAT_RGBA8_UNORM && gd->getFormat() == PIXELFORMAT_LA8_UNORM))
-				throw love::Exception("Cannot upload font glyphs to texture atlas: unexpected format conversion.");
+		if (pendingUploads.empty())
+			pendingSkyline = skyline;
 
-			const uint8 *src = (const uint8 *) gd->getData();
+		// Convert the glyph to the texture's format. It's uploaded together
+		// with the other new glyphs in uploadGlyphs.
+		const uint8 *src = (const uint8 *) gd->getData();
+		size_t pixelsize = getPixelFormatSliceSize(pixelFormat, 1, 1);
 
-			size_t dstsize = getPixelFormatSliceSize(pixelFormat, w, h);
-			std::vector<uint8> dst(dstsize, 0);
-			uint8 *dstdata = dst.data();
+		PendingUpload upload;
+		upload.rect = {textureX, textureY, w, h};
+		upload.pixels.resize(pixelsize * w * h);
 
-			for (int pixel = 0; pixel < w * h; pixel++)
+		if (pixelFormat != gd->getFormat())
+		{
+			uint8 *dst = upload.pixels.data();
+			for (int i = 0; i < w * h; i++)
 			{
-				dstdata[pixel * 4 + 0] = src[pixel * 2 + 0];
-				dstdata[pixel * 4 + 1] = src[pixel * 2 + 0];
-				dstdata[pixel * 4 + 2] = src[pixel * 2 + 0];
-				dstdata[pixel * 4 + 3] = src[pixel * 2 + 1];
+				dst[i * 4 + 0] = src[i * 2 + 0];
+				dst[i * 4 + 1] = src[i * 2 + 0];
+				dst[i * 4 + 2] = src[i * 2 + 0];
+				dst[i * 4 + 3] = src[i * 2 + 1];
 			}
-
-			texture->replacePixels(dstdata, dstsize, 0, 0, rect, false);
 		}
 		else
-		{
-			texture->replacePixels(gd->getData(), gd->getSize(), 0, 0, rect, false);
-		}
+			memcpy(upload.pixels.data(), src, upload.pixels.size());
+
+		pendingUploads.push_back(std::move(upload));
 
 		double tX     = (double) textureX,     tY      = (double) textureY;
 		double tWidth = (double) textureWidth, tHeight = (double) textureHeight;
@@ -333,8 +433,8 @@ const Font::Glyph &Font::addGlyph(love::font::TextShaper::GlyphIndex glyphindex)
 			g.vertices[i].y /= glyphdpiscale;
 		}
 
-		textureX += w + TEXTURE_PADDING;
-		rowHeight = std::max(rowHeight, h + TEXTURE_PADDING);
+		addSkylineLevel(skylineNode, textureX, textureY, w + TEXTURE_PADDING, h + TEXTURE_PADDING);
+		usedArea += (int64) (w + TEXTURE_PADDING) * (h + TEXTURE_PADDING);
 	}
 
 	uint64 packedindex = packGlyphIndex(glyphindex);
@@ -342,15 +442,271 @@ const Font::Glyph &Font::addGlyph(love::font::TextShaper::GlyphIndex glyphindex)
 	return glyphs[packedindex];
 }
 
+void Font::uploadGlyphs()
+{
+	if (textures.empty() || pendingUploads.empty())
+		return;
+
+	auto gfx = Module::getInstance<graphics::Graphics>(Module::M_GRAPHICS);
+	gfx->flushBatchedDraws();
+
+	// Merge the new glyphs into as few rectangles as possible. There's no CPU
+	// copy of the texture's older glyphs, so a rectangle can't reach above the
+	// skyline from before the new glyphs were packed. That area is empty (or
+	// holds new glyphs) everywhere else.
+	std::vector<Rect> regions;
+
+	for (const auto &upload : pendingUploads)
+	{
+		const Rect &r = upload.rect;
+
+		if (!regions.empty())
+		{
+			const Rect &last = regions.back();
+
+			Rect merged;
+			merged.x = std::min(last.x, r.x);
+			merged.y = std::min(last.y, r.y);
+			merged.w = std::max(last.x + last.w, r.x + r.w) - merged.x;
+			merged.h = std::max(last.y + last.h, r.y + r.h) - merged.y;
+
+			if (isBelowPendingSkyline(merged))
+			{
+				regions.back() = merged;
+				continue;
+			}
+		}
+
+		regions.push_back(r);
+	}
+
+	size_t pixelsize = getPixelFormatSliceSize(pixelFormat, 1, 1);
+	std::vector<uint8> staging;
+
+	for (const Rect &region : regions)
+	{
+		size_t stride = pixelsize * region.w;
+		staging.resize(stride * region.h);
+		fillEmptyPixels(staging.data(), (size_t) region.w * region.h);
+
+		// Copy every new glyph overlapping the region, not just the ones which
+		// were merged into it, so regions don't overwrite each other's glyphs.
+		for (const auto &upload : pendingUploads)
+		{
+			const Rect &r = upload.rect;
+
+			int x1 = std::max(r.x, region.x);
+			int y1 = std::max(r.y, region.y);
+			int x2 = std::min(r.x + r.w, region.x + region.w);
+			int y2 = std::min(r.y + r.h, region.y + region.h);
+
+			for (int y = y1; y < y2 && x1 < x2; y++)
+			{
+				const uint8 *src = upload.pixels.data() + ((y - r.y) * r.w + (x1 - r.x)) * pixelsize;
+				uint8 *dst = staging.data() + (y - region.y) * stride + (x1 - region.x) * pixelsize;
+				memcpy(dst, src, (x2 - x1) * pixelsize);
+			}
+		}
+
+		textures.back()->replacePixels(staging.data(), staging.size(), 0, 0, region, false);
+	}
+
+	pendingUploads.clear();
+}
+
+void Font::fillEmptyPixels(uint8 *dst, size_t pixelcount) const
+{
+	memset(dst, 0, getPixelFormatSliceSize(pixelFormat, 1, 1) * pixelcount);
+
+	// Empty texels are transparent white for truetype fonts (since we keep
+	// luminance constant and vary alpha in those glyphs), and transparent
+	// black otherwise.
+	if (shaper->getRasterizers()[0]->getDataType() == font::Rasterizer::DATA_TRUETYPE)
+	{
+		if (pixelFormat == PIXELFORMAT_LA8_UNORM)
+		{
+			for (size_t i = 0; i < pixelcount; i++)
+				dst[i * 2 + 0] = 255;
+		}
+		else if (pixelFormat == PIXELFORMAT_RGBA8_UNORM)
+		{
+			for (size_t i = 0; i < pixelcount; i++)
+			{
+				dst[i * 4 + 0] = 255;
+				dst[i * 4 + 1] = 255;
+				dst[i * 4 + 2] = 255;
+			}
+		}
+	}
+}
+
+bool Font::isBelowPendingSkyline(const Rect &rect) const
+{
+	for (const auto &node : pendingSkyline)
+	{
+		if (node.x < rect.x + rect.w && node.x + node.width > rect.x && node.y > rect.y)
+			return false;
+	}
+
+	return true;
+}
+
+void Font::resetSkyline()
+{
+	skyline.clear();
+	skyline.push_back({TEXTURE_PADDING, TEXTURE_PADDING, textureWidth - TEXTURE_PADDING});
+}
+
+bool Font::findSkylinePosition(int w, int h, int &x, int &y, int &nodeindex) const
+{
+	// Bottom-left heuristic: the position where the rectangle's bottom edge
+	// is lowest, preferring narrower skyline segments on ties.
+	int bestbottom = std::numeric_limits<int>::max();
+	int bestwidth = std::numeric_limits<int>::max();
+	nodeindex = -1;
+
+	for (int i = 0; i < (int) skyline.size(); i++)
+	{
+		int nodex = skyline[i].x;
+
+		// Nodes are sorted by x and cover the texture's width.
+		if (nodex + w > textureWidth)
+			break;
+
+		int top = 0;
+		int remaining = w;
+		for (int j = i; remaining > 0 && j < (int) skyline.size(); j++)
+		{
+			top = std::max(top, skyline[j].y);
+			remaining -= skyline[j].width;
+		}
+
+		if (remaining > 0 || top + h > textureHeight)
+			continue;
+
+		if (top + h < bestbottom || (top + h == bestbottom && skyline[i].width < bestwidth))
+		{
+			bestbottom = top + h;
+			bestwidth = skyline[i].width;
+			nodeindex = i;
+			x = nodex;
+			y = top;
+		}
+	}
+
+	return nodeindex >= 0;
+}
+
+void Font::addSkylineLevel(int nodeindex, int x, int y, int w, int h)
+{
+	skyline.insert(skyline.begin() + nodeindex, {x, y + h, w});
+
+	// Shrink or remove the nodes now covered by the new one.
+	for (size_t i = nodeindex + 1; i < skyline.size();)
+	{
+		int prevright = skyline[i - 1].x + skyline[i - 1].width;
+		if (skyline[i].x >= prevright)
+			break;
+
+		int shrink = prevright - skyline[i].x;
+		skyline[i].x += shrink;
+		skyline[i].width -= shrink;
+
+		if (skyline[i].width > 0)
+			break;
+
+		skyline.erase(skyline.begin() + i);
+	}
+
+	// Merge neighbours at the same height.
+	for (size_t i = 0; i + 1 < skyline.size();)
+	{
+		if (skyline[i].y == skyline[i + 1].y)
+		{
+			skyline[i].width += skyline[i + 1].width;
+			skyline.erase(skyline.begin() + i + 1);
+		}
+		else
+			i++;
+	}
+}
+
+Font::AtlasStats Font::getAtlasStats() const
+{
+	AtlasStats stats;
+	stats.textureCount = (int) textures.size();
+	stats.textureWidth = textureWidth;
+	stats.textureHeight = textureHeight;
+	stats.glyphCount = (int) glyphs.size();
+	stats.occupancy = (float) ((double) usedArea / ((double) textureWidth * textureHeight));
+	return stats;
+}
+
+int Font::evictUnusedGlyphs()
+{
+	std::vector<love::font::TextShaper::GlyphIndex> keep;
+
+	for (const auto &glyphpair : glyphs)
+	{
+		if (glyphpair.second.lastUsed == glyphUseEpoch)
+			keep.push_back(unpackGlyphIndex(glyphpair.first));
+	}
+
+	int evicted = (int) (glyphs.size() - keep.size());
+
+	if (evicted > 0)
+	{
+		auto gfx = Module::getInstance<graphics::Graphics>(Module::M_GRAPHICS);
+		gfx->flushBatchedDraws();
+
+		// Rebuild the atlas with only the kept glyphs, starting from a single
+		// texture of the current size.
+		textureCacheID++;
+		clearTextLayouts();
+		glyphs.clear();
+		textures.clear();
+		pendingUploads.clear();
+		createTexture({textureWidth, textureHeight});
+
+		addGlyphs(keep);
+		uploadGlyphs();
+	}
+
+	// Kept glyphs have to be drawn again to survive the next eviction.
+	glyphUseEpoch++;
+
+	return evicted;
+}
+
+void Font::markGlyphsUsed(GlyphUsage &usage)
+{
+	if (usage.epoch == glyphUseEpoch)
+		return;
+
+	for (uint64 packedindex : usage.glyphs)
+	{
+		auto it = glyphs.find(packedindex);
+		if (it != glyphs.end())
+			it->second.lastUsed = glyphUseEpoch;
+	}
+
+	usage.epoch = glyphUseEpoch;
+}
+
 const Font::Glyph &Font::findGlyph(love::font::TextShaper::GlyphIndex glyphindex)
 {
 	uint64 packedindex = packGlyphIndex(glyphindex);
 	const auto it = glyphs.find(packedindex);
 
 	if (it != glyphs.end())
+	{
+		it->second.lastUsed = glyphUseEpoch;
 		return it->second;
+	}
 
-	return addGlyph(glyphindex);
+	const Glyph &g = addGlyph(glyphindex);
+	uploadGlyphs();
+	return g;
 }
 
 float Font::getKerning(uint32 leftglyph, uint32 rightglyph)
@@ -368,12 +724,35 @@ float Font::getHeight() const
 	return shaper->getHeight();
 }
 
-std::vector<Font::DrawCommand> Font::generateVertices(const love::font::ColoredCodepoints &codepoints, Range range, const Colorf &constantcolor, std::vector<GlyphVertex> &vertices, float extra_spacing, Vector2 offset, love::font::TextShaper::TextInfo *info)
+std::vector<Font::DrawCommand> Font::generateVertices(const love::font::ColoredCodepoints &codepoints, Range range, const Colorf &constantcolor, std::vector<GlyphVertex> &vertices, float extra_spacing, Vector2 offset, love::font::TextShaper::TextInfo *info, GlyphUsage *usage)
 {
 	std::vector<love::font::TextShaper::GlyphPosition> glyphpositions;
 	std::vector<love::font::IndexedColor> colors;
 	shaper->computeGlyphPositions(codepoints, range, offset, extra_spacing, &glyphpositions, &colors, info);
 
+	// Rasterize and pack every glyph this text is missing up front, so they
+	// can be uploaded to the atlas together.
+	{
+		std::vector<love::font::TextShaper::GlyphIndex> missing;
+		std::unordered_set<uint64> seen;
+
+		for (const auto &pos : glyphpositions)
+		{
+			uint64 packedindex = packGlyphIndex(pos.glyphIndex);
+			if (glyphs.find(packedindex) == glyphs.end() && seen.insert(packedindex).second)
+				missing.push_back(pos.glyphIndex);
+
+			if (usage != nullptr)
+				usage->glyphs.insert(packedindex);
+		}
+
+		if (!missing.empty())
+		{
+			addGlyphs(missing);
+			uploadGlyphs();
+		}
+	}
+
 	size_t vertstartsize = vertices.size();
 	vertices.reserve(vertstartsize + glyphpositions.size() * 4);
 
@@ -459,10 +838,14 @@ std::vector<Font::DrawCommand> Font::generateVertices(const love::font::ColoredC
 
 	std::sort(commands.begin(), commands.end(), drawsort);
 
+	// findGlyph has marked all of them as used.
+	if (usage != nullptr)
+		usage->epoch = glyphUseEpoch;
+
 	return commands;
 }
 
-std::vector<Font::DrawCommand> Font::generateVerticesFormatted(const love::font::ColoredCodepoints &text, const Colorf &constantcolor, float wrap, AlignMode align, std::vector<GlyphVertex> &vertices, love::font::TextShaper::TextInfo *info)
+std::vector<Font::DrawCommand> Font::generateVerticesFormatted(const love::font::ColoredCodepoints &text, const Colorf &constantcolor, float wrap, AlignMode align, std::vector<GlyphVertex> &vertices, love::font::TextShaper::TextInfo *info, GlyphUsage *usage)
 {
 	wrap = std::max(wrap, 0.0f);
 
@@ -522,7 +905,7 @@ std::vector<Font::DrawCommand> Font::generateVerticesFormatted(const love::font:
 				break;
 		}
 
-		std::vector<DrawCommand> newcommands = generateVertices(text, range, constantcolor, vertices, extraspacing, offset);
+		std::vector<DrawCommand> newcommands = generateVertices(text, range, constantcolor, vertices, extraspacing, offset, nullptr, usage);
 
 		if (!newcommands.empty())
 		{
@@ -557,7 +940,7 @@ std::vector<Font::DrawCommand> Font::generateVerticesFormatted(const love::font:
 	if (cacheid != textureCacheID)
 	{
 		vertices.clear();
-		drawcommands = generateVerticesFormatted(text, constantcolor, wrap, align, vertices);
+		drawcommands = generateVerticesFormatted(text, constantcolor, wrap, align, vertices, nullptr, usage);
 	}
 
 	return drawcommands;
@@ -578,6 +961,9 @@ void Font::printv(graphics::Graphics *gfx, const Matrix4 &t, const std::vector<D
 		streamcmd.vertexCount = cmd.vertexcount;
 		streamcmd.texture = cmd.texture;
 
+		if (sdf)
+			streamcmd.standardShaderType = Shader::STANDARD_SDF_TEXT;
+
 		Graphics::BatchedVertexData data = gfx->requestBatchedDraw(streamcmd);
 		GlyphVertex *vertexdata = (GlyphVertex *) data.stream[0];
 
@@ -586,26 +972,370 @@ void Font::printv(graphics::Graphics *gfx, const Matrix4 &t, const std::vector<D
 	}
 }
 
-void Font::print(graphics::Graphics *gfx, const std::vector<love::font::ColoredString> &text, const Matrix4 &m, const Colorf &constantcolor)
+const Font::TextLayout &Font::getTextLayout(const std::vector<love::font::ColoredString> &text, const Colorf &constantcolor, float wrap, AlignMode align)
 {
+	size_t length = 0;
+	for (const auto &str : text)
+		length += str.str.size();
+
+	bool cache = length <= MAX_CACHED_TEXT_LENGTH;
+	uint64 hash = cache ? hashTextLayout(text, constantcolor, wrap, (int) align) : 0;
+
+	auto it = cache ? textLayoutLookup.find(hash) : textLayoutLookup.end();
+	if (it != textLayoutLookup.end())
+	{
+		auto layout = it->second;
+
+		bool match = layout->textureCacheID == textureCacheID
+			&& layout->wrap == wrap && layout->align == align
+			&& layout->constantColor == constantcolor
+			&& layout->text.size() == text.size();
+
+		for (size_t i = 0; match && i < text.size(); i++)
+			match = layout->text[i].str == text[i].str && layout->text[i].color == text[i].color;
+
+		if (match)
+		{
+			textLayoutCacheHits++;
+			textLayouts.splice(textLayouts.begin(), textLayouts, layout);
+			markGlyphsUsed(layout->glyphUsage);
+			return *layout;
+		}
+
+		// Stale, or a hash collision.
+		textLayouts.erase(layout);
+		textLayoutLookup.erase(it);
+	}
+
+	textLayoutCacheMisses++;
+
+	if (cache && textLayouts.size() >= MAX_TEXT_LAYOUTS)
+	{
+		textLayoutLookup.erase(textLayouts.back().hash);
+		textLayouts.pop_back();
+	}
+
+	// Long text goes into a scratch layout which is reused by the next miss.
+	if (cache)
+		textLayouts.emplace_front();
+	else
+		uncachedTextLayout.drawCommands.clear();
+
+	TextLayout &layout = cache ? textLayouts.front() : uncachedTextLayout;
+	layout.vertices.clear();
+	layout.glyphUsage = GlyphUsage();
+
+	// The uncached layout is never drawn again, so it doesn't need to know
+	// which glyphs it uses.
+	GlyphUsage *usage = cache ? &layout.glyphUsage : nullptr;
+
+	if (cache)
+		layout.text = text;
+
+	layout.constantColor = constantcolor;
+	layout.wrap = wrap;
+	layout.align = align;
+	layout.hash = hash;
+
 	love::font::ColoredCodepoints codepoints;
 	love::font::getCodepointsFromString(text, codepoints);
 
-	std::vector<GlyphVertex> vertices;
-	std::vector<DrawCommand> drawcommands = generateVertices(codepoints, Range(), constantcolor, vertices);
+	if (wrap < 0.0f)
+		layout.drawCommands = generateVertices(codepoints, Range(), constantcolor, layout.vertices, 0.0f, Vector2(), nullptr, usage);
+	else
+		layout.drawCommands = generateVerticesFormatted(codepoints, constantcolor, wrap, align, layout.vertices, nullptr, usage);
 
-	printv(gfx, m, drawcommands, vertices);
+	// Generating the vertices may have invalidated the texture cache.
+	layout.textureCacheID = textureCacheID;
+
+	if (cache)
+		textLayoutLookup[hash] = textLayouts.begin();
+
+	return layout;
 }
 
-void Font::printf(graphics::Graphics *gfx, const std::vector<love::font::ColoredString> &text, float wrap, AlignMode align, const Matrix4 &m, const Colorf &constantcolor)
+void Font::prewarm(const std::string &text)
 {
-	love::font::ColoredCodepoints codepoints;
+	std::vector<uint32> codepoints;
 	love::font::getCodepointsFromString(text, codepoints);
 
-	std::vector<GlyphVertex> vertices;
-	std::vector<DrawCommand> drawcommands = generateVerticesFormatted(codepoints, constantcolor, wrap, align, vertices);
+	std::vector<love::font::TextShaper::GlyphIndex> missing;
+	std::unordered_set<uint64> seen;
+
+	for (uint32 codepoint : codepoints)
+	{
+		love::font::TextShaper::GlyphIndex glyphindex = {0, 0};
+		shaper->getGlyphAdvance(codepoint, &glyphindex);
+
+		uint64 packedindex = packGlyphIndex(glyphindex);
+		if (glyphs.find(packedindex) == glyphs.end() && seen.insert(packedindex).second)
+			missing.push_back(glyphindex);
+	}
+
+	if (!missing.empty())
+	{
+		addGlyphs(missing);
+		uploadGlyphs();
+	}
+}
+
+// Atlas files start with this, followed by AtlasHeader, each texture's pixels,
+// the skyline of the last texture, and then a SavedGlyph for every glyph.
+static const char atlasMagic[8] = {'L', 'O', 'V', 'E', 'F', 'A', 'T', 'L'};
+static const uint32 atlasVersion = 2;
+
+struct AtlasHeader
+{
+	uint32 version;
+	uint32 pixelFormat;
+	uint64 faceHash;
+	int32 fontHeight;
+	float dpiScale;
+	int32 rasterizerCount;
+	int32 sdf;
+	int32 textureWidth;
+	int32 textureHeight;
+	int32 textureCount;
+	int32 skylineCount;
+	int32 glyphCount;
+	int64 usedArea;
+};
 
-	printv(gfx, m, drawcommands, vertices);
+struct SavedGlyph
+{
+	uint64 index;
+	int32 texture; // -1 for empty glyphs.
+	int32 padding;
+	Font::GlyphVertex vertices[4];
+};
+
+// Identifies the font data, size and rasterization settings of the main font
+// and its fallbacks.
+static uint64 hashFaces(const std::vector<StrongRef<love::font::Rasterizer>> &rasterizers)
+{
+	uint64 hash = 0xCBF29CE484222325ULL;
+	for (const auto &r : rasterizers)
+	{
+		uint64 facehash = r->getFaceHash();
+		hash = hashBytes(hash, &facehash, sizeof(uint64));
+	}
+	return hash;
+}
+
+love::data::ByteData *Font::saveAtlas()
+{
+	uploadGlyphs();
+
+	AtlasHeader header = {};
+	header.version = atlasVersion;
+	header.pixelFormat = (uint32) pixelFormat;
+	header.faceHash = hashFaces(shaper->getRasterizers());
+	header.fontHeight = shaper->getRasterizers()[0]->getHeight();
+	header.dpiScale = dpiScale;
+	header.rasterizerCount = (int32) shaper->getRasterizers().size();
+	header.sdf = sdf ? 1 : 0;
+	header.textureWidth = textureWidth;
+	header.textureHeight = textureHeight;
+	header.textureCount = (int32) textures.size();
+	header.skylineCount = (int32) skyline.size();
+	header.glyphCount = (int32) glyphs.size();
+	header.usedArea = usedArea;
+
+	size_t texturesize = getPixelFormatSliceSize(pixelFormat, textureWidth, textureHeight);
+	size_t size = sizeof(atlasMagic) + sizeof(AtlasHeader) + texturesize * textures.size()
+		+ skyline.size() * sizeof(SkylineNode) + glyphs.size() * sizeof(SavedGlyph);
+
+	auto bytedata = new love::data::ByteData(size, false);
+	uint8 *dst = (uint8 *) bytedata->getData();
+
+	memcpy(dst, atlasMagic, sizeof(atlasMagic));
+	dst += sizeof(atlasMagic);
+
+	memcpy(dst, &header, sizeof(AtlasHeader));
+	dst += sizeof(AtlasHeader);
+
+	// The atlas pixels aren't kept in CPU memory, so they're read back from
+	// the textures.
+	auto gfx = Module::getInstance<graphics::Graphics>(Module::M_GRAPHICS);
+
+	for (const auto &texture : textures)
+	{
+		Rect rect = {0, 0, textureWidth, textureHeight};
+		StrongRef<love::image::ImageData> imagedata;
+
+		try
+		{
+			imagedata.set(gfx->readbackTexture(texture, 0, 0, rect, nullptr, 0, 0), Acquire::NORETAIN);
+		}
+		catch (love::Exception &)
+		{
+			bytedata->release();
+			throw;
+		}
+
+		memcpy(dst, imagedata->getData(), texturesize);
+		dst += texturesize;
+	}
+
+	memcpy(dst, skyline.data(), skyline.size() * sizeof(SkylineNode));
+	dst += skyline.size() * sizeof(SkylineNode);
+
+	for (const auto &glyphpair : glyphs)
+	{
+		SavedGlyph saved = {};
+		saved.index = glyphpair.first;
+		saved.texture = -1;
+
+		for (size_t i = 0; i < textures.size(); i++)
+		{
+			if (textures[i].get() == glyphpair.second.texture)
+				saved.texture = (int32) i;
+		}
+
+		memcpy(saved.vertices, glyphpair.second.vertices, sizeof(saved.vertices));
+
+		memcpy(dst, &saved, sizeof(SavedGlyph));
+		dst += sizeof(SavedGlyph);
+	}
+
+	return bytedata;
+}
+
+void Font::loadAtlas(const love::Data *data)
+{
+	const uint8 *src = (const uint8 *) data->getData();
+	size_t size = data->getSize();
+
+	AtlasHeader header;
+
+	if (size < sizeof(atlasMagic) + sizeof(AtlasHeader) || memcmp(src, atlasMagic, sizeof(atlasMagic)) != 0)
+		throw love::Exception("Invalid font atlas data.");
+
+	memcpy(&header, src + sizeof(atlasMagic), sizeof(AtlasHeader));
+
+	if (header.version != atlasVersion)
+		throw love::Exception("Unsupported font atlas version: %d", (int) header.version);
+
+	if (header.pixelFormat != (uint32) pixelFormat || header.fontHeight != shaper->getRasterizers()[0]->getHeight()
+		|| header.dpiScale != dpiScale || header.rasterizerCount != (int32) shaper->getRasterizers().size()
+		|| header.sdf != (sdf ? 1 : 0) || header.faceHash != hashFaces(shaper->getRasterizers()))
+		throw love::Exception("Font atlas data was saved from a different font, or from one with a different size or format.");
+
+	if (header.textureWidth <= 0 || header.textureHeight <= 0 || header.textureCount <= 0 || header.skylineCount <= 0 || header.glyphCount < 0)
+		throw love::Exception("Invalid font atlas data.");
+
+	// Every section's size comes from the header, so check each one against
+	// the bytes that are actually left rather than summing possibly-overflowing
+	// products.
+	size_t remaining = size - (sizeof(atlasMagic) + sizeof(AtlasHeader));
+	size_t texturesize = getPixelFormatSliceSize(pixelFormat, header.textureWidth, header.textureHeight);
+
+	if (texturesize == 0 || (size_t) header.textureCount > remaining / texturesize)
+		throw love::Exception("Invalid font atlas data size.");
+	remaining -= texturesize * header.textureCount;
+
+	if ((size_t) header.skylineCount > remaining / sizeof(SkylineNode))
+		throw love::Exception("Invalid font atlas data size.");
+	remaining -= sizeof(SkylineNode) * header.skylineCount;
+
+	if (remaining != sizeof(SavedGlyph) * (size_t) header.glyphCount)
+		throw love::Exception("Invalid font atlas data size.");
+
+	const uint8 *texturedata = src + sizeof(atlasMagic) + sizeof(AtlasHeader);
+	const uint8 *skylinesrc = texturedata + texturesize * header.textureCount;
+	const uint8 *glyphsrc = skylinesrc + sizeof(SkylineNode) * header.skylineCount;
+
+	// The packer relies on the skyline being sorted by x, with no gaps or
+	// overlaps, spanning exactly [TEXTURE_PADDING, textureWidth).
+	std::vector<SkylineNode> newskyline(header.skylineCount);
+	memcpy(newskyline.data(), skylinesrc, sizeof(SkylineNode) * header.skylineCount);
+
+	int skylineend = TEXTURE_PADDING;
+	for (const auto &node : newskyline)
+	{
+		if (node.x != skylineend || node.width <= 0 || node.width > header.textureWidth - node.x || node.y < 0 || node.y > header.textureHeight)
+			throw love::Exception("Invalid font atlas data.");
+		skylineend = node.x + node.width;
+	}
+
+	if (skylineend != header.textureWidth)
+		throw love::Exception("Invalid font atlas data.");
+
+	auto gfx = Module::getInstance<graphics::Graphics>(Module::M_GRAPHICS);
+	gfx->flushBatchedDraws();
+
+	std::vector<StrongRef<Texture>> newtextures;
+
+	const uint8 *texturesrc = texturedata;
+
+	for (int i = 0; i < header.textureCount; i++)
+	{
+		Texture::Settings settings;
+		settings.format = pixelFormat;
+		settings.width = header.textureWidth;
+		settings.height = header.textureHeight;
+
+		StrongRef<Texture> texture(gfx->newTexture(settings, nullptr), Acquire::NORETAIN);
+		texture->setSamplerState(samplerState);
+
+		Rect rect = {0, 0, header.textureWidth, header.textureHeight};
+		texture->replacePixels(texturesrc, texturesize, 0, 0, rect, false);
+
+		newtextures.push_back(texture);
+
+		texturesrc += texturesize;
+	}
+
+	std::unordered_map<uint64, Glyph> newglyphs;
+
+	for (int i = 0; i < header.glyphCount; i++)
+	{
+		SavedGlyph saved;
+		memcpy(&saved, glyphsrc + i * sizeof(SavedGlyph), sizeof(SavedGlyph));
+
+		if (saved.texture < -1 || saved.texture >= header.textureCount)
+			throw love::Exception("Invalid font atlas data.");
+
+		love::font::TextShaper::GlyphIndex glyphindex = unpackGlyphIndex(saved.index);
+		if (glyphindex.rasterizerIndex < 0 || glyphindex.rasterizerIndex >= header.rasterizerCount)
+			throw love::Exception("Invalid font atlas data.");
+
+		Glyph g;
+		g.texture = saved.texture >= 0 ? newtextures[saved.texture].get() : nullptr;
+		g.lastUsed = glyphUseEpoch;
+		memcpy(g.vertices, saved.vertices, sizeof(g.vertices));
+
+		newglyphs[saved.index] = g;
+	}
+
+	textures = std::move(newtextures);
+	pendingUploads.clear();
+	glyphs = std::move(newglyphs);
+
+	textureWidth = header.textureWidth;
+	textureHeight = header.textureHeight;
+	skyline = std::move(newskyline);
+	usedArea = header.usedArea;
+
+	textureCacheID++;
+}
+
+void Font::clearTextLayouts()
+{
+	textLayouts.clear();
+	textLayoutLookup.clear();
+}
+
+void Font::print(graphics::Graphics *gfx, const std::vector<love::font::ColoredString> &text, const Matrix4 &m, const Colorf &constantcolor)
+{
+	const TextLayout &layout = getTextLayout(text, constantcolor, -1.0f, ALIGN_MAX_ENUM);
+	printv(gfx, m, layout.drawCommands, layout.vertices);
+}
+
+void Font::printf(graphics::Graphics *gfx, const std::vector<love::font::ColoredString> &text, float wrap, AlignMode align, const Matrix4 &m, const Colorf &constantcolor)
+{
+	const TextLayout &layout = getTextLayout(text, constantcolor, std::max(wrap, 0.0f), align);
+	printv(gfx, m, layout.drawCommands, layout.vertices);
 }
 
 float Font::getWidth(const std::string &str)
@@ -631,6 +1361,7 @@ void Font::getWrap(const std::vector<love::font::ColoredString> &text, float wra
 void Font::setLineHeight(float height)
 {
 	shaper->setLineHeight(height);
+	clearTextLayouts();
 }
 
 float Font::getLineHeight() const
@@ -692,7 +1423,9 @@ void Font::setFallbacks(const std::vector<Font *> &fallbacks)
 	while (textures.size() > 1)
 		textures.pop_back();
 
-	rowHeight = textureX = textureY = TEXTURE_PADDING;
+	resetSkyline();
+	usedArea = 0;
+	pendingUploads.clear();
 }
 
 float Font::getDPIScale() const
@@ -700,6 +1433,11 @@ float Font::getDPIScale() const
 	return dpiScale;
 }
 
+bool Font::isSDF() const
+{
+	return sdf;
+}
+
 uint32 Font::getTextureCacheID() const
 {
 	return textureCacheID;
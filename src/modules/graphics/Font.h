@@ -22,6 +22,8 @@
 
 // STD
 #include <unordered_map>
+#include <unordered_set>
+#include <list>
 #include <string>
 #include <vector>
 #include <stddef.h>
@@ -31,6 +33,7 @@
 #include "common/Object.h"
 #include "common/Matrix.h"
 #include "common/Vector.h"
+#include "common/Data.h"
 
 #include "font/Rasterizer.h"
 #include "font/TextShaper.h"
@@ -40,6 +43,11 @@
 
 namespace love
 {
+namespace data
+{
+class ByteData;
+}
+
 namespace graphics
 {
 
@@ -65,6 +73,17 @@ class Font : public Object, public Volatile
 		ALIGN_MAX_ENUM
 	};
 
+	struct AtlasStats
+	{
+		int textureCount;
+		int textureWidth;
+		int textureHeight;
+		int glyphCount;
+
+		// Fraction of the last texture's area taken up by glyphs.
+		float occupancy;
+	};
+
 	// Used to determine when to change textures in the generated vertex array.
 	struct DrawCommand
 	{
@@ -73,15 +92,23 @@ class Font : public Object, public Volatile
 		int vertexcount;
 	};
 
+	// Glyphs used by generated vertices, so markGlyphsUsed can keep them from
+	// being evicted while the vertices are reused.
+	struct GlyphUsage
+	{
+		std::unordered_set<uint64> glyphs;
+		uint32 epoch = 0;
+	};
+
 	Font(love::font::Rasterizer *r, const SamplerState &samplerState);
 
 	virtual ~Font();
 
 	std::vector<DrawCommand> generateVertices(const love::font::ColoredCodepoints &codepoints, Range range, const Colorf &constantColor, std::vector<GlyphVertex> &vertices,
-	                                          float extra_spacing = 0.0f, Vector2 offset = {}, love::font::TextShaper::TextInfo *info = nullptr);
+	                                          float extra_spacing = 0.0f, Vector2 offset = {}, love::font::TextShaper::TextInfo *info = nullptr, GlyphUsage *usage = nullptr);
 
 	std::vector<DrawCommand> generateVerticesFormatted(const love::font::ColoredCodepoints &text, const Colorf &constantColor, float wrap, AlignMode align,
-	                                                   std::vector<GlyphVertex> &vertices, love::font::TextShaper::TextInfo *info = nullptr);
+	                                                   std::vector<GlyphVertex> &vertices, love::font::TextShaper::TextInfo *info = nullptr, GlyphUsage *usage = nullptr);
 
 	/**
 	 * Draws the specified text.
@@ -148,8 +175,44 @@ class Font : public Object, public Volatile
 
 	float getDPIScale() const;
 
+	/**
+	 * Whether the glyphs are signed distance fields, which are drawn with
+	 * their own default shader and stay sharp when scaled.
+	 **/
+	bool isSDF() const;
+
 	uint32 getTextureCacheID() const;
 
+	/**
+	 * Rasterizes the glyphs of every character in the string and adds them to
+	 * the texture atlas, growing it up front if needed.
+	 **/
+	void prewarm(const std::string &text);
+
+	/**
+	 * Serializes the texture atlas pixels and glyph placements, so they can be
+	 * restored with loadAtlas by a Font with the same source, size and DPI
+	 * scale without rasterizing the glyphs again. The pixels are read back
+	 * from the GPU, so this waits for rendering to the atlas to finish.
+	 **/
+	love::data::ByteData *saveAtlas();
+	void loadAtlas(const love::Data *data);
+
+	AtlasStats getAtlasStats() const;
+
+	/**
+	 * Removes the glyphs which haven't been used to lay out text since the
+	 * previous call, and repacks the remaining ones into a single texture.
+	 * Returns the number of evicted glyphs.
+	 **/
+	int evictUnusedGlyphs();
+
+	/**
+	 * Marks the glyphs as used by previously generated vertices which are
+	 * being drawn again. Only does any work once per evictUnusedGlyphs call.
+	 **/
+	void markGlyphsUsed(GlyphUsage &usage);
+
 	VertexAttributesID getVertexAttributesID() const { return vertexAttributesID; }
 
 	// Implements Volatile.
@@ -162,12 +225,33 @@ class Font : public Object, public Volatile
 
 	static int fontCount;
 
+	// Per-frame counts of print/printf calls which reused a cached layout,
+	// and of those which had to shape the text.
+	static int textLayoutCacheHits;
+	static int textLayoutCacheMisses;
+
 private:
 
 	struct Glyph
 	{
 		Texture *texture;
 		GlyphVertex vertices[4];
+		uint32 lastUsed;
+	};
+
+	// Top edge of the packed glyphs over a horizontal span of the texture.
+	struct SkylineNode
+	{
+		int32 x;
+		int32 y;
+		int32 width;
+	};
+
+	// Pixels of a glyph in the texture's format, waiting for uploadGlyphs.
+	struct PendingUpload
+	{
+		Rect rect;
+		std::vector<uint8> pixels;
 	};
 
 	struct TextureSize
@@ -176,13 +260,42 @@ class Font : public Object, public Volatile
 		int height;
 	};
 
+	// Shaped and positioned glyph vertices of a print or printf call. wrap is
+	// negative for print.
+	struct TextLayout
+	{
+		std::vector<love::font::ColoredString> text;
+		Colorf constantColor;
+		float wrap;
+		AlignMode align;
+
+		uint64 hash;
+		uint32 textureCacheID;
+
+		std::vector<DrawCommand> drawCommands;
+		std::vector<GlyphVertex> vertices;
+		GlyphUsage glyphUsage;
+	};
+
 	void createTexture();
 
 	TextureSize getNextTextureSize() const;
+	TextureSize getNextTextureSize(TextureSize size) const;
+	void createTexture(TextureSize size);
 	love::font::GlyphData *getRasterizerGlyphData(love::font::TextShaper::GlyphIndex glyphindex, float &dpiscale);
+	void addGlyphs(const std::vector<love::font::TextShaper::GlyphIndex> &glyphindices);
 	const Glyph &addGlyph(love::font::TextShaper::GlyphIndex glyphindex);
+	const Glyph &addGlyph(love::font::TextShaper::GlyphIndex glyphindex, love::font::GlyphData *gd, float glyphdpiscale);
+	void uploadGlyphs();
+	void fillEmptyPixels(uint8 *dst, size_t pixelcount) const;
+	bool isBelowPendingSkyline(const Rect &rect) const;
+	void resetSkyline();
+	bool findSkylinePosition(int w, int h, int &x, int &y, int &nodeindex) const;
+	void addSkylineLevel(int nodeindex, int x, int y, int w, int h);
 	const Glyph &findGlyph(love::font::TextShaper::GlyphIndex glyphindex);
 	void printv(Graphics *gfx, const Matrix4 &t, const std::vector<DrawCommand> &drawcommands, const std::vector<GlyphVertex> &vertices);
+	const TextLayout &getTextLayout(const std::vector<love::font::ColoredString> &text, const Colorf &constantcolor, float wrap, AlignMode align);
+	void clearTextLayouts();
 
 	StrongRef<love::font::TextShaper> shaper;
 
@@ -191,6 +304,15 @@ class Font : public Object, public Volatile
 
 	std::vector<StrongRef<Texture>> textures;
 
+	// New glyphs which haven't been uploaded to the last texture yet, and the
+	// skyline from before they were packed (the area below it holds no older
+	// glyphs, so uploadGlyphs can upload it in large rectangles).
+	std::vector<PendingUpload> pendingUploads;
+	std::vector<SkylineNode> pendingSkyline;
+
+	// Area taken up by glyphs (including padding) in the last texture.
+	int64 usedArea;
+
 	// maps packed glyph index values to glyph texture information
 	std::unordered_map<uint64, Glyph> glyphs;
 
@@ -200,14 +322,28 @@ class Font : public Object, public Volatile
 
 	float dpiScale;
 
-	int textureX, textureY;
-	int rowHeight;
+	bool sdf;
+
+	// Skyline of the last texture, sorted by x.
+	std::vector<SkylineNode> skyline;
+
+	// Glyphs used since the last evictUnusedGlyphs have this lastUsed value.
+	uint32 glyphUseEpoch;
 
 	// ID which is incremented when the texture cache is invalidated.
 	uint32 textureCacheID;
 
 	VertexAttributesID vertexAttributesID;
 
+	// Recently printed text, most recently used first.
+	std::list<TextLayout> textLayouts;
+	std::unordered_map<uint64, std::list<TextLayout>::iterator> textLayoutLookup;
+	TextLayout uncachedTextLayout;
+
+	// Text longer than this (in bytes) bypasses the layout cache.
+	static const size_t MAX_CACHED_TEXT_LENGTH = 4096;
+	static const size_t MAX_TEXT_LAYOUTS = 64;
+
 	// 1 pixel of transparent padding between glyphs (so quads won't pick up
 	// other glyphs), plus one pixel of transparent padding that the quads will
 	// use, for edge antialiasing.
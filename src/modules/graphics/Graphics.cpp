@@ -348,9 +348,9 @@ Video *Graphics::newVideo(love::video::VideoStream *stream, float dpiscale)
 	return new Video(this, stream, dpiscale);
 }
 
-love::graphics::SpriteBatch *Graphics::newSpriteBatch(Texture *texture, int size, BufferDataUsage usage)
+love::graphics::SpriteBatch *Graphics::newSpriteBatch(Texture *texture, int size, BufferDataUsage usage, bool instanced)
 {
-	return new SpriteBatch(this, texture, size, usage);
+	return new SpriteBatch(this, texture, size, usage, instanced);
 }
 
 love::graphics::ParticleSystem *Graphics::newParticleSystem(Texture *texture, int size)
@@ -2765,6 +2765,8 @@ Graphics::Stats Graphics::getStats() const
 	stats.drawCallsBatched = drawCallsBatched;
 	stats.textures = Texture::textureCount;
 	stats.fonts = Font::fontCount;
+	stats.textLayoutCacheHits = Font::textLayoutCacheHits;
+	stats.textLayoutCacheMisses = Font::textLayoutCacheMisses;
 	stats.buffers = Buffer::bufferCount;
 	stats.textureMemory = Texture::totalGraphicsMemory;
 	stats.bufferMemory = Buffer::totalGraphicsMemory;
@@ -229,6 +229,8 @@ class Graphics : public Module
 		int shaderSwitches;
 		int textures;
 		int fonts;
+		int textLayoutCacheHits;
+		int textLayoutCacheMisses;
 		int buffers;
 		int64 textureMemory;
 		int64 bufferMemory;
@@ -485,7 +487,7 @@ class Graphics : public Module
 	Font *newDefaultFont(int size, const font::TrueTypeRasterizer::Settings &settings);
 	Video *newVideo(love::video::VideoStream *stream, float dpiscale);
 
-	SpriteBatch *newSpriteBatch(Texture *texture, int size, BufferDataUsage usage);
+	SpriteBatch *newSpriteBatch(Texture *texture, int size, BufferDataUsage usage, bool instanced = false);
 	ParticleSystem *newParticleSystem(Texture *texture, int size);
 
 	Shader *newShader(const std::vector<std::string> &stagessource, const Shader::CompileOptions &options);
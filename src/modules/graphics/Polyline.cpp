@@ -33,13 +33,25 @@ namespace love
 namespace graphics
 {
 
+// Scratch memory shared by all lines generated on a thread. Keeping it around
+// between draws means line generation doesn't allocate once the buffers have
+// grown, and keeping it per-thread means lines can be generated off the main
+// thread.
+struct PolylineScratch
+{
+	std::vector<Vector2> anchors;
+	std::vector<Vector2> normals;
+};
+
+static thread_local PolylineScratch scratch;
+
 void Polyline::render(const Vector2 *coords, size_t count, size_t size_hint, float halfwidth, float pixel_size, bool draw_overdraw)
 {
-	static std::vector<Vector2> anchors;
+	std::vector<Vector2> &anchors = scratch.anchors;
 	anchors.clear();
 	anchors.reserve(size_hint);
 
-	static std::vector<Vector2> normals;
+	std::vector<Vector2> &normals = scratch.normals;
 	normals.clear();
 	normals.reserve(size_hint);
 
@@ -87,10 +99,13 @@ void Polyline::render(const Vector2 *coords, size_t count, size_t size_hint, flo
 	}
 
 	// Use a single linear array for both the regular and overdraw vertices.
-	vertices = new Vector2[vertex_count + extra_vertices + overdraw_vertex_count];
+	// The anchors aren't needed once the sleeve is computed, so their storage
+	// is reused for it rather than allocating a new array for every line.
+	anchors.resize(vertex_count + extra_vertices + overdraw_vertex_count);
+	vertices = anchors.data();
 
 	for (size_t i = 0; i < vertex_count; ++i)
-		vertices[i] = anchors[i] + normals[i];
+		vertices[i] += normals[i];
 
 	if (draw_overdraw)
 	{
@@ -393,8 +408,6 @@ void NoneJoinPolyline::render_overdraw(const std::vector<Vector2> &/*normals*/,
 
 Polyline::~Polyline()
 {
-	if (vertices)
-		delete[] vertices;
 }
 
 void Polyline::draw(love::graphics::Graphics *gfx)
@@ -90,6 +90,8 @@ class Polyline
 	                        Vector2 &segment, float &segmentLength, Vector2 &segmentNormal,
 	                        const Vector2 &pointA, const Vector2 &pointB, float halfWidth) = 0;
 
+	// Points into per-thread scratch memory, which is only valid until the next
+	// Polyline is rendered on the same thread.
 	Vector2 *vertices;
 	Vector2 *overdraw;
 	size_t vertex_count;
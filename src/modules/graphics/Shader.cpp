@@ -1812,6 +1812,25 @@ vec4 position(mat4 clipSpaceFromLocal, vec4 localPosition)
 }
 )";
 
+// Expands the per-sprite data of instanced SpriteBatches into a quad. The
+// quad index buffer's vertex IDs are laid out as 0---2 / 1---3.
+static const std::string defaultSpriteInstancedVertex = R"(
+attribute vec3 InstanceTransformX;
+attribute vec3 InstanceTransformY;
+attribute vec4 InstanceTexRect;
+attribute vec4 InstanceColor;
+attribute float InstanceLayer;
+
+vec4 position(mat4 clipSpaceFromLocal, vec4 localPosition)
+{
+	vec2 corner = vec2(float((love_VertexID >> 1) & 1), float(love_VertexID & 1));
+	vec3 p = vec3(corner, 1.0);
+	VaryingTexCoord = vec4(mix(InstanceTexRect.xy, InstanceTexRect.zw, corner), InstanceLayer, 0.0);
+	VaryingColor = gammaCorrectColor(InstanceColor) * ConstantColor;
+	return clipSpaceFromLocal * vec4(dot(InstanceTransformX, p), dot(InstanceTransformY, p), 0.0, 1.0);
+}
+)";
+
 static const std::string defaultStandardPixel = R"(
 vec4 effect(vec4 vcolor, Image tex, vec2 texcoord, vec2 pixcoord)
 {
@@ -1819,6 +1838,19 @@ vec4 effect(vec4 vcolor, Image tex, vec2 texcoord, vec2 pixcoord)
 }
 )";
 
+// Signed distance field glyphs store the distance to the glyph's edge in
+// alpha, with the edge at 0.5. The screen-space derivative keeps the edge
+// about one pixel wide at any scale.
+static const std::string defaultSDFTextPixel = R"(
+vec4 effect(vec4 vcolor, Image tex, vec2 texcoord, vec2 pixcoord)
+{
+	float dist = Texel(tex, texcoord).a;
+	float width = max(fwidth(dist), 0.0001);
+	float alpha = smoothstep(0.5 - width, 0.5 + width, dist);
+	return vec4(1.0, 1.0, 1.0, alpha) * vcolor;
+}
+)";
+
 static const std::string defaultVideoPixel = R"(
 void effect()
 {
@@ -1840,6 +1872,8 @@ const std::string &Shader::getDefaultCode(StandardShader shader, ShaderStageType
 	{
 		if (shader == STANDARD_POINTS)
 			return defaultPointsVertex;
+		else if (shader == STANDARD_SPRITE_INSTANCED || shader == STANDARD_SPRITE_INSTANCED_ARRAY)
+			return defaultSpriteInstancedVertex;
 		else
 			return defaultVertex;
 	}
@@ -1852,6 +1886,9 @@ const std::string &Shader::getDefaultCode(StandardShader shader, ShaderStageType
 		case STANDARD_VIDEO: return defaultVideoPixel;
 		case STANDARD_ARRAY: return defaultArrayPixel;
 		case STANDARD_POINTS: return defaultStandardPixel;
+		case STANDARD_SPRITE_INSTANCED: return defaultStandardPixel;
+		case STANDARD_SPRITE_INSTANCED_ARRAY: return defaultArrayPixel;
+		case STANDARD_SDF_TEXT: return defaultSDFTextPixel;
 		case STANDARD_MAX_ENUM: return nocode;
 	}
 
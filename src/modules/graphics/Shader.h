@@ -95,6 +95,9 @@ class Shader : public Object, public Resource
 		STANDARD_VIDEO,
 		STANDARD_ARRAY,
 		STANDARD_POINTS,
+		STANDARD_SPRITE_INSTANCED,
+		STANDARD_SPRITE_INSTANCED_ARRAY,
+		STANDARD_SDF_TEXT,
 		STANDARD_MAX_ENUM
 	};
 
@@ -29,6 +29,7 @@
 
 // C++
 #include <algorithm>
+#include <cmath>
 
 // C
 #include <stddef.h>
@@ -40,12 +41,13 @@ namespace graphics
 
 love::Type SpriteBatch::type("SpriteBatch", &Drawable::type);
 
-SpriteBatch::SpriteBatch(Graphics *gfx, Texture *texture, int size, BufferDataUsage usage)
+SpriteBatch::SpriteBatch(Graphics *gfx, Texture *texture, int size, BufferDataUsage usage, bool instanced)
 	: texture(texture)
 	, size(size)
 	, next(0)
 	, color(255, 255, 255, 255)
 	, colorf(1.0f, 1.0f, 1.0f, 1.0f)
+	, instanced(instanced)
 	, attributesID()
 	, array_buf(nullptr)
 	, vertex_data(nullptr)
@@ -65,8 +67,9 @@ SpriteBatch::SpriteBatch(Graphics *gfx, Texture *texture, int size, BufferDataUs
 		vertex_format = CommonFormat::XYf_STf_RGBAub;
 
 	vertex_stride = getFormatStride(vertex_format);
+	sprite_stride = instanced ? sizeof(SpriteInstance) : vertex_stride * 4;
 
-	size_t vertex_size = vertex_stride * 4 * size;
+	size_t vertex_size = sprite_stride * size;
 
 	vertex_data = (uint8 *) malloc(vertex_size);
 	if (vertex_data == nullptr)
@@ -75,9 +78,7 @@ SpriteBatch::SpriteBatch(Graphics *gfx, Texture *texture, int size, BufferDataUs
 	memset(vertex_data, 0, vertex_size);
 
 	Buffer::Settings settings(BUFFERUSAGEFLAG_VERTEX, usage);
-	auto decl = Buffer::getCommonFormatDeclaration(vertex_format);
-
-	array_buf.set(gfx->newBuffer(settings, decl, nullptr, vertex_size, 0), Acquire::NORETAIN);
+	array_buf.set(newSpriteBuffer(gfx, settings, vertex_size), Acquire::NORETAIN);
 }
 
 SpriteBatch::~SpriteBatch()
@@ -85,6 +86,87 @@ SpriteBatch::~SpriteBatch()
 	free(vertex_data);
 }
 
+std::vector<Buffer::DataDeclaration> SpriteBatch::getInstanceFormatDeclaration()
+{
+	// Must match the layout of SpriteInstance.
+	return {
+		{ "InstanceTransformX", DATAFORMAT_FLOAT_VEC3 },
+		{ "InstanceTransformY", DATAFORMAT_FLOAT_VEC3 },
+		{ "InstanceTexRect", DATAFORMAT_FLOAT_VEC4 },
+		{ "InstanceColor", DATAFORMAT_UNORM8_VEC4 },
+		{ "InstanceLayer", DATAFORMAT_FLOAT },
+	};
+}
+
+Buffer *SpriteBatch::newSpriteBuffer(Graphics *gfx, const Buffer::Settings &settings, size_t datasize) const
+{
+	if (instanced)
+		return gfx->newBuffer(settings, getInstanceFormatDeclaration(), nullptr, datasize, 0);
+	else
+		return gfx->newBuffer(settings, Buffer::getCommonFormatDeclaration(vertex_format), nullptr, datasize, 0);
+}
+
+SpriteBatch::SpriteTransform SpriteBatch::getSpriteTransform(const Matrix4 &m)
+{
+	const float *e = m.getElements();
+	return {e[0], e[4], e[12], e[1], e[5], e[13]};
+}
+
+void SpriteBatch::writeInstance(int spriteindex, Quad *quad, const SpriteTransform &t, int layer, Color32 c)
+{
+	const Vector2 *quadpositions = quad->getVertexPositions();
+	const Vector2 *quadtexcoords = quad->getVertexTexCoords();
+
+	// Quad vertices 0 and 3 are opposite corners, so the quad is fully
+	// described by its origin and extent.
+	Vector2 origin = quadpositions[0];
+	Vector2 extent = quadpositions[3] - quadpositions[0];
+
+	auto inst = (SpriteInstance *) (vertex_data + spriteindex * sprite_stride);
+
+	inst->transformX[0] = t.xx * extent.x;
+	inst->transformX[1] = t.xy * extent.y;
+	inst->transformX[2] = t.xx * origin.x + t.xy * origin.y + t.x0;
+
+	inst->transformY[0] = t.yx * extent.x;
+	inst->transformY[1] = t.yy * extent.y;
+	inst->transformY[2] = t.yx * origin.x + t.yy * origin.y + t.y0;
+
+	inst->texRect[0] = quadtexcoords[0].x;
+	inst->texRect[1] = quadtexcoords[0].y;
+	inst->texRect[2] = quadtexcoords[3].x;
+	inst->texRect[3] = quadtexcoords[3].y;
+
+	inst->color = c;
+	inst->layer = (float) layer;
+}
+
+void SpriteBatch::writeVertices(int spriteindex, Quad *quad, const SpriteTransform &t, int layer, Color32 c)
+{
+	const Vector2 *quadpositions = quad->getVertexPositions();
+	const Vector2 *quadtexcoords = quad->getVertexTexCoords();
+
+	uint8 *data = vertex_data + spriteindex * sprite_stride;
+
+	for (int i = 0; i < 4; i++)
+	{
+		const Vector2 &p = quadpositions[i];
+		float x = t.xx * p.x + t.xy * p.y + t.x0;
+		float y = t.yx * p.x + t.yy * p.y + t.y0;
+
+		if (vertex_format == CommonFormat::XYf_STPf_RGBAub)
+		{
+			auto v = (XYf_STPf_RGBAub *) data + i;
+			*v = {x, y, quadtexcoords[i].x, quadtexcoords[i].y, (float) layer, c};
+		}
+		else
+		{
+			auto v = (XYf_STf_RGBAub *) data + i;
+			*v = {x, y, quadtexcoords[i].x, quadtexcoords[i].y, c};
+		}
+	}
+}
+
 int SpriteBatch::add(const Matrix4 &m, int index /*= -1*/)
 {
 	return add(texture->getQuad(), m, index);
@@ -106,16 +188,21 @@ int SpriteBatch::add(Quad *quad, const Matrix4 &m, int index /*= -1*/)
 
 	int spriteindex = (index == -1 ? next : index);
 
-	size_t offset = spriteindex * vertex_stride * 4;
-	auto verts = (XYf_STf_RGBAub *) (vertex_data + offset);
+	if (instanced)
+		writeInstance(spriteindex, quad, getSpriteTransform(m), 0, color);
+	else
+	{
+		size_t offset = spriteindex * sprite_stride;
+		auto verts = (XYf_STf_RGBAub *) (vertex_data + offset);
 
-	m.transformXY(verts, quadpositions, 4);
+		m.transformXY(verts, quadpositions, 4);
 
-	for (int i = 0; i < 4; i++)
-	{
-		verts[i].s = quadtexcoords[i].x;
-		verts[i].t = quadtexcoords[i].y;
-		verts[i].color = color;
+		for (int i = 0; i < 4; i++)
+		{
+			verts[i].s = quadtexcoords[i].x;
+			verts[i].t = quadtexcoords[i].y;
+			verts[i].color = color;
+		}
 	}
 
 	modified_sprites.encapsulate(spriteindex);
@@ -151,17 +238,22 @@ int SpriteBatch::addLayer(int layer, Quad *quad, const Matrix4 &m, int index)
 
 	int spriteindex = (index == -1 ? next : index);
 
-	size_t offset = spriteindex * vertex_stride * 4;
-	auto verts = (XYf_STPf_RGBAub *) (vertex_data + offset);
+	if (instanced)
+		writeInstance(spriteindex, quad, getSpriteTransform(m), layer, color);
+	else
+	{
+		size_t offset = spriteindex * sprite_stride;
+		auto verts = (XYf_STPf_RGBAub *) (vertex_data + offset);
 
-	m.transformXY(verts, quadpositions, 4);
+		m.transformXY(verts, quadpositions, 4);
 
-	for (int i = 0; i < 4; i++)
-	{
-		verts[i].s = quadtexcoords[i].x;
-		verts[i].t = quadtexcoords[i].y;
-		verts[i].p = (float) layer;
-		verts[i].color = color;
+		for (int i = 0; i < 4; i++)
+		{
+			verts[i].s = quadtexcoords[i].x;
+			verts[i].t = quadtexcoords[i].y;
+			verts[i].p = (float) layer;
+			verts[i].color = color;
+		}
 	}
 
 	modified_sprites.encapsulate(spriteindex);
@@ -173,6 +265,134 @@ int SpriteBatch::addLayer(int layer, Quad *quad, const Matrix4 &m, int index)
 	return index;
 }
 
+void SpriteBatch::setSprites(int start, int count, const void *data, size_t datasize, const std::vector<SpriteDataField> &format, const std::vector<Quad *> &quads)
+{
+	size_t stride = getSpriteDataStride(format);
+
+	if (stride == 0)
+		throw love::Exception("Sprite data format must have at least one field.");
+
+	if (start < 0 || start > next)
+		throw love::Exception("Invalid sprite index: %d", start + 1);
+
+	if (count < 0 || datasize / stride < (size_t) count)
+		throw love::Exception("Sprite data is too small to hold %d sprites.", count);
+
+	// Byte offsets of each field within a record, or -1 if it's missing.
+	int offsets[SPRITEDATA_MAX_ENUM];
+	for (int i = 0; i < SPRITEDATA_MAX_ENUM; i++)
+		offsets[i] = -1;
+
+	for (size_t i = 0; i < format.size(); i++)
+	{
+		if (offsets[format[i]] >= 0)
+		{
+			const char *name = nullptr;
+			getConstant(format[i], name);
+			throw love::Exception("Duplicate '%s' field in sprite data format.", name);
+		}
+		offsets[format[i]] = (int) (i * 4);
+	}
+
+	bool arraytexture = vertex_format == CommonFormat::XYf_STPf_RGBAub;
+
+	if (offsets[SPRITEDATA_QUAD] >= 0 && quads.empty())
+		throw love::Exception("A list of Quads is required when the sprite data has a quad field.");
+
+	if (offsets[SPRITEDATA_LAYER] >= 0 && !arraytexture)
+		throw love::Exception("The layer field can only be used with a SpriteBatch that uses an Array Texture.");
+
+	int quadfield = offsets[SPRITEDATA_QUAD];
+	int layerfield = offsets[SPRITEDATA_LAYER];
+	int colorfield = offsets[SPRITEDATA_COLOR];
+
+	auto field = [&](const uint8 *record, SpriteDataField f, float def) -> float
+	{
+		if (offsets[f] < 0)
+			return def;
+
+		float v;
+		memcpy(&v, record + offsets[f], sizeof(float));
+		return v;
+	};
+
+	// Check the indices before anything is written, so invalid data can't
+	// leave the batch partially updated. The checks are done on the floats
+	// so NaN and huge values are caught before they're converted to ints.
+	if (quadfield >= 0 || layerfield >= 0)
+	{
+		float quadcount = (float) quads.size();
+		float layercount = arraytexture ? (float) texture->getLayerCount() : 0.0f;
+		const uint8 *record = (const uint8 *) data;
+
+		for (int i = 0; i < count; i++, record += stride)
+		{
+			float quadindex = field(record, SPRITEDATA_QUAD, 1.0f);
+			if (quadfield >= 0 && !(quadindex >= 1.0f && quadindex < quadcount + 1.0f))
+				throw love::Exception("Invalid quad index %g in sprite data (sprite %d).", quadindex, start + i + 1);
+
+			float layer = field(record, SPRITEDATA_LAYER, 1.0f);
+			if (layerfield >= 0 && !(layer >= 1.0f && layer < layercount + 1.0f))
+				throw love::Exception("Invalid layer %g in sprite data (sprite %d, Texture has %d layers).", layer, start + i + 1, (int) layercount);
+		}
+	}
+
+	if (start + count > size)
+		setBufferSize(std::max(start + count, size * 2));
+
+	Quad *defaultquad = texture->getQuad();
+	Color32 spritecolor = color;
+	const uint8 *record = (const uint8 *) data;
+
+	for (int i = 0; i < count; i++, record += stride)
+	{
+		float x = field(record, SPRITEDATA_X, 0.0f);
+		float y = field(record, SPRITEDATA_Y, 0.0f);
+		float angle = field(record, SPRITEDATA_ANGLE, 0.0f);
+		float sx = field(record, SPRITEDATA_SCALE_X, 1.0f);
+		float sy = field(record, SPRITEDATA_SCALE_Y, sx);
+		float ox = field(record, SPRITEDATA_ORIGIN_X, 0.0f);
+		float oy = field(record, SPRITEDATA_ORIGIN_Y, 0.0f);
+		float kx = field(record, SPRITEDATA_SHEAR_X, 0.0f);
+		float ky = field(record, SPRITEDATA_SHEAR_Y, 0.0f);
+
+		// Same as Matrix4::setTransformation.
+		float c = cosf(angle);
+		float s = sinf(angle);
+
+		SpriteTransform t;
+		t.xx = c * sx - ky * s * sy;
+		t.yx = s * sx + ky * c * sy;
+		t.xy = kx * c * sx - s * sy;
+		t.yy = kx * s * sx + c * sy;
+		t.x0 = x - ox * t.xx - oy * t.xy;
+		t.y0 = y - ox * t.yx - oy * t.yy;
+
+		Quad *quad = defaultquad;
+		if (quadfield >= 0)
+			quad = quads[(int) field(record, SPRITEDATA_QUAD, 1.0f) - 1];
+
+		int layer = 0;
+		if (layerfield >= 0)
+			layer = (int) field(record, SPRITEDATA_LAYER, 1.0f) - 1;
+		else if (arraytexture)
+			layer = quad->getLayer();
+
+		if (colorfield >= 0)
+			memcpy(&spritecolor, record + colorfield, sizeof(Color32));
+
+		if (instanced)
+			writeInstance(start + i, quad, t, layer, spritecolor);
+		else
+			writeVertices(start + i, quad, t, layer, spritecolor);
+	}
+
+	if (count > 0)
+		modified_sprites.encapsulate(start, count);
+
+	next = std::max(next, start + count);
+}
+
 void SpriteBatch::clear()
 {
 	// Reset the position of the next index.
@@ -183,8 +403,8 @@ void SpriteBatch::flush()
 {
 	if (modified_sprites.isValid())
 	{
-		size_t offset = modified_sprites.getOffset() * vertex_stride * 4;
-		size_t size = modified_sprites.getSize() * vertex_stride * 4;
+		size_t offset = modified_sprites.getOffset() * sprite_stride;
+		size_t size = modified_sprites.getSize() * sprite_stride;
 
 		if (array_buf->getDataUsage() == BUFFERDATAUSAGE_STREAM)
 			array_buf->fill(0, array_buf->getSize(), vertex_data);
@@ -236,7 +456,7 @@ void SpriteBatch::setBufferSize(int newsize)
 	if (newsize == size)
 		return;
 
-	size_t vertex_size = vertex_stride * 4 * newsize;
+	size_t vertex_size = sprite_stride * newsize;
 
 	int new_next = std::min(next, newsize);
 
@@ -246,11 +466,10 @@ void SpriteBatch::setBufferSize(int newsize)
 
 	auto gfx = Module::getInstance<graphics::Graphics>(Module::M_GRAPHICS);
 	Buffer::Settings settings(array_buf->getUsageFlags(), array_buf->getDataUsage());
-	auto decl = Buffer::getCommonFormatDeclaration(vertex_format);
 
-	array_buf.set(gfx->newBuffer(settings, decl, nullptr, vertex_size, 0), Acquire::NORETAIN);
+	array_buf.set(newSpriteBuffer(gfx, settings, vertex_size), Acquire::NORETAIN);
 
-	array_buf->fill(0, vertex_stride * 4 * new_next, new_vertex_data);
+	array_buf->fill(0, sprite_stride * new_next, new_vertex_data);
 
 	vertex_data = (uint8 *) new_vertex_data;
 
@@ -265,6 +484,11 @@ int SpriteBatch::getBufferSize() const
 	return size;
 }
 
+bool SpriteBatch::isInstanced() const
+{
+	return instanced;
+}
+
 void SpriteBatch::attachAttribute(const std::string &name, Buffer *buffer, Mesh *mesh)
 {
 	if ((buffer->getUsageFlags() & BUFFERUSAGEFLAG_VERTEX) == 0)
@@ -273,8 +497,11 @@ void SpriteBatch::attachAttribute(const std::string &name, Buffer *buffer, Mesh
 	AttachedAttribute oldattrib = {};
 	AttachedAttribute newattrib = {};
 
-	if (buffer->getArrayLength() < (size_t) next * 4)
-		throw love::Exception("Buffer has too few vertices to be attached to this SpriteBatch (at least %d vertices are required)", next*4);
+	// Attributes of instanced SpriteBatches have one element per sprite.
+	int verticespersprite = instanced ? 1 : 4;
+
+	if (buffer->getArrayLength() < (size_t) next * verticespersprite)
+		throw love::Exception("Buffer has too few vertices to be attached to this SpriteBatch (at least %d vertices are required)", next * verticespersprite);
 
 	auto it = attached_attributes.find(name);
 	if (it != attached_attributes.end())
@@ -290,7 +517,7 @@ void SpriteBatch::attachAttribute(const std::string &name, Buffer *buffer, Mesh
 	newattrib.bindingIndex = buffer->getDataMember(newattrib.index).decl.bindingLocation;
 
 	BuiltinVertexAttribute builtinattrib;
-	if (newattrib.bindingIndex < 0 && getConstant(name.c_str(), builtinattrib))
+	if (newattrib.bindingIndex < 0 && graphics::getConstant(name.c_str(), builtinattrib))
 		newattrib.bindingIndex = (int)builtinattrib;
 
 	attached_attributes[name] = newattrib;
@@ -328,7 +555,26 @@ void SpriteBatch::updateVertexAttributes(Graphics *gfx)
 	BufferBindings &buffers = bufferBindings;
 
 	buffers.set(0, array_buf, 0);
-	attributes.setCommonFormat(vertex_format, 0);
+
+	AttributeStep step = STEP_PER_VERTEX;
+
+	if (instanced)
+	{
+		// The instance attributes aren't built-in, so their locations come
+		// from the active shader. Shaders which don't use them are skipped.
+		step = STEP_PER_INSTANCE;
+		attributes.setBufferLayout(0, (uint16) sprite_stride, step);
+
+		for (int i = 0; i < (int) array_buf->getDataMembers().size(); i++)
+		{
+			const auto &member = array_buf->getDataMember(i);
+			int bindingindex = Shader::current ? Shader::current->getVertexAttributeIndex(member.decl.name) : -1;
+			if (bindingindex >= 0)
+				attributes.set(bindingindex, member.decl.format, (uint16) member.offset, 0);
+		}
+	}
+	else
+		attributes.setCommonFormat(vertex_format, 0);
 
 	int activebuffers = 1;
 
@@ -354,7 +600,7 @@ void SpriteBatch::updateVertexAttributes(Graphics *gfx)
 
 			for (int i = 1; i < activebuffers; i++)
 			{
-				if (buffers.info[i].buffer == buffer && attributes.bufferLayouts[i].stride == stride)
+				if (buffers.info[i].buffer == buffer && attributes.bufferLayouts[i].stride == stride && attributes.getBufferStep(i) == step)
 				{
 					bufferindex = i;
 					break;
@@ -362,7 +608,7 @@ void SpriteBatch::updateVertexAttributes(Graphics *gfx)
 			}
 
 			attributes.set(bindingindex, member.decl.format, offset, bufferindex);
-			attributes.setBufferLayout(bufferindex, stride);
+			attributes.setBufferLayout(bufferindex, stride, step);
 
 			buffers.set(bufferindex, buffer, 0);
 
@@ -385,7 +631,11 @@ void SpriteBatch::draw(Graphics *gfx, const Matrix4 &m)
 		if (Shader::isDefaultActive())
 		{
 			Shader::StandardShader defaultshader = Shader::STANDARD_DEFAULT;
-			if (texture->getTextureType() == TEXTURE_2D_ARRAY)
+			if (instanced && texture->getTextureType() == TEXTURE_2D_ARRAY)
+				defaultshader = Shader::STANDARD_SPRITE_INSTANCED_ARRAY;
+			else if (instanced)
+				defaultshader = Shader::STANDARD_SPRITE_INSTANCED;
+			else if (texture->getTextureType() == TEXTURE_2D_ARRAY)
 				defaultshader = Shader::STANDARD_ARRAY;
 
 			Shader::attachDefault(defaultshader);
@@ -397,7 +647,10 @@ void SpriteBatch::draw(Graphics *gfx, const Matrix4 &m)
 
 	flush(); // Upload any modified sprite data to the GPU.
 
-	bool attributesIDneedsupdate = !attributesID.isValid();
+	// Instance attribute locations depend on the active shader, so the
+	// attributes are rebuilt when it changes.
+	bool usesshaderlocations = instanced;
+	int verticespersprite = instanced ? 1 : 4;
 
 	for (const auto &it : attached_attributes)
 	{
@@ -405,20 +658,24 @@ void SpriteBatch::draw(Graphics *gfx, const Matrix4 &m)
 
 		// We have to do this check here as wll because setBufferSize can be
 		// called after attachAttribute.
-		if (buffer->getArrayLength() < (size_t) next * 4)
+		if (buffer->getArrayLength() < (size_t) next * verticespersprite)
 			throw love::Exception("Buffer with attribute '%s' attached to this SpriteBatch has too few vertices", it.first.c_str());
 
 		// If the attribute is one of the LOVE-defined ones, use the constant
 		// attribute index for it, otherwise query the index from the shader.
 		if (it.second.bindingIndex < 0)
-			attributesIDneedsupdate = true;
+			usesshaderlocations = true;
 
 		if (it.second.mesh.get())
 			it.second.mesh->flush();
 	}
 
-	if (attributesIDneedsupdate)
+	// attributesID is invalidated when attached attributes or buffers change.
+	if (!attributesID.isValid() || (usesshaderlocations && attributesShader.get() != Shader::current))
+	{
 		updateVertexAttributes(gfx);
+		attributesShader.set(usesshaderlocations ? Shader::current : nullptr);
+	}
 
 	Graphics::TempTransform transform(gfx, m);
 
@@ -430,12 +687,51 @@ void SpriteBatch::draw(Graphics *gfx, const Matrix4 &m)
 
 	count = std::min(count, next - start);
 
-	if (count > 0)
+	if (count > 0 && instanced)
+	{
+		// Every binding steps per instance, so the draw range is applied by
+		// offsetting the bindings rather than through a base instance.
+		BufferBindings buffers = bufferBindings;
+		for (uint32 i = 0; i < BufferBindings::MAX; i++)
+		{
+			if ((buffers.useBits & (1u << i)) == 0)
+				continue;
+
+			size_t stride = i == 0 ? sprite_stride : ((Buffer *) buffers.info[i].buffer)->getArrayStride();
+			buffers.info[i].offset += stride * start;
+		}
+
+		Graphics::DrawIndexedCommand cmd(attributesID, &buffers, gfx->getQuadIndexBuffer());
+		cmd.indexCount = 6;
+		cmd.instanceCount = count;
+		cmd.indexType = INDEX_UINT16;
+		cmd.texture = gfx->getTextureOrDefaultForActiveShader(texture);
+
+		gfx->draw(cmd);
+	}
+	else if (count > 0)
 	{
 		Texture *tex = gfx->getTextureOrDefaultForActiveShader(texture);
 		gfx->drawQuads(start, count, attributesID, bufferBindings, tex);
 	}
 }
 
+STRINGMAP_CLASS_BEGIN(SpriteBatch, SpriteBatch::SpriteDataField, SpriteBatch::SPRITEDATA_MAX_ENUM, spriteDataField)
+{
+	{ "x",     SpriteBatch::SPRITEDATA_X        },
+	{ "y",     SpriteBatch::SPRITEDATA_Y        },
+	{ "angle", SpriteBatch::SPRITEDATA_ANGLE    },
+	{ "sx",    SpriteBatch::SPRITEDATA_SCALE_X  },
+	{ "sy",    SpriteBatch::SPRITEDATA_SCALE_Y  },
+	{ "ox",    SpriteBatch::SPRITEDATA_ORIGIN_X },
+	{ "oy",    SpriteBatch::SPRITEDATA_ORIGIN_Y },
+	{ "kx",    SpriteBatch::SPRITEDATA_SHEAR_X  },
+	{ "ky",    SpriteBatch::SPRITEDATA_SHEAR_Y  },
+	{ "quad",  SpriteBatch::SPRITEDATA_QUAD     },
+	{ "layer", SpriteBatch::SPRITEDATA_LAYER    },
+	{ "color", SpriteBatch::SPRITEDATA_COLOR    },
+}
+STRINGMAP_CLASS_END(SpriteBatch, SpriteBatch::SpriteDataField, SpriteBatch::SPRITEDATA_MAX_ENUM, spriteDataField)
+
 } // graphics
 } // love
@@ -25,14 +25,17 @@
 
 // C++
 #include <unordered_map>
+#include <vector>
 
 // LOVE
 #include "common/math.h"
 #include "common/Matrix.h"
 #include "common/Color.h"
 #include "common/Range.h"
+#include "common/StringMap.h"
 #include "Drawable.h"
 #include "Mesh.h"
+#include "Buffer.h"
 #include "vertex.h"
 
 namespace love
@@ -43,6 +46,7 @@ namespace graphics
 // Forward declarations.
 class Graphics;
 class Texture;
+class Shader;
 class Quad;
 class Buffer;
 
@@ -52,7 +56,28 @@ class SpriteBatch : public Drawable
 
 	static love::Type type;
 
-	SpriteBatch(Graphics *gfx, Texture *texture, int size, BufferDataUsage usage);
+	/**
+	 * Fields of the packed per-sprite records used by setSprites. Every field
+	 * is a 32 bit float, except color which is 4 normalized 8 bit components.
+	 **/
+	enum SpriteDataField
+	{
+		SPRITEDATA_X,
+		SPRITEDATA_Y,
+		SPRITEDATA_ANGLE,
+		SPRITEDATA_SCALE_X,
+		SPRITEDATA_SCALE_Y,
+		SPRITEDATA_ORIGIN_X,
+		SPRITEDATA_ORIGIN_Y,
+		SPRITEDATA_SHEAR_X,
+		SPRITEDATA_SHEAR_Y,
+		SPRITEDATA_QUAD,
+		SPRITEDATA_LAYER,
+		SPRITEDATA_COLOR,
+		SPRITEDATA_MAX_ENUM
+	};
+
+	SpriteBatch(Graphics *gfx, Texture *texture, int size, BufferDataUsage usage, bool instanced = false);
 	virtual ~SpriteBatch();
 
 	int add(const Matrix4 &m, int index = -1);
@@ -60,6 +85,17 @@ class SpriteBatch : public Drawable
 	int addLayer(int layer, const Matrix4 &m, int index = -1);
 	int addLayer(int layer, Quad *quad, const Matrix4 &m, int index = -1);
 
+	/**
+	 * Sets count sprites starting at index start from tightly packed records
+	 * with the given fields, growing the batch when needed. start must not
+	 * leave a gap after the last sprite. Quad and layer fields hold 1-based
+	 * indices into quads and the texture's layers. Fields which aren't in
+	 * the format use the same defaults as add, and the current color.
+	 **/
+	void setSprites(int start, int count, const void *data, size_t datasize, const std::vector<SpriteDataField> &format, const std::vector<Quad *> &quads);
+
+	static size_t getSpriteDataStride(const std::vector<SpriteDataField> &format) { return format.size() * 4; }
+
 	void clear();
 
 	void flush();
@@ -90,6 +126,12 @@ class SpriteBatch : public Drawable
 	 **/
 	int getBufferSize() const;
 
+	/**
+	 * Whether this SpriteBatch stores one compact record per sprite which is
+	 * expanded into a quad by the vertex shader, instead of 4 vertices.
+	 **/
+	bool isInstanced() const;
+
 	/**
 	 * Attaches a specific vertex attribute from a Buffer to this SpriteBatch.
 	 * The vertex attribute will be used when drawing the SpriteBatch.
@@ -106,9 +148,36 @@ class SpriteBatch : public Drawable
 	// Implements Drawable.
 	void draw(Graphics *gfx, const Matrix4 &m) override;
 
+	STRINGMAP_CLASS_DECLARE(SpriteDataField);
+
 private:
 
+	// Per-sprite data used by instanced SpriteBatches. The first two members
+	// are the rows of the 2x3 affine transform from the unit quad to local
+	// space.
+	struct SpriteInstance
+	{
+		float transformX[3];
+		float transformY[3];
+		float texRect[4];
+		Color32 color;
+		float layer;
+	};
+
+	// 2D affine transform of a sprite, as the rows of a 2x3 matrix.
+	struct SpriteTransform
+	{
+		float xx, xy, x0;
+		float yx, yy, y0;
+	};
+
+	static std::vector<Buffer::DataDeclaration> getInstanceFormatDeclaration();
+	static SpriteTransform getSpriteTransform(const Matrix4 &m);
+
+	void writeInstance(int spriteindex, Quad *quad, const SpriteTransform &t, int layer, Color32 c);
+	void writeVertices(int spriteindex, Quad *quad, const SpriteTransform &t, int layer, Color32 c);
 	void updateVertexAttributes(Graphics *gfx);
+	Buffer *newSpriteBuffer(Graphics *gfx, const Buffer::Settings &settings, size_t datasize) const;
 
 	struct AttachedAttribute
 	{
@@ -139,9 +208,18 @@ class SpriteBatch : public Drawable
 	CommonFormat vertex_format;
 	size_t vertex_stride;
 
+	bool instanced;
+
+	// Bytes of sprite data per sprite: 4 vertices, or one SpriteInstance.
+	size_t sprite_stride;
+
 	VertexAttributesID attributesID;
 	BufferBindings bufferBindings;
 
+	// The shader whose attribute locations attributesID was built with, when
+	// those locations come from the shader rather than being built-in.
+	StrongRef<Shader> attributesShader;
+
 	StrongRef<love::graphics::Buffer> array_buf;
 	uint8 *vertex_data;
 
@@ -118,11 +118,14 @@ void TextBatch::addTextData(const TextData &t)
 
 	Colorf constantcolor = Colorf(1.0f, 1.0f, 1.0f, 1.0f);
 
+	if (!t.appendVertices)
+		glyphUsage = Font::GlyphUsage();
+
 	// We only have formatted text if the align mode is valid.
 	if (t.align == Font::ALIGN_MAX_ENUM)
-		newcommands = font->generateVertices(t.codepoints, Range(), constantcolor, vertices, 0.0f, Vector2(0.0f, 0.0f), &textinfo);
+		newcommands = font->generateVertices(t.codepoints, Range(), constantcolor, vertices, 0.0f, Vector2(0.0f, 0.0f), &textinfo, &glyphUsage);
 	else
-		newcommands = font->generateVerticesFormatted(t.codepoints, constantcolor, t.wrap, t.align, vertices, &textinfo);
+		newcommands = font->generateVerticesFormatted(t.codepoints, constantcolor, t.wrap, t.align, vertices, &textinfo, &glyphUsage);
 
 	size_t voffset = vertOffset;
 
@@ -209,6 +212,7 @@ void TextBatch::clear()
 {
 	textData.clear();
 	drawCommands.clear();
+	glyphUsage = Font::GlyphUsage();
 	textureCacheID = font->getTextureCacheID();
 	vertOffset = 0;
 }
@@ -262,8 +266,11 @@ void TextBatch::draw(Graphics *gfx, const Matrix4 &m)
 	if (font->getTextureCacheID() != textureCacheID)
 		regenerateVertices();
 
+	// Keep the glyphs from being evicted while they're on screen.
+	font->markGlyphsUsed(glyphUsage);
+
 	if (Shader::isDefaultActive())
-		Shader::attachDefault(Shader::STANDARD_DEFAULT);
+		Shader::attachDefault(font->isSDF() ? Shader::STANDARD_SDF_TEXT : Shader::STANDARD_DEFAULT);
 
 	Texture *firsttex = nullptr;
 	if (!drawCommands.empty())
@@ -97,6 +97,9 @@ class TextBatch : public Drawable
 
 	std::vector<TextData> textData;
 
+	// Glyphs of the text, which are marked as used whenever it's drawn.
+	Font::GlyphUsage glyphUsage;
+
 	size_t vertOffset;
 	
 	// Used so we know when the font's texture cache is invalidated.
@@ -1796,6 +1796,8 @@ void Graphics::present(void *screenshotCallbackData)
 	shaderSwitches = 0;
 	renderTargetSwitchCount = 0;
 	drawCallsBatched = 0;
+	Font::textLayoutCacheHits = 0;
+	Font::textLayoutCacheMisses = 0;
 
 	updatePendingReadbacks();
 	updateTemporaryResources();
@@ -1342,6 +1342,8 @@ void Graphics::present(void *screenshotCallbackData)
 	gl.stats.shaderSwitches = 0;
 	renderTargetSwitchCount = 0;
 	drawCallsBatched = 0;
+	Font::textLayoutCacheHits = 0;
+	Font::textLayoutCacheMisses = 0;
 
 	updatePendingReadbacks();
 	updateTemporaryResources();
@@ -658,6 +658,8 @@ void Graphics::present(void *screenshotCallbackdata)
 	drawCalls = 0;
 	renderTargetSwitchCount = 0;
 	drawCallsBatched = 0;
+	Font::textLayoutCacheHits = 0;
+	Font::textLayoutCacheMisses = 0;
 
 	updatePendingReadbacks();
 	updateTemporaryResources();
@@ -21,6 +21,7 @@
 // LOVE
 #include "common/config.h"
 #include "wrap_Font.h"
+#include "data/ByteData.h"
 
 // C++
 #include <algorithm>
@@ -268,6 +269,73 @@ int w_Font_getDPIScale(lua_State *L)
 	return 1;
 }
 
+int w_Font_isSDF(lua_State *L)
+{
+	Font *t = luax_checkfont(L, 1);
+	luax_pushboolean(L, t->isSDF());
+	return 1;
+}
+
+int w_Font_prewarm(lua_State *L)
+{
+	Font *t = luax_checkfont(L, 1);
+	const char *text = luaL_checkstring(L, 2);
+	luax_catchexcept(L, [&](){ t->prewarm(text); });
+	return 0;
+}
+
+int w_Font_saveAtlas(lua_State *L)
+{
+	Font *t = luax_checkfont(L, 1);
+	love::data::ByteData *data = nullptr;
+	luax_catchexcept(L, [&](){ data = t->saveAtlas(); });
+	luax_pushtype(L, data);
+	data->release();
+	return 1;
+}
+
+int w_Font_loadAtlas(lua_State *L)
+{
+	Font *t = luax_checkfont(L, 1);
+	love::Data *data = luax_checktype<love::Data>(L, 2);
+	luax_catchexcept(L, [&](){ t->loadAtlas(data); });
+	return 0;
+}
+
+int w_Font_getAtlasStats(lua_State *L)
+{
+	Font *t = luax_checkfont(L, 1);
+	Font::AtlasStats stats = t->getAtlasStats();
+
+	lua_createtable(L, 0, 5);
+
+	lua_pushinteger(L, stats.textureCount);
+	lua_setfield(L, -2, "textures");
+
+	lua_pushinteger(L, stats.textureWidth);
+	lua_setfield(L, -2, "width");
+
+	lua_pushinteger(L, stats.textureHeight);
+	lua_setfield(L, -2, "height");
+
+	lua_pushinteger(L, stats.glyphCount);
+	lua_setfield(L, -2, "glyphs");
+
+	lua_pushnumber(L, stats.occupancy);
+	lua_setfield(L, -2, "occupancy");
+
+	return 1;
+}
+
+int w_Font_evictUnusedGlyphs(lua_State *L)
+{
+	Font *t = luax_checkfont(L, 1);
+	int evicted = 0;
+	luax_catchexcept(L, [&](){ evicted = t->evictUnusedGlyphs(); });
+	lua_pushinteger(L, evicted);
+	return 1;
+}
+
 static const luaL_Reg w_Font_functions[] =
 {
 	{ "getHeight", w_Font_getHeight },
@@ -284,6 +352,12 @@ static const luaL_Reg w_Font_functions[] =
 	{ "getKerning", w_Font_getKerning },
 	{ "setFallbacks", w_Font_setFallbacks },
 	{ "getDPIScale", w_Font_getDPIScale },
+	{ "isSDF", w_Font_isSDF },
+	{ "prewarm", w_Font_prewarm },
+	{ "saveAtlas", w_Font_saveAtlas },
+	{ "loadAtlas", w_Font_loadAtlas },
+	{ "getAtlasStats", w_Font_getAtlasStats },
+	{ "evictUnusedGlyphs", w_Font_evictUnusedGlyphs },
 	{ 0, 0 }
 };
 
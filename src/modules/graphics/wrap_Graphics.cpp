@@ -460,33 +460,33 @@ static void screenshotFunctionCallback(const Graphics::ScreenshotInfo *info, lov
 		delete ref;
 }
 
-struct ScreenshotFileInfo
-{
-	std::string filename;
-	image::FormatHandler::EncodedFormat format;
-};
-
 static void screenshotFileCallback(const Graphics::ScreenshotInfo *info, love::image::ImageData *i, void * /*gd*/)
 {
 	if (info == nullptr)
 		return;
 
-	ScreenshotFileInfo *fileinfo = (ScreenshotFileInfo *) info->data;
+	auto *job = (love::image::EncodeJob *) info->data;
 
-	if (i != nullptr && fileinfo != nullptr)
+	if (job != nullptr)
 	{
-		try
-		{
-			i->encode(fileinfo->format, fileinfo->filename.c_str(), true);
-		}
-		catch (love::Exception &e)
+		if (i != nullptr)
 		{
-			printf("Screenshot encoding or saving failed: %s", e.what());
-			// Do nothing...
+			try
+			{
+				// Encoding and writing happen on a background thread, so the
+				// frame isn't held up by large screenshots.
+				job->start(i);
+			}
+			catch (love::Exception &e)
+			{
+				job->fail(e.what());
+			}
 		}
-	}
+		else
+			job->fail("The screenshot could not be captured.");
 
-	delete fileinfo;
+		job->release();
+	}
 }
 
 static void screenshotChannelCallback(const Graphics::ScreenshotInfo *info, love::image::ImageData *i, void * /*gd*/)
@@ -508,6 +508,7 @@ static void screenshotChannelCallback(const Graphics::ScreenshotInfo *info, love
 int w_captureScreenshot(lua_State *L)
 {
 	Graphics::ScreenshotInfo info;
+	StrongRef<love::image::EncodeJob> filejob;
 
 	if (lua_isfunction(L, 1))
 	{
@@ -532,11 +533,12 @@ int w_captureScreenshot(lua_State *L)
 		if (!image::ImageData::getConstant(ext.c_str(), format))
 			return luax_enumerror(L, "encoded image format", image::ImageData::getConstants(format), ext.c_str());
 
-		ScreenshotFileInfo *fileinfo = new ScreenshotFileInfo;
-		fileinfo->filename = filename;
-		fileinfo->format = format;
+		// The job is returned to Lua, and started once the screenshot has
+		// been captured.
+		filejob.set(new love::image::EncodeJob(format, {}, filename, true), Acquire::NORETAIN);
+		filejob->retain();
 
-		info.data = fileinfo;
+		info.data = filejob.get();
 		info.callback = screenshotFileCallback;
 	}
 	else if (luax_istype(L, 1, love::thread::Channel::type))
@@ -554,6 +556,12 @@ int w_captureScreenshot(lua_State *L)
 		[&](bool except) { if (except) info.callback(&info, nullptr, nullptr); }
 	);
 
+	if (filejob.get() != nullptr)
+	{
+		luax_pushtype(L, filejob.get());
+		return 1;
+	}
+
 	return 0;
 }
 
@@ -1442,16 +1450,18 @@ int w_newSpriteBatch(lua_State *L)
 	Texture *texture = luax_checktexture(L, 1);
 	int size = (int) luaL_optinteger(L, 2, 1000);
 	BufferDataUsage usage = BUFFERDATAUSAGE_DYNAMIC;
-	if (lua_gettop(L) > 2)
+	if (!lua_isnoneornil(L, 3))
 	{
 		const char *usagestr = luaL_checkstring(L, 3);
 		if (!getConstant(usagestr, usage))
 			return luax_enumerror(L, "usage hint", getConstants(usage), usagestr);
 	}
 
+	bool instanced = luax_optboolean(L, 4, false);
+
 	SpriteBatch *t = nullptr;
 	luax_catchexcept(L,
-		[&](){ t = instance()->newSpriteBatch(texture, size, usage); }
+		[&](){ t = instance()->newSpriteBatch(texture, size, usage, instanced); }
 	);
 
 	luax_pushtype(L, t);
@@ -3230,6 +3240,12 @@ int w_getStats(lua_State *L)
 	lua_pushinteger(L, stats.fonts);
 	lua_setfield(L, -2, "fonts");
 
+	lua_pushinteger(L, stats.textLayoutCacheHits);
+	lua_setfield(L, -2, "textlayoutcachehits");
+
+	lua_pushinteger(L, stats.textLayoutCacheMisses);
+	lua_setfield(L, -2, "textlayoutcachemisses");
+
 	lua_pushinteger(L, stats.buffers);
 	lua_setfield(L, -2, "buffers");
 
@@ -3487,12 +3503,49 @@ int w_printf(lua_State *L)
 	return 0;
 }
 
+/**
+ * Gets vertices stored as packed 32-bit float x, y pairs in a Data object,
+ * followed by an optional 1-based start vertex and vertex count. The returned
+ * pointer refers to the Data's memory directly.
+ * GPU Buffers aren't accepted here (or by Mesh:setVertices): these shapes are
+ * built on the CPU, so reading a Buffer would need a stalling readback. Draw a
+ * Mesh that uses the Buffer as a vertex attribute source instead.
+ **/
+static_assert(sizeof(Vector2) == sizeof(float) * 2, "Vertex Data must be readable as packed float pairs.");
+
+static const Vector2 *luax_checkvertexdata(lua_State *L, int idx, int &count)
+{
+	Data *data = luax_checktype<Data>(L, idx);
+
+	int maxcount = (int) (data->getSize() / sizeof(Vector2));
+	int start = (int) luaL_optinteger(L, idx + 1, 1) - 1;
+
+	if (start < 0 || start >= maxcount)
+		luaL_error(L, "Invalid vertex start index (must be between 1 and %d)", maxcount);
+
+	count = (int) luaL_optinteger(L, idx + 2, maxcount - start);
+
+	if (count < 0 || count > maxcount - start)
+		luaL_error(L, "Too many vertices (expected at most %d, got %d)", maxcount - start, count);
+
+	return (const Vector2 *) data->getData() + start;
+}
+
 int w_points(lua_State *L)
 {
-	// love.graphics.points has 3 variants:
+	// love.graphics.points has 4 variants:
 	// - points(x1, y1, x2, y2, ...)
 	// - points({x1, y1, x2, y2, ...})
 	// - points({{x1, y1 [, r, g, b, a]}, {x2, y2 [, r, g, b, a]}, ...})
+	// - points(data [, startvertex, count])
+
+	if (luax_istype(L, 1, Data::type))
+	{
+		int count = 0;
+		const Vector2 *positions = luax_checkvertexdata(L, 1, count);
+		luax_catchexcept(L, [&](){ instance()->points(positions, nullptr, count); });
+		return 0;
+	}
 
 	int args = lua_gettop(L);
 	bool is_table = false;
@@ -3578,6 +3631,17 @@ int w_points(lua_State *L)
 
 int w_line(lua_State *L)
 {
+	if (luax_istype(L, 1, Data::type))
+	{
+		int count = 0;
+		const Vector2 *coords = luax_checkvertexdata(L, 1, count);
+		if (count < 2)
+			return luaL_error(L, "Need at least two vertices to draw a line.");
+
+		luax_catchexcept(L, [&](){ instance()->polyline(coords, count); });
+		return 0;
+	}
+
 	int args = lua_gettop(L);
 	int arg1type = lua_type(L, 1);
 	bool is_table = false;
@@ -3748,6 +3812,29 @@ int w_polygon(lua_State *L)
 	if (!Graphics::getConstant(str, mode))
 		return luax_enumerror(L, "draw mode", Graphics::getConstants(mode), str);
 
+	if (luax_istype(L, 2, Data::type))
+	{
+		int count = 0;
+		const Vector2 *data = luax_checkvertexdata(L, 2, count);
+		if (count < 3)
+			return luaL_error(L, "Need at least three vertices to draw a polygon");
+
+		if (mode == Graphics::DRAW_FILL)
+		{
+			// Filled polygons don't need the closing vertex, so the Data's
+			// memory can be used as-is.
+			luax_catchexcept(L, [&](){ instance()->polygon(mode, data, count, false); });
+			return 0;
+		}
+
+		Vector2 *coords = instance()->getScratchBuffer<Vector2>(count + 1);
+		std::copy(data, data + count, coords);
+		coords[count] = coords[0];
+
+		luax_catchexcept(L, [&](){ instance()->polygon(mode, coords, count + 1); });
+		return 0;
+	}
+
 	bool is_table = false;
 	if (args == 1 && lua_istable(L, 2))
 	{
@@ -62,14 +62,22 @@ int w_Mesh_setVertices(lua_State *L)
 	{
 		Data *d = luax_checktype<Data>(L, 2);
 
+		// Optional 1-based vertex index to start reading from in the Data.
+		int datastart = (int) luaL_optinteger(L, 5, 1) - 1;
+		size_t dataoffset = datastart * stride;
+
+		// The default start is always valid, so an empty Data is a no-op.
+		if (datastart < 0 || (datastart > 0 && dataoffset >= d->getSize()))
+			return luaL_error(L, "Invalid data start index (must be between 1 and %d)", (int) (d->getSize() / stride));
+
 		vertcount = vertcount >= 0 ? vertcount : (totalverts - vertstart);
 		if (vertstart + vertcount > totalverts)
 			return luaL_error(L, "Too many vertices (expected at most %d, got %d)", totalverts - vertstart, vertcount);
 
-		size_t datasize = std::min(d->getSize(), vertcount * stride);
+		size_t datasize = std::min(d->getSize() - dataoffset, vertcount * stride);
 		char *bytedata = (char *) t->getVertexData() + byteoffset;
 
-		memcpy(bytedata, d->getData(), datasize);
+		memcpy(bytedata, (const char *) d->getData() + dataoffset, datasize);
 
 		t->setVertexDataModified(byteoffset, datasize);
 		luax_catchexcept(L, [&]() { t->flush(); });
@@ -22,6 +22,8 @@
 #include "wrap_SpriteBatch.h"
 #include "Texture.h"
 #include "wrap_Texture.h"
+#include "wrap_Buffer.h"
+#include "common/Data.h"
 
 namespace love
 {
@@ -122,6 +124,71 @@ int w_SpriteBatch_setLayer(lua_State *L)
 	return 0;
 }
 
+int w_SpriteBatch_setSprites(lua_State *L)
+{
+	SpriteBatch *t = luax_checkspritebatch(L, 1);
+
+	Buffer *buffer = luax_totype<Buffer>(L, 2);
+	Data *data = buffer == nullptr ? luax_checktype<Data>(L, 2) : nullptr;
+
+	luaL_checktype(L, 3, LUA_TTABLE);
+	std::vector<SpriteBatch::SpriteDataField> format;
+	for (int i = 1; i <= (int) luax_objlen(L, 3); i++)
+	{
+		lua_rawgeti(L, 3, i);
+		const char *str = luaL_checkstring(L, -1);
+		SpriteBatch::SpriteDataField field;
+		if (!SpriteBatch::getConstant(str, field))
+			return luax_enumerror(L, "sprite data field", SpriteBatch::getConstants(field), str);
+		format.push_back(field);
+		lua_pop(L, 1);
+	}
+
+	size_t stride = SpriteBatch::getSpriteDataStride(format);
+	if (stride == 0)
+		return luaL_error(L, "Sprite data format must have at least one field.");
+
+	size_t datasize = buffer != nullptr ? buffer->getSize() : data->getSize();
+
+	int start = (int) luaL_optinteger(L, 4, 1) - 1;
+	int count = (int) luaL_optinteger(L, 5, datasize / stride);
+
+	std::vector<Quad *> quads;
+	if (!lua_isnoneornil(L, 6))
+	{
+		luaL_checktype(L, 6, LUA_TTABLE);
+		for (int i = 1; i <= (int) luax_objlen(L, 6); i++)
+		{
+			lua_rawgeti(L, 6, i);
+			quads.push_back(luax_checktype<Quad>(L, -1));
+			lua_pop(L, 1);
+		}
+	}
+
+	if (buffer != nullptr)
+	{
+		const void *mapped = nullptr;
+		luax_catchexcept(L,
+			[&]()
+			{
+				mapped = buffer->map(Buffer::MAP_READ_ONLY, 0, datasize);
+				if (mapped == nullptr)
+					throw love::Exception("Only GraphicsBuffers created with the 'readback' data usage can be used as sprite data.");
+				t->setSprites(start, count, mapped, datasize, format, quads);
+			},
+			[&](bool)
+			{
+				if (mapped != nullptr)
+					buffer->unmap(0, datasize);
+			}
+		);
+	}
+	else
+		luax_catchexcept(L, [&]() { t->setSprites(start, count, data->getData(), datasize, format, quads); });
+
+	return 0;
+}
+
 int w_SpriteBatch_clear(lua_State *L)
 {
 	SpriteBatch *t = luax_checkspritebatch(L, 1);
@@ -207,6 +274,13 @@ int w_SpriteBatch_getBufferSize(lua_State *L)
 	return 1;
 }
 
+int w_SpriteBatch_isInstanced(lua_State *L)
+{
+	SpriteBatch *t = luax_checkspritebatch(L, 1);
+	luax_pushboolean(L, t->isInstanced());
+	return 1;
+}
+
 int w_SpriteBatch_attachAttribute(lua_State *L)
 {
 	SpriteBatch *t = luax_checkspritebatch(L, 1);
@@ -274,6 +348,8 @@ static const luaL_Reg w_SpriteBatch_functions[] =
 	{ "getColor", w_SpriteBatch_getColor },
 	{ "getCount", w_SpriteBatch_getCount },
 	{ "getBufferSize", w_SpriteBatch_getBufferSize },
+	{ "setSprites", w_SpriteBatch_setSprites },
+	{ "isInstanced", w_SpriteBatch_isInstanced },
 	{ "attachAttribute", w_SpriteBatch_attachAttribute },
 	{ "setDrawRange", w_SpriteBatch_setDrawRange },
 	{ "getDrawRange", w_SpriteBatch_getDrawRange },
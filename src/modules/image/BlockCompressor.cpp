@@ -0,0 +1,956 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "BlockCompressor.h"
+#include "common/Exception.h"
+#include "thread/threads.h"
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace love
+{
+namespace image
+{
+
+// 16 RGBA8 pixels of a 4x4 block, in row-major order.
+typedef uint8 BlockPixels[16][4];
+
+static inline int clampByte(int v)
+{
+	return std::min(std::max(v, 0), 255);
+}
+
+static inline int colorDistance(const uint8 *a, const uint8 *b, int components)
+{
+	int error = 0;
+	for (int c = 0; c < components; c++)
+	{
+		int d = (int) a[c] - (int) b[c];
+		error += d * d;
+	}
+	return error;
+}
+
+/**
+ * Finds the line through the block's colors along their principal axis, and
+ * returns its extremes in e0 and e1. Uses power iteration on the covariance
+ * matrix, which converges quickly for the small number of pixels in a block.
+ **/
+static void fitBlockLine(const BlockPixels px, int components, const bool *mask, float e0[4], float e1[4])
+{
+	float mean[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+	int count = 0;
+
+	for (int i = 0; i < 16; i++)
+	{
+		if (mask != nullptr && !mask[i])
+			continue;
+		for (int c = 0; c < components; c++)
+			mean[c] += px[i][c];
+		count++;
+	}
+
+	if (count == 0)
+	{
+		for (int c = 0; c < 4; c++)
+			e0[c] = e1[c] = 0.0f;
+		return;
+	}
+
+	for (int c = 0; c < components; c++)
+		mean[c] /= count;
+
+	float cov[4][4] = {};
+	for (int i = 0; i < 16; i++)
+	{
+		if (mask != nullptr && !mask[i])
+			continue;
+		for (int a = 0; a < components; a++)
+		{
+			for (int b = 0; b < components; b++)
+				cov[a][b] += (px[i][a] - mean[a]) * (px[i][b] - mean[b]);
+		}
+	}
+
+	float axis[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+	for (int iter = 0; iter < 8; iter++)
+	{
+		float next[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+		float len = 0.0f;
+		for (int a = 0; a < components; a++)
+		{
+			for (int b = 0; b < components; b++)
+				next[a] += cov[a][b] * axis[b];
+			len = std::max(len, fabsf(next[a]));
+		}
+
+		if (len < 1e-6f)
+			break;
+
+		for (int a = 0; a < components; a++)
+			axis[a] = next[a] / len;
+	}
+
+	float tmin = 0.0f;
+	float tmax = 0.0f;
+	float axislen2 = 0.0f;
+	for (int c = 0; c < components; c++)
+		axislen2 += axis[c] * axis[c];
+
+	for (int i = 0; i < 16; i++)
+	{
+		if (mask != nullptr && !mask[i])
+			continue;
+		float t = 0.0f;
+		for (int c = 0; c < components; c++)
+			t += (px[i][c] - mean[c]) * axis[c];
+		t /= axislen2;
+		tmin = std::min(tmin, t);
+		tmax = std::max(tmax, t);
+	}
+
+	for (int c = 0; c < components; c++)
+	{
+		e0[c] = std::min(std::max(mean[c] + axis[c] * tmax, 0.0f), 255.0f);
+		e1[c] = std::min(std::max(mean[c] + axis[c] * tmin, 0.0f), 255.0f);
+	}
+}
+
+/**
+ * Least-squares refit of two endpoints, given each pixel's interpolation
+ * weight toward e1 (in [0, 1]). Leaves the endpoints alone if the weights are
+ * degenerate.
+ **/
+static void refitBlockLine(const BlockPixels px, int components, const bool *mask, const float *weights, float e0[4], float e1[4])
+{
+	float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+	float ap[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+	float bp[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+	for (int i = 0; i < 16; i++)
+	{
+		if (mask != nullptr && !mask[i])
+			continue;
+
+		float b = weights[i];
+		float a = 1.0f - b;
+
+		aa += a * a;
+		ab += a * b;
+		bb += b * b;
+
+		for (int c = 0; c < components; c++)
+		{
+			ap[c] += a * px[i][c];
+			bp[c] += b * px[i][c];
+		}
+	}
+
+	float det = aa * bb - ab * ab;
+	if (fabsf(det) < 1e-6f)
+		return;
+
+	for (int c = 0; c < components; c++)
+	{
+		e0[c] = std::min(std::max((ap[c] * bb - bp[c] * ab) / det, 0.0f), 255.0f);
+		e1[c] = std::min(std::max((bp[c] * aa - ap[c] * ab) / det, 0.0f), 255.0f);
+	}
+}
+
+// BC1 (DXT1)
+
+static uint16 packRGB565(const float c[4])
+{
+	int r = (int) (c[0] * (31.0f / 255.0f) + 0.5f);
+	int g = (int) (c[1] * (63.0f / 255.0f) + 0.5f);
+	int b = (int) (c[2] * (31.0f / 255.0f) + 0.5f);
+	return (uint16) ((r << 11) | (g << 5) | b);
+}
+
+static void unpackRGB565(uint16 v, uint8 *c)
+{
+	int r = (v >> 11) & 0x1F;
+	int g = (v >> 5) & 0x3F;
+	int b = v & 0x1F;
+	c[0] = (uint8) ((r << 3) | (r >> 2));
+	c[1] = (uint8) ((g << 2) | (g >> 4));
+	c[2] = (uint8) ((b << 3) | (b >> 2));
+	c[3] = 255;
+}
+
+static int encodeBC1Indices(const BlockPixels px, uint16 c0, uint16 c1, bool punchthrough, uint32 &indices)
+{
+	uint8 palette[4][4];
+	unpackRGB565(c0, palette[0]);
+	unpackRGB565(c1, palette[1]);
+
+	for (int c = 0; c < 3; c++)
+	{
+		if (punchthrough)
+		{
+			palette[2][c] = (uint8) ((palette[0][c] + palette[1][c]) / 2);
+			palette[3][c] = 0;
+		}
+		else
+		{
+			palette[2][c] = (uint8) ((2 * palette[0][c] + palette[1][c]) / 3);
+			palette[3][c] = (uint8) ((palette[0][c] + 2 * palette[1][c]) / 3);
+		}
+	}
+
+	int numcolors = punchthrough ? 3 : 4;
+	int error = 0;
+	indices = 0;
+
+	for (int i = 0; i < 16; i++)
+	{
+		int best = 0;
+
+		if (punchthrough && px[i][3] < 128)
+			best = 3;
+		else
+		{
+			int besterror = colorDistance(px[i], palette[0], 3);
+			for (int j = 1; j < numcolors; j++)
+			{
+				int e = colorDistance(px[i], palette[j], 3);
+				if (e < besterror)
+				{
+					besterror = e;
+					best = j;
+				}
+			}
+			error += besterror;
+		}
+
+		indices |= (uint32) best << (i * 2);
+	}
+
+	return error;
+}
+
+static void encodeBlockBC1(const BlockPixels px, int iterations, uint8 *dst)
+{
+	bool mask[16];
+	bool punchthrough = false;
+	for (int i = 0; i < 16; i++)
+	{
+		mask[i] = px[i][3] >= 128;
+		punchthrough = punchthrough || !mask[i];
+	}
+
+	float e0[4], e1[4];
+	fitBlockLine(px, 3, mask, e0, e1);
+
+	uint16 bestc0 = 0, bestc1 = 0;
+	uint32 bestindices = 0;
+	int besterror = -1;
+
+	for (int iter = 0; iter < iterations; iter++)
+	{
+		uint16 c0 = packRGB565(e0);
+		uint16 c1 = packRGB565(e1);
+
+		// The order of the endpoints selects between the 4 color mode and the
+		// 3 color + transparent black mode.
+		if ((punchthrough && c0 > c1) || (!punchthrough && c0 < c1))
+			std::swap(c0, c1);
+
+		uint32 indices = 0;
+		int error = encodeBC1Indices(px, c0, c1, punchthrough, indices);
+
+		// Stop refining once another pass no longer helps.
+		if (besterror >= 0 && error >= besterror)
+			break;
+
+		besterror = error;
+		bestc0 = c0;
+		bestc1 = c1;
+		bestindices = indices;
+
+		if (error == 0 || iter + 1 == iterations)
+			break;
+
+		static const float weights4[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+		static const float weights3[4] = {0.0f, 1.0f, 0.5f, 0.0f};
+
+		float weights[16];
+		for (int i = 0; i < 16; i++)
+		{
+			int index = (indices >> (i * 2)) & 3;
+			weights[i] = punchthrough ? weights3[index] : weights4[index];
+		}
+
+		refitBlockLine(px, 3, mask, weights, e0, e1);
+	}
+
+	// c0 == c1 in 4 color mode decodes as 3 color mode, whose index 3 is
+	// transparent. Index 0 is the same color in both modes.
+	if (!punchthrough && bestc0 == bestc1)
+		bestindices = 0;
+
+	dst[0] = (uint8) (bestc0 & 0xFF);
+	dst[1] = (uint8) (bestc0 >> 8);
+	dst[2] = (uint8) (bestc1 & 0xFF);
+	dst[3] = (uint8) (bestc1 >> 8);
+	dst[4] = (uint8) (bestindices & 0xFF);
+	dst[5] = (uint8) ((bestindices >> 8) & 0xFF);
+	dst[6] = (uint8) ((bestindices >> 16) & 0xFF);
+	dst[7] = (uint8) (bestindices >> 24);
+}
+
+// BC7, using only mode 6: a single subset with RGBA endpoints and 4 bit
+// indices, which suits most natural images.
+
+static const int bc7Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+static void quantizeBC7Endpoint(const float e[4], int pbit, uint8 q[4])
+{
+	for (int c = 0; c < 4; c++)
+	{
+		int v = (int) floorf((e[c] - pbit) * 0.5f + 0.5f);
+		q[c] = (uint8) std::min(std::max(v, 0), 127);
+	}
+}
+
+static int encodeBC7Indices(const BlockPixels px, const uint8 q0[4], const uint8 q1[4], int p0, int p1, uint8 indices[16])
+{
+	uint8 palette[16][4];
+	for (int c = 0; c < 4; c++)
+	{
+		int a = (q0[c] << 1) | p0;
+		int b = (q1[c] << 1) | p1;
+		for (int j = 0; j < 16; j++)
+			palette[j][c] = (uint8) (((64 - bc7Weights4[j]) * a + bc7Weights4[j] * b + 32) >> 6);
+	}
+
+	int error = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		int best = 0;
+		int besterror = colorDistance(px[i], palette[0], 4);
+		for (int j = 1; j < 16 && besterror > 0; j++)
+		{
+			int e = colorDistance(px[i], palette[j], 4);
+			if (e < besterror)
+			{
+				besterror = e;
+				best = j;
+			}
+		}
+		indices[i] = (uint8) best;
+		error += besterror;
+	}
+
+	return error;
+}
+
+struct BitWriter
+{
+	uint8 *dst;
+	int bit;
+
+	void write(uint32 value, int count)
+	{
+		for (int i = 0; i < count; i++, bit++)
+		{
+			if ((value >> i) & 1)
+				dst[bit >> 3] |= (uint8) (1 << (bit & 7));
+		}
+	}
+};
+
+static void encodeBlockBC7(const BlockPixels px, int iterations, bool searchpbits, uint8 *dst)
+{
+	float e0[4], e1[4];
+	fitBlockLine(px, 4, nullptr, e0, e1);
+
+	uint8 bestq0[4] = {}, bestq1[4] = {};
+	uint8 bestindices[16] = {};
+	int bestp0 = 0, bestp1 = 0;
+	int besterror = -1;
+
+	for (int iter = 0; iter < iterations; iter++)
+	{
+		int previouserror = besterror;
+		int itererror = -1;
+		uint8 iterindices[16];
+
+		for (int pbits = 0; pbits < 4; pbits++)
+		{
+			int p0 = pbits & 1;
+			int p1 = pbits >> 1;
+
+			// Without a full search, only use matching p-bits rounded to the
+			// endpoints' average low bit.
+			if (!searchpbits && pbits != 0 && pbits != 3)
+				continue;
+
+			uint8 q0[4], q1[4];
+			quantizeBC7Endpoint(e0, p0, q0);
+			quantizeBC7Endpoint(e1, p1, q1);
+
+			uint8 indices[16];
+			int error = encodeBC7Indices(px, q0, q1, p0, p1, indices);
+
+			if (itererror < 0 || error < itererror)
+			{
+				itererror = error;
+				memcpy(iterindices, indices, sizeof(indices));
+			}
+
+			if (besterror < 0 || error < besterror)
+			{
+				besterror = error;
+				bestp0 = p0;
+				bestp1 = p1;
+				memcpy(bestq0, q0, 4);
+				memcpy(bestq1, q1, 4);
+				memcpy(bestindices, indices, sizeof(indices));
+			}
+		}
+
+		if (besterror == 0 || iter + 1 == iterations || besterror == previouserror)
+			break;
+
+		float weights[16];
+		for (int i = 0; i < 16; i++)
+			weights[i] = bc7Weights4[iterindices[i]] / 64.0f;
+
+		refitBlockLine(px, 4, nullptr, weights, e0, e1);
+	}
+
+	// The most significant bit of the first index is implicitly 0.
+	if (bestindices[0] >= 8)
+	{
+		std::swap(bestq0, bestq1);
+		std::swap(bestp0, bestp1);
+		for (int i = 0; i < 16; i++)
+			bestindices[i] = (uint8) (15 - bestindices[i]);
+	}
+
+	memset(dst, 0, 16);
+	BitWriter writer = {dst, 0};
+
+	writer.write(1 << 6, 7); // Mode 6.
+
+	for (int c = 0; c < 4; c++)
+	{
+		writer.write(bestq0[c], 7);
+		writer.write(bestq1[c], 7);
+	}
+
+	writer.write(bestp0, 1);
+	writer.write(bestp1, 1);
+
+	writer.write(bestindices[0], 3);
+	for (int i = 1; i < 16; i++)
+		writer.write(bestindices[i], 4);
+}
+
+// ETC1-compatible ETC2 RGB blocks, using the individual and differential
+// modes. Differential endpoints are kept in range so the block never
+// switches to ETC2's T, H or planar modes.
+
+static const int etcModifiers[8][2] =
+{
+	{2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183},
+};
+
+struct ETCSubblock
+{
+	int table;
+	uint8 indices[8];
+	int error;
+};
+
+static inline bool etcInSubblock(int x, int y, bool flip, int subblock)
+{
+	return (flip ? (y >= 2) : (x >= 2)) == (subblock == 1);
+}
+
+static void encodeETCSubblock(const BlockPixels px, bool flip, int subblock, const int base[3], ETCSubblock &out)
+{
+	out.error = -1;
+
+	for (int table = 0; table < 8; table++)
+	{
+		int error = 0;
+		uint8 indices[8];
+		int n = 0;
+
+		for (int x = 0; x < 4; x++)
+		{
+			for (int y = 0; y < 4; y++)
+			{
+				if (!etcInSubblock(x, y, flip, subblock))
+					continue;
+
+				const uint8 *p = px[y * 4 + x];
+				int best = 0;
+				int besterror = -1;
+
+				for (int index = 0; index < 4; index++)
+				{
+					int mod = etcModifiers[table][index & 1];
+					if (index & 2)
+						mod = -mod;
+
+					int e = 0;
+					for (int c = 0; c < 3; c++)
+					{
+						int d = clampByte(base[c] + mod) - p[c];
+						e += d * d;
+					}
+
+					if (besterror < 0 || e < besterror)
+					{
+						besterror = e;
+						best = index;
+					}
+				}
+
+				indices[n++] = (uint8) best;
+				error += besterror;
+			}
+		}
+
+		if (out.error < 0 || error < out.error)
+		{
+			out.error = error;
+			out.table = table;
+			memcpy(out.indices, indices, sizeof(indices));
+		}
+	}
+}
+
+static void encodeBlockETC(const BlockPixels px, uint8 *dst)
+{
+	uint32 besthigh = 0;
+	uint32 bestlow = 0;
+	int besterror = -1;
+
+	for (int flip = 0; flip < 2; flip++)
+	{
+		float avg[2][3] = {};
+		for (int x = 0; x < 4; x++)
+		{
+			for (int y = 0; y < 4; y++)
+			{
+				int subblock = etcInSubblock(x, y, flip != 0, 1) ? 1 : 0;
+				for (int c = 0; c < 3; c++)
+					avg[subblock][c] += px[y * 4 + x][c] / 8.0f;
+			}
+		}
+
+		for (int differential = 0; differential < 2; differential++)
+		{
+			int q[2][3];
+			int base[2][3];
+
+			for (int s = 0; s < 2; s++)
+			{
+				for (int c = 0; c < 3; c++)
+				{
+					if (differential)
+					{
+						q[s][c] = (int) (avg[s][c] * (31.0f / 255.0f) + 0.5f);
+						base[s][c] = (q[s][c] << 3) | (q[s][c] >> 2);
+					}
+					else
+					{
+						q[s][c] = (int) (avg[s][c] * (15.0f / 255.0f) + 0.5f);
+						base[s][c] = (q[s][c] << 4) | q[s][c];
+					}
+				}
+			}
+
+			if (differential)
+			{
+				bool valid = true;
+				for (int c = 0; c < 3; c++)
+				{
+					int d = q[1][c] - q[0][c];
+					valid = valid && d >= -4 && d <= 3;
+				}
+				if (!valid)
+					continue;
+			}
+
+			ETCSubblock sub[2];
+			encodeETCSubblock(px, flip != 0, 0, base[0], sub[0]);
+			encodeETCSubblock(px, flip != 0, 1, base[1], sub[1]);
+
+			int error = sub[0].error + sub[1].error;
+			if (besterror >= 0 && error >= besterror)
+				continue;
+
+			uint32 high = 0;
+			for (int c = 0; c < 3; c++)
+			{
+				int shift = 24 - c * 8;
+				if (differential)
+					high |= (uint32) ((q[0][c] << 3) | ((q[1][c] - q[0][c]) & 7)) << shift;
+				else
+					high |= (uint32) ((q[0][c] << 4) | q[1][c]) << shift;
+			}
+
+			high |= (uint32) sub[0].table << 5;
+			high |= (uint32) sub[1].table << 2;
+			high |= (uint32) differential << 1;
+			high |= (uint32) flip;
+
+			// Pixels are numbered in column-major order, with the most
+			// significant index bits in the upper half.
+			uint32 low = 0;
+			int n[2] = {0, 0};
+			for (int x = 0; x < 4; x++)
+			{
+				for (int y = 0; y < 4; y++)
+				{
+					int s = etcInSubblock(x, y, flip != 0, 1) ? 1 : 0;
+					int index = sub[s].indices[n[s]++];
+					int i = x * 4 + y;
+					low |= (uint32) (index >> 1) << (16 + i);
+					low |= (uint32) (index & 1) << i;
+				}
+			}
+
+			besterror = error;
+			besthigh = high;
+			bestlow = low;
+		}
+	}
+
+	for (int i = 0; i < 4; i++)
+	{
+		dst[i] = (uint8) (besthigh >> (24 - i * 8));
+		dst[4 + i] = (uint8) (bestlow >> (24 - i * 8));
+	}
+}
+
+// ASTC 4x4, using single-partition blocks with one weight per pixel. The
+// weight and endpoint ranges are chosen so that both are stored as plain
+// bits: opaque blocks use RGB endpoints (CEM 8) with 3 bit weights, others
+// RGBA endpoints (CEM 12) with 2 bit weights, and the decoder's remaining bit
+// budget leaves 8 bit endpoints in both cases. Solid blocks use the LDR void
+// extent encoding.
+
+// Weight values 0-3 and 0-7, unquantized to the 0-64 interpolation range.
+static const int astcWeights2[4] = {0, 21, 43, 64};
+static const int astcWeights3[8] = {0, 9, 18, 27, 37, 46, 55, 64};
+
+static int encodeASTCWeights(const BlockPixels px, int components, const uint8 q0[4], const uint8 q1[4], const int *weights, int weightcount, uint8 indices[16])
+{
+	// LDR endpoints are expanded to 16 bits before interpolation, and the
+	// result's top 8 bits are used.
+	uint8 palette[8][4];
+	for (int j = 0; j < weightcount; j++)
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			int a = q0[c] * 257;
+			int b = q1[c] * 257;
+			palette[j][c] = (uint8) ((((64 - weights[j]) * a + weights[j] * b + 32) >> 6) >> 8);
+		}
+	}
+
+	int error = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		int best = 0;
+		int besterror = colorDistance(px[i], palette[0], components);
+		for (int j = 1; j < weightcount && besterror > 0; j++)
+		{
+			int e = colorDistance(px[i], palette[j], components);
+			if (e < besterror)
+			{
+				besterror = e;
+				best = j;
+			}
+		}
+		indices[i] = (uint8) best;
+		error += besterror;
+	}
+
+	return error;
+}
+
+static void encodeBlockASTC(const BlockPixels px, int iterations, uint8 *dst)
+{
+	bool solid = true;
+	bool opaque = true;
+	for (int i = 0; i < 16; i++)
+	{
+		solid = solid && memcmp(px[i], px[0], 4) == 0;
+		opaque = opaque && px[i][3] == 255;
+	}
+
+	memset(dst, 0, 16);
+
+	if (solid)
+	{
+		// Void extent block mode and reserved bits, with all extent
+		// coordinates set to 1 (the whole block), then UNORM16 RGBA.
+		static const uint8 voidextent[8] = {0xFC, 0xFD, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+		memcpy(dst, voidextent, 8);
+		for (int c = 0; c < 4; c++)
+		{
+			dst[8 + c * 2 + 0] = px[0][c];
+			dst[8 + c * 2 + 1] = px[0][c];
+		}
+		return;
+	}
+
+	int components = opaque ? 3 : 4;
+	const int *weights = opaque ? astcWeights3 : astcWeights2;
+	int weightcount = opaque ? 8 : 4;
+	int weightbits = opaque ? 3 : 2;
+
+	float e0[4], e1[4];
+	fitBlockLine(px, components, nullptr, e0, e1);
+
+	uint8 bestq0[4] = {0, 0, 0, 255}, bestq1[4] = {0, 0, 0, 255};
+	uint8 bestindices[16] = {};
+	int besterror = -1;
+
+	for (int iter = 0; iter < iterations; iter++)
+	{
+		uint8 q0[4] = {0, 0, 0, 255}, q1[4] = {0, 0, 0, 255};
+		for (int c = 0; c < components; c++)
+		{
+			q0[c] = (uint8) clampByte((int) floorf(e0[c] + 0.5f));
+			q1[c] = (uint8) clampByte((int) floorf(e1[c] + 0.5f));
+		}
+
+		// If the second endpoint's RGB sum is lower, the decoder applies blue
+		// contraction instead of using the endpoints directly.
+		if (q1[0] + q1[1] + q1[2] < q0[0] + q0[1] + q0[2])
+		{
+			std::swap(q0, q1);
+			std::swap(e0, e1);
+		}
+
+		uint8 indices[16];
+		int error = encodeASTCWeights(px, components, q0, q1, weights, weightcount, indices);
+
+		if (besterror >= 0 && error >= besterror)
+			break;
+
+		besterror = error;
+		memcpy(bestq0, q0, 4);
+		memcpy(bestq1, q1, 4);
+		memcpy(bestindices, indices, sizeof(indices));
+
+		if (error == 0 || iter + 1 == iterations)
+			break;
+
+		float w[16];
+		for (int i = 0; i < 16; i++)
+			w[i] = weights[indices[i]] / 64.0f;
+
+		refitBlockLine(px, components, nullptr, w, e0, e1);
+	}
+
+	BitWriter writer = {dst, 0};
+
+	// Block mode for a 4x4 weight grid in a single plane: 0x53 selects
+	// weights 0-7, 0x42 weights 0-3.
+	writer.write(opaque ? 0x53 : 0x42, 11);
+	writer.write(0, 2); // One partition.
+	writer.write(opaque ? 8 : 12, 4); // LDR RGB or RGBA direct.
+
+	for (int c = 0; c < components; c++)
+	{
+		writer.write(bestq0[c], 8);
+		writer.write(bestq1[c], 8);
+	}
+
+	// Weights are stored bit-reversed, starting from the top of the block.
+	for (int i = 0; i < 16; i++)
+	{
+		for (int b = 0; b < weightbits; b++)
+		{
+			if ((bestindices[i] >> b) & 1)
+			{
+				int bit = 127 - (i * weightbits + b);
+				dst[bit >> 3] |= (uint8) (1 << (bit & 7));
+			}
+		}
+	}
+}
+
+struct CompressJob
+{
+	PixelFormat format;
+	const uint8 *rgba;
+	int width;
+	int height;
+	float quality;
+	uint8 *dst;
+};
+
+static void compressBlockRows(const CompressJob &job, int firstrow, int lastrow)
+{
+	int blocksx = (job.width + 3) / 4;
+	size_t blocksize = getPixelFormatBlockSize(job.format);
+
+	int iterations = 1 + (int) (std::min(std::max(job.quality, 0.0f), 1.0f) * 7.0f);
+	bool searchpbits = job.quality >= 0.5f;
+
+	BlockPixels px;
+
+	for (int by = firstrow; by < lastrow; by++)
+	{
+		for (int bx = 0; bx < blocksx; bx++)
+		{
+			// Blocks along the right and bottom edges repeat the last pixels.
+			for (int y = 0; y < 4; y++)
+			{
+				int sy = std::min(by * 4 + y, job.height - 1);
+				for (int x = 0; x < 4; x++)
+				{
+					int sx = std::min(bx * 4 + x, job.width - 1);
+					memcpy(px[y * 4 + x], job.rgba + ((size_t) sy * job.width + sx) * 4, 4);
+				}
+			}
+
+			uint8 *block = job.dst + ((size_t) by * blocksx + bx) * blocksize;
+
+			switch (job.format)
+			{
+			case PIXELFORMAT_DXT1_UNORM:
+			case PIXELFORMAT_DXT1_sRGB:
+				encodeBlockBC1(px, iterations, block);
+				break;
+			case PIXELFORMAT_BC7_UNORM:
+			case PIXELFORMAT_BC7_sRGB:
+				encodeBlockBC7(px, iterations, searchpbits, block);
+				break;
+			case PIXELFORMAT_ETC1_UNORM:
+			case PIXELFORMAT_ETC2_RGB_UNORM:
+			case PIXELFORMAT_ETC2_RGB_sRGB:
+				encodeBlockETC(px, block);
+				break;
+			case PIXELFORMAT_ASTC_4x4_UNORM:
+			case PIXELFORMAT_ASTC_4x4_sRGB:
+				encodeBlockASTC(px, iterations, block);
+				break;
+			default:
+				break;
+			}
+		}
+	}
+}
+
+class CompressWorker : public love::thread::Threadable
+{
+public:
+
+	CompressWorker(const CompressJob &job, int firstrow, int lastrow)
+		: job(job)
+		, firstRow(firstrow)
+		, lastRow(lastrow)
+	{
+		threadName = "BlockCompressor";
+	}
+
+	void threadFunction() override
+	{
+		compressBlockRows(job, firstRow, lastRow);
+	}
+
+private:
+
+	CompressJob job;
+	int firstRow;
+	int lastRow;
+
+}; // CompressWorker
+
+bool BlockCompressor::isFormatSupported(PixelFormat format)
+{
+	switch (format)
+	{
+	case PIXELFORMAT_DXT1_UNORM:
+	case PIXELFORMAT_DXT1_sRGB:
+	case PIXELFORMAT_BC7_UNORM:
+	case PIXELFORMAT_BC7_sRGB:
+	case PIXELFORMAT_ETC1_UNORM:
+	case PIXELFORMAT_ETC2_RGB_UNORM:
+	case PIXELFORMAT_ETC2_RGB_sRGB:
+	case PIXELFORMAT_ASTC_4x4_UNORM:
+	case PIXELFORMAT_ASTC_4x4_sRGB:
+		return true;
+	default:
+		return false;
+	}
+}
+
+void BlockCompressor::compress(PixelFormat format, const uint8 *rgba, int width, int height, float quality, uint8 *dst)
+{
+	if (!isFormatSupported(format))
+		throw love::Exception("Compressing to the %s pixel format is not supported.", getPixelFormatName(format));
+
+	CompressJob job = {format, rgba, width, height, quality, dst};
+
+	// Don't bother with extra threads unless each one gets a decent amount of
+	// work.
+	const int minrowsperthread = 16;
+	int blockrows = (height + 3) / 4;
+	int threadcount = std::min((int) std::thread::hardware_concurrency(), blockrows / minrowsperthread);
+	threadcount = std::min(std::max(threadcount, 1), 16);
+
+	int rowsperthread = (blockrows + threadcount - 1) / threadcount;
+
+	std::vector<CompressWorker *> workers;
+	for (int i = 1; i < threadcount; i++)
+	{
+		int first = std::min(i * rowsperthread, blockrows);
+		int last = std::min(first + rowsperthread, blockrows);
+
+		CompressWorker *worker = new CompressWorker(job, first, last);
+		if (worker->start())
+			workers.push_back(worker);
+		else
+		{
+			worker->release();
+			compressBlockRows(job, first, last);
+		}
+	}
+
+	// The calling thread handles the first range itself.
+	compressBlockRows(job, 0, std::min(rowsperthread, blockrows));
+
+	for (CompressWorker *worker : workers)
+	{
+		worker->wait();
+		worker->release();
+	}
+}
+
+} // image
+} // love
@@ -0,0 +1,57 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/int.h"
+#include "common/pixelformat.h"
+
+namespace love
+{
+namespace image
+{
+
+/**
+ * CPU encoders for a subset of the GPU block-compressed pixel formats, so
+ * runtime-generated images can be uploaded in compressed form.
+ **/
+class BlockCompressor
+{
+public:
+
+	/**
+	 * Whether compress() can encode to the given pixel format.
+	 **/
+	static bool isFormatSupported(PixelFormat format);
+
+	/**
+	 * Compresses tightly packed RGBA8 pixels into dst, which must be at least
+	 * getPixelFormatSliceSize(format, width, height) bytes. Large images are
+	 * split across worker threads.
+	 * @param quality Between 0 and 1. Higher values spend more time refining
+	 *        the endpoints of each block.
+	 **/
+	static void compress(PixelFormat format, const uint8 *rgba, int width, int height, float quality, uint8 *dst);
+
+}; // BlockCompressor
+
+} // image
+} // love
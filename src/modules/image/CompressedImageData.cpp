@@ -19,8 +19,13 @@
  **/
 
 #include "CompressedImageData.h"
+#include "ImageData.h"
+#include "BlockCompressor.h"
 #include "common/Exception.h"
 
+// C++
+#include <algorithm>
+
 namespace love
 {
 namespace image
@@ -61,6 +66,86 @@ CompressedImageData::CompressedImageData(const std::list<FormatHandler *> &forma
 	format = getLinearPixelFormat(format);
 }
 
+CompressedImageData::CompressedImageData(const std::vector<ImageData *> &mipmaps, PixelFormat format, float quality)
+	: format(getLinearPixelFormat(format))
+{
+	if (mipmaps.empty())
+		throw love::Exception("At least one ImageData is required.");
+
+	if (!BlockCompressor::isFormatSupported(this->format))
+		throw love::Exception("Compressing to the %s pixel format is not supported.", getPixelFormatName(format));
+
+	size_t totalsize = 0;
+	int mipw = mipmaps[0]->getWidth();
+	int miph = mipmaps[0]->getHeight();
+
+	for (size_t i = 0; i < mipmaps.size(); i++)
+	{
+		ImageData *mip = mipmaps[i];
+
+		if (mip->getWidth() != mipw || mip->getHeight() != miph)
+			throw love::Exception("Size of mipmap level %d is incorrect (expected %dx%d, got %dx%d)", (int) i + 1, mipw, miph, mip->getWidth(), mip->getHeight());
+
+		if (mip->getPixelGetFunction() == nullptr)
+			throw love::Exception("Compressing ImageData with the %s pixel format is not supported.", getPixelFormatName(mip->getFormat()));
+
+		totalsize += getPixelFormatSliceSize(this->format, mipw, miph);
+
+		mipw = std::max(mipw / 2, 1);
+		miph = std::max(miph / 2, 1);
+	}
+
+	memory.set(new ByteData(totalsize, false), Acquire::NORETAIN);
+
+	std::vector<uint8> rgba;
+	size_t offset = 0;
+
+	for (ImageData *mip : mipmaps)
+	{
+		int w = mip->getWidth();
+		int h = mip->getHeight();
+		size_t size = getPixelFormatSliceSize(this->format, w, h);
+
+		{
+			love::thread::Lock lock(mip->getMutex());
+
+			const uint8 *pixels = (const uint8 *) mip->getData();
+
+			// The encoders work on RGBA8, so other formats are converted first.
+			if (mip->getFormat() != PIXELFORMAT_RGBA8_UNORM)
+			{
+				rgba.resize((size_t) w * h * 4);
+
+				ImageData::PixelGetFunction getpixel = mip->getPixelGetFunction();
+				size_t pixelsize = mip->getPixelSize();
+
+				for (size_t i = 0; i < (size_t) w * h; i++)
+				{
+					Colorf c;
+					getpixel((const ImageData::Pixel *) (pixels + i * pixelsize), c);
+
+					rgba[i * 4 + 0] = (uint8) (std::min(std::max(c.r, 0.0f), 1.0f) * 255.0f + 0.5f);
+					rgba[i * 4 + 1] = (uint8) (std::min(std::max(c.g, 0.0f), 1.0f) * 255.0f + 0.5f);
+					rgba[i * 4 + 2] = (uint8) (std::min(std::max(c.b, 0.0f), 1.0f) * 255.0f + 0.5f);
+					rgba[i * 4 + 3] = (uint8) (std::min(std::max(c.a, 0.0f), 1.0f) * 255.0f + 0.5f);
+				}
+
+				pixels = rgba.data();
+			}
+
+			BlockCompressor::compress(this->format, pixels, w, h, quality, (uint8 *) memory->getData() + offset);
+		}
+
+		auto slice = new CompressedSlice(this->format, w, h, memory, offset, size);
+		dataImages.push_back(slice);
+		slice->release();
+
+		offset += size;
+	}
+
+	setLinear(mipmaps[0]->isLinear());
+}
+
 CompressedImageData::CompressedImageData(const CompressedImageData &c)
 	: format(c.format)
 {
@@ -37,6 +37,8 @@ namespace love
 namespace image
 {
 
+class ImageData;
+
 /**
  * CompressedImageData represents image data which is designed to be uploaded to
  * the GPU and rendered in its compressed form, without being decompressed.
@@ -49,6 +51,12 @@ class CompressedImageData : public Data
 	static love::Type type;
 
 	CompressedImageData(const std::list<FormatHandler *> &formats, Data *filedata);
+
+	/**
+	 * Encodes a chain of ImageData mipmap levels into the given compressed
+	 * format. See BlockCompressor for the supported formats.
+	 **/
+	CompressedImageData(const std::vector<ImageData *> &mipmaps, PixelFormat format, float quality);
 	CompressedImageData(const CompressedImageData &c);
 	virtual ~CompressedImageData();
 
@@ -0,0 +1,206 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "EncodeJob.h"
+#include "ImageData.h"
+#include "Image.h"
+
+namespace love
+{
+namespace image
+{
+
+love::Type EncodeJob::type("EncodeJob", &Object::type);
+
+EncodeJob::EncodeJob(FormatHandler::EncodedFormat format, const FormatHandler::EncodeSettings &settings, const std::string &filename, bool writefile)
+	: format(format)
+	, settings(settings)
+	, filename(filename)
+	, writeFile(writefile)
+	, started(false)
+	, complete(false)
+{
+}
+
+EncodeJob::~EncodeJob()
+{
+}
+
+void EncodeJob::start(ImageData *data)
+{
+	auto module = Module::getInstance<Image>(Module::M_IMAGE);
+
+	if (module == nullptr)
+		throw love::Exception("love.image must be loaded in order to encode an ImageData.");
+
+	{
+		love::thread::Lock lock(mutex);
+
+		if (started || complete)
+			throw love::Exception("EncodeJob has already been started.");
+
+		imageData.set(data);
+		started = true;
+	}
+
+	module->queueEncodeJob(this);
+}
+
+void EncodeJob::fail(const std::string &err)
+{
+	love::thread::Lock lock(mutex);
+
+	error = err;
+	complete = true;
+	imageData.set(nullptr);
+
+	cond->broadcast();
+}
+
+void EncodeJob::run()
+{
+	love::filesystem::FileData *result = nullptr;
+	std::string err;
+
+	try
+	{
+		StrongRef<ImageData> source;
+
+		{
+			// Only hold the lock while copying, so the ImageData can be used
+			// again while it's encoded. Nothing else can touch it if this job
+			// has the only reference (e.g. a screenshot), so no copy is needed.
+			love::thread::Lock lock(imageData->getMutex());
+			if (imageData->getReferenceCount() == 1)
+				source.set(imageData.get());
+			else
+				source.set(imageData->clone(), Acquire::NORETAIN);
+		}
+
+		imageData.set(nullptr);
+
+		result = source->encode(format, filename.c_str(), writeFile, settings);
+	}
+	catch (love::Exception &e)
+	{
+		err = e.what();
+	}
+
+	love::thread::Lock lock(mutex);
+
+	fileData.set(result, Acquire::NORETAIN);
+	error = err;
+	complete = true;
+
+	// The ImageData doesn't need to stay alive after this.
+	imageData.set(nullptr);
+
+	cond->broadcast();
+}
+
+bool EncodeJob::isComplete() const
+{
+	love::thread::Lock lock(mutex);
+	return complete;
+}
+
+bool EncodeJob::hasError() const
+{
+	love::thread::Lock lock(mutex);
+	return complete && !error.empty();
+}
+
+std::string EncodeJob::getError() const
+{
+	love::thread::Lock lock(mutex);
+	return error;
+}
+
+void EncodeJob::wait()
+{
+	love::thread::Lock lock(mutex);
+
+	if (!started && !complete)
+		throw love::Exception("Cannot wait for an EncodeJob which hasn't started yet.");
+
+	while (!complete)
+		cond->wait(mutex);
+}
+
+love::filesystem::FileData *EncodeJob::getFileData() const
+{
+	love::thread::Lock lock(mutex);
+	return fileData.get();
+}
+
+EncodeWorker::EncodeWorker()
+	: stopping(false)
+{
+	threadName = "ImageEncoder";
+}
+
+EncodeWorker::~EncodeWorker()
+{
+}
+
+void EncodeWorker::addJob(EncodeJob *job)
+{
+	love::thread::Lock lock(mutex);
+	jobs.push_back(job);
+	cond->broadcast();
+}
+
+void EncodeWorker::stop()
+{
+	{
+		love::thread::Lock lock(mutex);
+		stopping = true;
+		cond->broadcast();
+	}
+
+	owner->wait();
+}
+
+void EncodeWorker::threadFunction()
+{
+	while (true)
+	{
+		StrongRef<EncodeJob> job;
+
+		{
+			love::thread::Lock lock(mutex);
+
+			while (!stopping && jobs.empty())
+				cond->wait(mutex);
+
+			if (jobs.empty())
+				return;
+
+			job = jobs.front();
+			jobs.pop_front();
+		}
+
+		job->run();
+	}
+}
+
+} // image
+} // love
@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/Object.h"
+#include "thread/threads.h"
+#include "filesystem/FileData.h"
+#include "FormatHandler.h"
+
+// C++
+#include <string>
+#include <deque>
+
+namespace love
+{
+namespace image
+{
+
+class ImageData;
+
+/**
+ * An ImageData being encoded (and optionally saved to a file) on a background
+ * thread. A job can be created before its ImageData exists, for example for a
+ * screenshot which is captured at the end of the frame.
+ **/
+class EncodeJob : public love::Object
+{
+public:
+
+	static love::Type type;
+
+	EncodeJob(FormatHandler::EncodedFormat format, const FormatHandler::EncodeSettings &settings, const std::string &filename, bool writefile);
+	virtual ~EncodeJob();
+
+	/**
+	 * Queues the job on love.image's encoding thread. The ImageData's pixels
+	 * are copied when the job starts, unless nothing else references it.
+	 **/
+	void start(ImageData *imageData);
+
+	/**
+	 * Completes the job with an error, without encoding anything.
+	 **/
+	void fail(const std::string &err);
+
+	/**
+	 * Encodes the ImageData. Called by the worker thread.
+	 **/
+	void run();
+
+	bool isComplete() const;
+	bool hasError() const;
+	std::string getError() const;
+
+	bool isWritingFile() const { return writeFile; }
+
+	/**
+	 * Blocks until the job is complete. Throws if the job hasn't started,
+	 * since it would never finish.
+	 **/
+	void wait();
+
+	/**
+	 * The encoded file, or null if the job isn't complete or failed.
+	 **/
+	love::filesystem::FileData *getFileData() const;
+
+private:
+
+	StrongRef<ImageData> imageData;
+	FormatHandler::EncodedFormat format;
+	FormatHandler::EncodeSettings settings;
+	std::string filename;
+	bool writeFile;
+
+	love::thread::MutexRef mutex;
+	love::thread::ConditionalRef cond;
+
+	bool started;
+	bool complete;
+	std::string error;
+	StrongRef<love::filesystem::FileData> fileData;
+
+}; // EncodeJob
+
+/**
+ * Runs queued EncodeJobs in order on a single background thread. PNG encoding
+ * spreads each image across more threads itself.
+ **/
+class EncodeWorker : public love::thread::Threadable
+{
+public:
+
+	EncodeWorker();
+	virtual ~EncodeWorker();
+
+	// Implements Threadable.
+	void threadFunction() override;
+
+	void addJob(EncodeJob *job);
+
+	// Finishes any queued jobs and waits for the thread to exit.
+	void stop();
+
+private:
+
+	std::deque<StrongRef<EncodeJob>> jobs;
+
+	love::thread::MutexRef mutex;
+	love::thread::ConditionalRef cond;
+
+	bool stopping;
+
+}; // EncodeWorker
+
+} // image
+} // love
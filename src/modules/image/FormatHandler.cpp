@@ -50,7 +50,17 @@ FormatHandler::DecodedImage FormatHandler::decode(Data* /*data*/)
 	throw love::Exception("Image decoding is not implemented for this format backend.");
 }
 
-FormatHandler::EncodedImage FormatHandler::encode(const DecodedImage& /*img*/, EncodedFormat /*format*/)
+bool FormatHandler::canDecodeRegion(Data* /*data*/)
+{
+	return false;
+}
+
+FormatHandler::DecodedImage FormatHandler::decodeRegion(Data* /*data*/, const DecodeSettings& /*settings*/)
+{
+	throw love::Exception("Region decoding is not implemented for this format backend.");
+}
+
+FormatHandler::EncodedImage FormatHandler::encode(const DecodedImage& /*img*/, EncodedFormat /*format*/, const EncodeSettings& /*settings*/)
 {
 	throw love::Exception("Image encoding is not implemented for this format backend.");
 }
@@ -24,6 +24,7 @@
 #include "common/Object.h"
 #include "common/Data.h"
 #include "common/pixelformat.h"
+#include "common/math.h"
 #include "CompressedSlice.h"
 
 #include <vector>
@@ -60,6 +61,23 @@ class FormatHandler : public love::Object
 		unsigned char *data = nullptr;
 	};
 
+	// Which part of an encoded image to decode, and how much to shrink it.
+	struct DecodeSettings
+	{
+		bool hasRegion = false;
+		Rect region = {0, 0, 0, 0};
+		float scale = 1.0f;
+	};
+
+	// How much effort an encoder spends on making its output smaller.
+	struct EncodeSettings
+	{
+		// Between 0 (fastest, largest) and 9 (slowest, smallest), or -1 for
+		// the encoder's default. Formats without adjustable compression
+		// ignore it.
+		int compressionLevel = -1;
+	};
+
 	// Pixel data encoded in a particular format.
 	struct EncodedImage
 	{
@@ -88,10 +106,23 @@ class FormatHandler : public love::Object
 	 **/
 	virtual DecodedImage decode(Data *data);
 
+	/**
+	 * Whether this format handler can decode a region of the given Data
+	 * without holding the entire decoded image in memory at once.
+	 **/
+	virtual bool canDecodeRegion(Data *data);
+
+	/**
+	 * Decodes a region of an image, optionally downscaled, into raw pixel
+	 * data. The returned pixels are allocated with new[] rather than by the
+	 * format handler, so freeRawPixels must not be used on them.
+	 **/
+	virtual DecodedImage decodeRegion(Data *data, const DecodeSettings &settings);
+
 	/**
 	 * Encodes an image from raw pixel data into a particular format.
 	 **/
-	virtual EncodedImage encode(const DecodedImage &img, EncodedFormat format);
+	virtual EncodedImage encode(const DecodedImage &img, EncodedFormat format, const EncodeSettings &settings);
 
 	/**
 	 * Whether this format handler can parse the given Data into a
@@ -43,6 +43,7 @@ love::Type Image::type("image", &Module::type);
 
 Image::Image()
 	: Module(M_IMAGE, "love.image.magpie")
+	, encodeWorker(nullptr)
 {
 	using namespace magpie;
 
@@ -64,6 +65,16 @@ Image::Image()
 
 Image::~Image()
 {
+	// Anything still queued, such as screenshots, is written out first. The
+	// filesystem module can't be destroyed before then, since we reference it.
+	if (encodeWorker != nullptr)
+	{
+		encodeWorker->stop();
+		encodeWorker->release();
+	}
+
+	filesystemModule.set(nullptr);
+
 	// ImageData objects reference the FormatHandlers in our list, so we should
 	// release them instead of deleting them completely here.
 	for (FormatHandler *handler : formatHandlers)
@@ -75,6 +86,11 @@ love::image::ImageData *Image::newImageData(Data *data)
 	return new ImageData(data);
 }
 
+love::image::ImageData *Image::newImageData(Data *data, const FormatHandler::DecodeSettings &settings)
+{
+	return new ImageData(data, settings);
+}
+
 love::image::ImageData *Image::newImageData(int width, int height, PixelFormat format)
 {
 	return new ImageData(width, height, format);
@@ -90,6 +106,11 @@ love::image::CompressedImageData *Image::newCompressedData(Data *data)
 	return new CompressedImageData(formatHandlers, data);
 }
 
+love::image::CompressedImageData *Image::compress(const std::vector<ImageData *> &mipmaps, PixelFormat format, float quality)
+{
+	return new CompressedImageData(mipmaps, format, quality);
+}
+
 bool Image::isCompressed(Data *data)
 {
 	for (FormatHandler *handler : formatHandlers)
@@ -106,6 +127,35 @@ const std::list<FormatHandler *> &Image::getFormatHandlers() const
 	return formatHandlers;
 }
 
+void Image::queueEncodeJob(EncodeJob *job)
+{
+	{
+		love::thread::Lock lock(encodeMutex);
+
+		if (encodeWorker == nullptr)
+		{
+			encodeWorker = new EncodeWorker();
+			if (!encodeWorker->start())
+			{
+				encodeWorker->release();
+				encodeWorker = nullptr;
+			}
+		}
+
+		if (job->isWritingFile() && filesystemModule.get() == nullptr)
+			filesystemModule.set(Module::getInstance<Module>(Module::M_FILESYSTEM));
+
+		if (encodeWorker != nullptr)
+		{
+			encodeWorker->addJob(job);
+			return;
+		}
+	}
+
+	// Without a thread, the job runs immediately instead.
+	job->run();
+}
+
 ImageData *Image::newPastedImageData(ImageData *src, int sx, int sy, int w, int h)
 {
 	ImageData *res = newImageData(w, h, src->getFormat());
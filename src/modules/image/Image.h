@@ -27,6 +27,7 @@
 #include "filesystem/File.h"
 #include "ImageData.h"
 #include "CompressedImageData.h"
+#include "EncodeJob.h"
 
 // C++
 #include <list>
@@ -59,6 +60,15 @@ class Image : public Module
 	 **/
 	ImageData *newImageData(Data *data);
 
+	/**
+	 * Creates new ImageData from part of an encoded image.
+	 * @param data The FileData containing the encoded image data.
+	 * @param settings The region of the encoded image to decode, and the
+	 *        factor to scale it down by.
+	 * @return The new ImageData.
+	 **/
+	ImageData *newImageData(Data *data, const FormatHandler::DecodeSettings &settings);
+
 	/**
 	 * Creates empty ImageData with the given size.
 	 * @param width The width of the ImageData.
@@ -85,6 +95,14 @@ class Image : public Module
 	 **/
 	CompressedImageData *newCompressedData(Data *data);
 
+	/**
+	 * Encodes ImageData mipmap levels into a GPU-compressed pixel format.
+	 * @param mipmaps The base level, followed by any smaller mipmap levels.
+	 * @param format The compressed pixel format to encode to.
+	 * @param quality Between 0 and 1, trading encoding time for quality.
+	 **/
+	CompressedImageData *compress(const std::vector<ImageData *> &mipmaps, PixelFormat format, float quality);
+
 	/**
 	 * Determines whether a FileData is Compressed image data or not.
 	 * @param data The FileData to test.
@@ -96,6 +114,12 @@ class Image : public Module
 
 	const std::list<FormatHandler *> &getFormatHandlers() const;
 
+	/**
+	 * Runs an EncodeJob on the background encoding thread, after any jobs
+	 * queued before it.
+	 **/
+	void queueEncodeJob(EncodeJob *job);
+
 private:
 
 	ImageData *newPastedImageData(ImageData *src, int sx, int sy, int w, int h);
@@ -103,6 +127,15 @@ class Image : public Module
 	// Image format handlers we can use for decoding and encoding ImageData.
 	std::list<FormatHandler *> formatHandlers;
 
+	// Created when the first EncodeJob is queued.
+	EncodeWorker *encodeWorker;
+
+	// Kept alive until queued jobs have finished writing their files.
+	StrongRef<Module> filesystemModule;
+
+	// Guards the two members above, since jobs can be queued from any thread.
+	love::thread::MutexRef encodeMutex;
+
 }; // Image
 
 } // image
@@ -20,9 +20,21 @@
 
 #include "ImageData.h"
 #include "Image.h"
+#include "RegionSampler.h"
+#include "EncodeJob.h"
 #include "filesystem/Filesystem.h"
+#include "math/MathModule.h"
 
 #include <algorithm> // min/max
+#include <cmath>
+
+#if defined(LOVE_SIMD_SSE)
+#include <xmmintrin.h>
+#endif
+
+#if defined(LOVE_SIMD_NEON)
+#include <arm_neon.h>
+#endif
 
 using love::thread::Lock;
 
@@ -39,6 +51,12 @@ ImageData::ImageData(Data *data)
 	decode(data);
 }
 
+ImageData::ImageData(Data *data, const FormatHandler::DecodeSettings &settings)
+	: ImageDataBase(PIXELFORMAT_UNKNOWN, 0, 0)
+{
+	decode(data, &settings);
+}
+
 ImageData::ImageData(int width, int height, PixelFormat format)
 	: ImageDataBase(format, width, height)
 {
@@ -105,10 +123,11 @@ void ImageData::create(int width, int height, PixelFormat format, void *data)
 	pixelGetFunction = getPixelGetFunction(format);
 }
 
-void ImageData::decode(Data *data)
+void ImageData::decode(Data *data, const FormatHandler::DecodeSettings *settings)
 {
 	FormatHandler *decoder = nullptr;
 	FormatHandler::DecodedImage decodedimage;
+	bool ownsdecodedimage = false;
 
 	auto module = Module::getInstance<Image>(Module::M_IMAGE);
 
@@ -124,9 +143,36 @@ void ImageData::decode(Data *data)
 		}
 	}
 
-	if (decoder)
+	if (decoder && settings != nullptr && decoder->canDecodeRegion(data))
+	{
+		// The decoder only keeps the rows it needs, and allocates the result
+		// with new[] itself.
+		decodedimage = decoder->decodeRegion(data, *settings);
+		ownsdecodedimage = true;
+	}
+	else if (decoder)
+	{
 		decodedimage = decoder->decode(data);
 
+		if (decodedimage.data != nullptr && settings != nullptr)
+		{
+			FormatHandler::DecodedImage fullimage = decodedimage;
+
+			try
+			{
+				decodedimage = RegionSampler::resample(fullimage, *settings);
+			}
+			catch (love::Exception &)
+			{
+				decoder->freeRawPixels(fullimage.data);
+				throw;
+			}
+
+			decoder->freeRawPixels(fullimage.data);
+			ownsdecodedimage = true;
+		}
+	}
+
 	if (decodedimage.data == nullptr)
 	{
 		auto filedata = dynamic_cast<filesystem::FileData *>(data);
@@ -142,7 +188,10 @@ void ImageData::decode(Data *data)
 
 	if (decodedimage.size != getPixelFormatSliceSize(decodedimage.format, decodedimage.width, decodedimage.height))
 	{
-		decoder->freeRawPixels(decodedimage.data);
+		if (ownsdecodedimage)
+			delete[] decodedimage.data;
+		else
+			decoder->freeRawPixels(decodedimage.data);
 		throw love::Exception("Could not convert image!");
 	}
 
@@ -161,13 +210,13 @@ void ImageData::decode(Data *data)
 	this->data   = decodedimage.data;
 	this->format = decodedimage.format;
 
-	decodeHandler = decoder;
+	decodeHandler = ownsdecodedimage ? nullptr : decoder;
 
 	pixelSetFunction = getPixelSetFunction(format);
 	pixelGetFunction = getPixelGetFunction(format);
 }
 
-love::filesystem::FileData *ImageData::encode(FormatHandler::EncodedFormat encodedFormat, const char *filename, bool writefile) const
+love::filesystem::FileData *ImageData::encode(FormatHandler::EncodedFormat encodedFormat, const char *filename, bool writefile, const FormatHandler::EncodeSettings &settings) const
 {
 	FormatHandler *encoder = nullptr;
 	FormatHandler::EncodedImage encodedimage;
@@ -194,7 +243,7 @@ love::filesystem::FileData *ImageData::encode(FormatHandler::EncodedFormat encod
 	}
 
 	if (encoder != nullptr)
-		encodedimage = encoder->encode(rawimage, encodedFormat);
+		encodedimage = encoder->encode(rawimage, encodedFormat, settings);
 
 	if (encoder == nullptr || encodedimage.data == nullptr)
 		throw love::Exception("No suitable image encoder for the %s pixel format.", getPixelFormatName(format));
@@ -238,6 +287,23 @@ love::filesystem::FileData *ImageData::encode(FormatHandler::EncodedFormat encod
 	return filedata;
 }
 
+EncodeJob *ImageData::encodeAsync(FormatHandler::EncodedFormat encodedFormat, const char *filename, bool writefile, const FormatHandler::EncodeSettings &settings)
+{
+	EncodeJob *job = new EncodeJob(encodedFormat, settings, filename, writefile);
+
+	try
+	{
+		job->start(this);
+	}
+	catch (love::Exception &)
+	{
+		job->release();
+		throw;
+	}
+
+	return job;
+}
+
 size_t ImageData::getSize() const
 {
 	return size_t(getWidth() * getHeight()) * getPixelSize();
@@ -764,6 +830,255 @@ void ImageData::paste(ImageData *src, int dx, int dy, int sx, int sy, int sw, in
 	}
 }
 
+// Radius (in destination pixels) of the windowed sinc mipmap kernels.
+static const int MIPMAP_KERNEL_RADIUS = 3;
+
+static float sinc(float x)
+{
+	if (fabsf(x) < 1e-6f)
+		return 1.0f;
+
+	x *= (float) LOVE_M_PI;
+	return sinf(x) / x;
+}
+
+// Zeroth-order modified Bessel function of the first kind.
+static float bessel0(float x)
+{
+	float sum = 1.0f;
+	float term = 1.0f;
+	float halfx = x * 0.5f;
+
+	for (int k = 1; k < 32 && term > sum * 1e-8f; k++)
+	{
+		term *= (halfx / k) * (halfx / k);
+		sum += term;
+	}
+
+	return sum;
+}
+
+static float mipmapKernel(ImageData::MipmapFilter filter, float x)
+{
+	const float radius = (float) MIPMAP_KERNEL_RADIUS;
+
+	if (fabsf(x) >= radius)
+		return 0.0f;
+
+	if (filter == ImageData::MIPMAP_FILTER_KAISER)
+	{
+		const float alpha = 4.0f;
+		float t = x / radius;
+		return sinc(x) * bessel0(alpha * sqrtf(1.0f - t * t)) / bessel0(alpha);
+	}
+	else // Lanczos
+		return sinc(x) * sinc(x / radius);
+}
+
+/**
+ * Source indices and normalized weights for each destination pixel along one
+ * axis, stored with a fixed number of taps per pixel.
+ **/
+struct MipmapTaps
+{
+	int count = 0;
+	std::vector<int> indices;
+	std::vector<float> weights;
+};
+
+static void computeMipmapTaps(ImageData::MipmapFilter filter, int srcsize, int dstsize, MipmapTaps &taps)
+{
+	float scale = (float) srcsize / (float) dstsize;
+
+	if (filter == ImageData::MIPMAP_FILTER_BOX)
+		taps.count = (int) ceilf(scale) + 1;
+	else
+		taps.count = (int) ceilf(2.0f * MIPMAP_KERNEL_RADIUS * scale) + 1;
+
+	taps.indices.assign(dstsize * taps.count, 0);
+	taps.weights.assign(dstsize * taps.count, 0.0f);
+
+	for (int i = 0; i < dstsize; i++)
+	{
+		int *indices = &taps.indices[i * taps.count];
+		float *weights = &taps.weights[i * taps.count];
+
+		float total = 0.0f;
+
+		if (filter == ImageData::MIPMAP_FILTER_BOX)
+		{
+			// Exact area coverage of the destination pixel's footprint.
+			float left = i * scale;
+			float right = (i + 1) * scale;
+			int first = (int) floorf(left);
+
+			for (int k = 0; k < taps.count; k++)
+			{
+				int j = first + k;
+				float overlap = std::min(right, (float) (j + 1)) - std::max(left, (float) j);
+				indices[k] = std::min(std::max(j, 0), srcsize - 1);
+				weights[k] = std::max(overlap, 0.0f);
+				total += weights[k];
+			}
+		}
+		else
+		{
+			float center = (i + 0.5f) * scale;
+			int first = (int) floorf(center - MIPMAP_KERNEL_RADIUS * scale);
+
+			for (int k = 0; k < taps.count; k++)
+			{
+				int j = first + k;
+				indices[k] = std::min(std::max(j, 0), srcsize - 1);
+				weights[k] = mipmapKernel(filter, ((j + 0.5f) - center) / scale);
+				total += weights[k];
+			}
+		}
+
+		if (total != 0.0f)
+		{
+			for (int k = 0; k < taps.count; k++)
+				weights[k] /= total;
+		}
+	}
+}
+
+static inline void accumulateColor(Colorf &dst, const Colorf &src, float w)
+{
+#if defined(LOVE_SIMD_SSE)
+	__m128 d = _mm_loadu_ps(&dst.r);
+	__m128 s = _mm_loadu_ps(&src.r);
+	_mm_storeu_ps(&dst.r, _mm_add_ps(d, _mm_mul_ps(s, _mm_set1_ps(w))));
+#elif defined(LOVE_SIMD_NEON)
+	vst1q_f32(&dst.r, vmlaq_n_f32(vld1q_f32(&dst.r), vld1q_f32(&src.r), w));
+#else
+	dst.r += src.r * w;
+	dst.g += src.g * w;
+	dst.b += src.b * w;
+	dst.a += src.a * w;
+#endif
+}
+
+// Separable downsample: horizontal pass into tmp, then vertical pass into dst.
+static void downsampleMipmap(const Colorf *src, int srcw, int srch, Colorf *dst, int dstw, int dsth,
+                             std::vector<Colorf> &tmp, const MipmapTaps &xtaps, const MipmapTaps &ytaps)
+{
+	tmp.assign((size_t) dstw * srch, Colorf(0.0f, 0.0f, 0.0f, 0.0f));
+
+	for (int y = 0; y < srch; y++)
+	{
+		const Colorf *srcrow = src + (size_t) y * srcw;
+		Colorf *tmprow = &tmp[(size_t) y * dstw];
+
+		for (int x = 0; x < dstw; x++)
+		{
+			const int *indices = &xtaps.indices[x * xtaps.count];
+			const float *weights = &xtaps.weights[x * xtaps.count];
+
+			for (int k = 0; k < xtaps.count; k++)
+				accumulateColor(tmprow[x], srcrow[indices[k]], weights[k]);
+		}
+	}
+
+	for (int y = 0; y < dsth; y++)
+	{
+		Colorf *dstrow = dst + (size_t) y * dstw;
+		const int *indices = &ytaps.indices[y * ytaps.count];
+		const float *weights = &ytaps.weights[y * ytaps.count];
+
+		for (int x = 0; x < dstw; x++)
+			dstrow[x] = Colorf(0.0f, 0.0f, 0.0f, 0.0f);
+
+		for (int k = 0; k < ytaps.count; k++)
+		{
+			if (weights[k] == 0.0f)
+				continue;
+
+			const Colorf *tmprow = &tmp[(size_t) indices[k] * dstw];
+			for (int x = 0; x < dstw; x++)
+				accumulateColor(dstrow[x], tmprow[x], weights[k]);
+		}
+	}
+}
+
+std::vector<StrongRef<ImageData>> ImageData::generateMipmaps(MipmapFilter filter, bool srgb)
+{
+	if (pixelGetFunction == nullptr || pixelSetFunction == nullptr)
+		throw love::Exception("ImageData:generateMipmaps does not currently support the %s pixel format.", getPixelFormatName(format));
+
+	std::vector<StrongRef<ImageData>> chain;
+	chain.emplace_back(this);
+
+	size_t pixelsize = getPixelSize();
+
+	// Each level is filtered from the previous level's unquantized values.
+	std::vector<Colorf> src((size_t) width * height);
+	std::vector<Colorf> dst;
+	std::vector<Colorf> tmp;
+
+	{
+		Lock lock(getMutex());
+
+		for (size_t i = 0; i < src.size(); i++)
+			pixelGetFunction((const Pixel *) (data + i * pixelsize), src[i]);
+	}
+
+	if (srgb)
+	{
+		for (Colorf &c : src)
+		{
+			c.r = math::gammaToLinear(c.r);
+			c.g = math::gammaToLinear(c.g);
+			c.b = math::gammaToLinear(c.b);
+		}
+	}
+
+	MipmapTaps xtaps;
+	MipmapTaps ytaps;
+
+	int srcw = width;
+	int srch = height;
+
+	while (srcw > 1 || srch > 1)
+	{
+		int dstw = std::max(srcw / 2, 1);
+		int dsth = std::max(srch / 2, 1);
+
+		computeMipmapTaps(filter, srcw, dstw, xtaps);
+		computeMipmapTaps(filter, srch, dsth, ytaps);
+
+		dst.resize((size_t) dstw * dsth);
+		downsampleMipmap(src.data(), srcw, srch, dst.data(), dstw, dsth, tmp, xtaps, ytaps);
+
+		StrongRef<ImageData> mip(new ImageData(dstw, dsth, format), Acquire::NORETAIN);
+		mip->setLinear(isLinear());
+
+		Pixel *mippixels = (Pixel *) mip->getData();
+
+		for (size_t i = 0; i < dst.size(); i++)
+		{
+			Colorf c = dst[i];
+
+			if (srgb)
+			{
+				c.r = math::linearToGamma(c.r);
+				c.g = math::linearToGamma(c.g);
+				c.b = math::linearToGamma(c.b);
+			}
+
+			pixelSetFunction(c, (Pixel *) ((uint8 *) mippixels + i * pixelsize));
+		}
+
+		chain.push_back(mip);
+
+		std::swap(src, dst);
+		srcw = dstw;
+		srch = dsth;
+	}
+
+	return chain;
+}
+
 size_t ImageData::getPixelSize() const
 {
 	return getPixelFormatBlockSize(format);
@@ -839,6 +1154,21 @@ std::vector<std::string> ImageData::getConstants(FormatHandler::EncodedFormat)
 	return encodedFormats.getNames();
 }
 
+bool ImageData::getConstant(const char *in, MipmapFilter &out)
+{
+	return mipmapFilters.find(in, out);
+}
+
+bool ImageData::getConstant(MipmapFilter in, const char *&out)
+{
+	return mipmapFilters.find(in, out);
+}
+
+std::vector<std::string> ImageData::getConstants(MipmapFilter)
+{
+	return mipmapFilters.getNames();
+}
+
 StringMap<FormatHandler::EncodedFormat, FormatHandler::ENCODED_MAX_ENUM>::Entry ImageData::encodedFormatEntries[] =
 {
 	{"tga", FormatHandler::ENCODED_TGA},
@@ -849,5 +1179,14 @@ StringMap<FormatHandler::EncodedFormat, FormatHandler::ENCODED_MAX_ENUM>::Entry
 
 StringMap<FormatHandler::EncodedFormat, FormatHandler::ENCODED_MAX_ENUM> ImageData::encodedFormats(ImageData::encodedFormatEntries, sizeof(ImageData::encodedFormatEntries));
 
+StringMap<ImageData::MipmapFilter, ImageData::MIPMAP_FILTER_MAX_ENUM>::Entry ImageData::mipmapFilterEntries[] =
+{
+	{"box",     ImageData::MIPMAP_FILTER_BOX    },
+	{"kaiser",  ImageData::MIPMAP_FILTER_KAISER },
+	{"lanczos", ImageData::MIPMAP_FILTER_LANCZOS},
+};
+
+StringMap<ImageData::MipmapFilter, ImageData::MIPMAP_FILTER_MAX_ENUM> ImageData::mipmapFilters(ImageData::mipmapFilterEntries, sizeof(ImageData::mipmapFilterEntries));
+
 } // image
 } // love
@@ -39,6 +39,8 @@ namespace love
 namespace image
 {
 
+class EncodeJob;
+
 /**
  * Represents raw pixel data.
  **/
@@ -56,12 +58,21 @@ class ImageData : public ImageDataBase
 		uint32  packed32;
 	};
 
+	enum MipmapFilter
+	{
+		MIPMAP_FILTER_BOX,
+		MIPMAP_FILTER_KAISER,
+		MIPMAP_FILTER_LANCZOS,
+		MIPMAP_FILTER_MAX_ENUM
+	};
+
 	typedef void (*PixelSetFunction)(const Colorf &c, Pixel *p);
 	typedef void (*PixelGetFunction)(const Pixel *p, Colorf &c);
 
 	static love::Type type;
 
 	ImageData(Data *data);
+	ImageData(Data *data, const FormatHandler::DecodeSettings &settings);
 	ImageData(int width, int height, PixelFormat format);
 	ImageData(int width, int height, PixelFormat format, void *data, bool own);
 	ImageData(const ImageData &c);
@@ -103,12 +114,27 @@ class ImageData : public ImageDataBase
 	void getPixel(int x, int y, Colorf &c) const;
 	Colorf getPixel(int x, int y) const;
 
+	/**
+	 * Generates a full mipmap chain on the CPU, down to 1x1. The first element
+	 * of the returned chain is this ImageData, followed by each smaller level.
+	 * @param filter The kernel used to downsample each level.
+	 * @param srgb Whether RGB values are gamma-decoded before filtering and
+	 *        re-encoded afterwards.
+	 **/
+	std::vector<StrongRef<ImageData>> generateMipmaps(MipmapFilter filter, bool srgb);
+
 	/**
 	 * Encodes raw pixel data into a given format.
 	 * @param f The file to save the encoded image data to.
 	 * @param format The format of the encoded data.
 	 **/
-	love::filesystem::FileData *encode(FormatHandler::EncodedFormat format, const char *filename, bool writefile) const;
+	love::filesystem::FileData *encode(FormatHandler::EncodedFormat format, const char *filename, bool writefile, const FormatHandler::EncodeSettings &settings = {}) const;
+
+	/**
+	 * Like encode, but runs on a background thread. The pixels are copied
+	 * when the job starts running, so the ImageData is only locked briefly.
+	 **/
+	EncodeJob *encodeAsync(FormatHandler::EncodedFormat format, const char *filename, bool writefile, const FormatHandler::EncodeSettings &settings = {});
 
 	// Implements ImageDataBase.
 	ImageData *clone() const override;
@@ -129,13 +155,18 @@ class ImageData : public ImageDataBase
 	static bool getConstant(FormatHandler::EncodedFormat in, const char *&out);
 	static std::vector<std::string> getConstants(FormatHandler::EncodedFormat);
 
+	static bool getConstant(const char *in, MipmapFilter &out);
+	static bool getConstant(MipmapFilter in, const char *&out);
+	static std::vector<std::string> getConstants(MipmapFilter);
+
 private:
 
 	// Create imagedata. Initialize with data if not null.
 	void create(int width, int height, PixelFormat format, void *data = nullptr);
 
-	// Decode and load an encoded format.
-	void decode(Data *data);
+	// Decode and load an encoded format. If settings is non-null, only the
+	// given region is kept, scaled down by the given amount.
+	void decode(Data *data, const FormatHandler::DecodeSettings *settings = nullptr);
 
 	// The actual data.
 	unsigned char *data = nullptr;
@@ -150,6 +181,9 @@ class ImageData : public ImageDataBase
 	static StringMap<FormatHandler::EncodedFormat, FormatHandler::ENCODED_MAX_ENUM>::Entry encodedFormatEntries[];
 	static StringMap<FormatHandler::EncodedFormat, FormatHandler::ENCODED_MAX_ENUM> encodedFormats;
 
+	static StringMap<MipmapFilter, MIPMAP_FILTER_MAX_ENUM>::Entry mipmapFilterEntries[];
+	static StringMap<MipmapFilter, MIPMAP_FILTER_MAX_ENUM> mipmapFilters;
+
 }; // ImageData
 
 } // image
@@ -0,0 +1,231 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+// LOVE
+#include "RegionSampler.h"
+#include "ImageData.h"
+#include "common/Exception.h"
+
+// C++
+#include <algorithm>
+#include <new>
+
+// C
+#include <string.h>
+
+namespace love
+{
+namespace image
+{
+
+RegionSampler::RegionSampler(PixelFormat format, int srcwidth, int srcheight, const FormatHandler::DecodeSettings &settings)
+	: format(format)
+	, pixelSize(getPixelFormatBlockSize(format))
+	, outWidth(0)
+	, outHeight(0)
+	, accumRow(0)
+	, outData(nullptr)
+	, accumCount(0)
+{
+	if (!ImageData::validPixelFormat(format))
+		throw love::Exception("ImageData does not support the %s pixel format.", getPixelFormatName(format));
+
+	if (!(settings.scale > 0.0f && settings.scale <= 1.0f))
+		throw love::Exception("Decode scale must be greater than 0 and at most 1.");
+
+	if (settings.hasRegion)
+		region = settings.region;
+	else
+		region = {0, 0, srcwidth, srcheight};
+
+	const Rect &r = region;
+	if (r.x < 0 || r.y < 0 || r.w <= 0 || r.h <= 0
+		|| (int64) r.x + r.w > srcwidth || (int64) r.y + r.h > srcheight)
+	{
+		throw love::Exception("Decode region (x: %d, y: %d, w: %d, h: %d) does not fit inside the %dx%d image.",
+		                      r.x, r.y, r.w, r.h, srcwidth, srcheight);
+	}
+
+	outWidth = std::max(1, std::min(r.w, (int) (r.w * (double) settings.scale + 0.5)));
+	outHeight = std::max(1, std::min(r.h, (int) (r.h * (double) settings.scale + 0.5)));
+
+	nextRow = r.y;
+
+	outData = new (std::nothrow) unsigned char[getPixelFormatSliceSize(format, outWidth, outHeight)];
+	if (outData == nullptr)
+		throw love::Exception("Out of memory.");
+
+	if (outWidth != r.w || outHeight != r.h)
+	{
+		columnStart.resize(outWidth);
+		columnCount.resize(outWidth);
+
+		for (int x = 0; x < outWidth; x++)
+		{
+			int start = (int) ((int64) x * r.w / outWidth);
+			int end = (int) ((int64) (x + 1) * r.w / outWidth);
+			columnStart[x] = start;
+			columnCount[x] = end - start;
+		}
+
+		accum.resize(outWidth * 4, 0.0);
+	}
+}
+
+RegionSampler::~RegionSampler()
+{
+	delete[] outData;
+}
+
+void RegionSampler::addRow(int y, const void *row)
+{
+	if (y != nextRow || !wantsRow(y))
+		throw love::Exception("Image rows must be decoded in order.");
+
+	nextRow++;
+
+	if (accum.empty())
+	{
+		size_t rowsize = pixelSize * region.w;
+		memcpy(outData + rowsize * (y - region.y), row, rowsize);
+		return;
+	}
+
+	int outrow = (int) ((int64) (y - region.y) * outHeight / region.h);
+
+	if (accumCount > 0 && outrow != accumRow)
+		flushRow();
+
+	accumRow = outrow;
+	accumCount++;
+
+	const uint8 *src = (const uint8 *) row;
+
+	if (format == PIXELFORMAT_RGBA8_UNORM)
+	{
+		for (int x = 0; x < outWidth; x++)
+		{
+			const uint8 *p = src + columnStart[x] * 4;
+			uint32 sum[4] = {0, 0, 0, 0};
+
+			for (int i = 0; i < columnCount[x]; i++, p += 4)
+			{
+				sum[0] += p[0];
+				sum[1] += p[1];
+				sum[2] += p[2];
+				sum[3] += p[3];
+			}
+
+			for (int c = 0; c < 4; c++)
+				accum[x * 4 + c] += sum[c];
+		}
+	}
+	else
+	{
+		auto getpixel = ImageData::getPixelGetFunction(format);
+
+		for (int x = 0; x < outWidth; x++)
+		{
+			const uint8 *p = src + columnStart[x] * pixelSize;
+
+			for (int i = 0; i < columnCount[x]; i++, p += pixelSize)
+			{
+				Colorf color;
+				getpixel((const ImageData::Pixel *) p, color);
+
+				accum[x * 4 + 0] += color.r;
+				accum[x * 4 + 1] += color.g;
+				accum[x * 4 + 2] += color.b;
+				accum[x * 4 + 3] += color.a;
+			}
+		}
+	}
+}
+
+void RegionSampler::flushRow()
+{
+	uint8 *dst = outData + pixelSize * outWidth * accumRow;
+
+	if (format == PIXELFORMAT_RGBA8_UNORM)
+	{
+		for (int x = 0; x < outWidth; x++)
+		{
+			double n = (double) columnCount[x] * accumCount;
+			for (int c = 0; c < 4; c++)
+				dst[x * 4 + c] = (uint8) (accum[x * 4 + c] / n + 0.5);
+		}
+	}
+	else
+	{
+		auto setpixel = ImageData::getPixelSetFunction(format);
+
+		for (int x = 0; x < outWidth; x++)
+		{
+			double n = (double) columnCount[x] * accumCount;
+			Colorf color(
+				(float) (accum[x * 4 + 0] / n),
+				(float) (accum[x * 4 + 1] / n),
+				(float) (accum[x * 4 + 2] / n),
+				(float) (accum[x * 4 + 3] / n)
+			);
+
+			setpixel(color, (ImageData::Pixel *) (dst + x * pixelSize));
+		}
+	}
+
+	std::fill(accum.begin(), accum.end(), 0.0);
+	accumCount = 0;
+}
+
+FormatHandler::DecodedImage RegionSampler::finish()
+{
+	if (!isComplete())
+		throw love::Exception("Image data ended before the decode region was complete.");
+
+	if (accumCount > 0)
+		flushRow();
+
+	FormatHandler::DecodedImage img;
+	img.format = format;
+	img.width = outWidth;
+	img.height = outHeight;
+	img.size = getPixelFormatSliceSize(format, outWidth, outHeight);
+	img.data = outData;
+
+	outData = nullptr;
+	return img;
+}
+
+FormatHandler::DecodedImage RegionSampler::resample(const FormatHandler::DecodedImage &img, const FormatHandler::DecodeSettings &settings)
+{
+	RegionSampler sampler(img.format, img.width, img.height, settings);
+
+	const Rect &r = sampler.getRegion();
+	size_t rowsize = getPixelFormatSliceSize(img.format, img.width, 1);
+	size_t offset = r.x * sampler.pixelSize;
+
+	for (int y = r.y; y < r.y + r.h; y++)
+		sampler.addRow(y, img.data + rowsize * y + offset);
+
+	return sampler.finish();
+}
+
+} // image
+} // love
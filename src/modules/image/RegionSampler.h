@@ -0,0 +1,114 @@
+/**
+ * Copyright (c) 2006-2026 LOVE Development Team
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty.  In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ **/
+
+#pragma once
+
+// LOVE
+#include "common/int.h"
+#include "common/pixelformat.h"
+#include "FormatHandler.h"
+
+// C++
+#include <vector>
+
+namespace love
+{
+namespace image
+{
+
+/**
+ * Crops and box-filters decoded image rows as they arrive, so a decoder can
+ * produce a region of a large image without keeping every row in memory.
+ * Rows must be added top to bottom.
+ **/
+class RegionSampler
+{
+public:
+
+	/**
+	 * @param format The pixel format of the rows given to addRow.
+	 * @param srcwidth The width of the full encoded image.
+	 * @param srcheight The height of the full encoded image.
+	 * @param settings The region and scale to produce. Throws if the region
+	 *        doesn't fit inside the full image.
+	 **/
+	RegionSampler(PixelFormat format, int srcwidth, int srcheight, const FormatHandler::DecodeSettings &settings);
+	~RegionSampler();
+
+	/**
+	 * The region of the full image which is read, in source pixels.
+	 **/
+	const Rect &getRegion() const { return region; }
+
+	/**
+	 * Whether the source row at the given y coordinate is part of the region.
+	 **/
+	bool wantsRow(int y) const { return y >= region.y && y < region.y + region.h; }
+
+	/**
+	 * Whether every row of the region has been added.
+	 **/
+	bool isComplete() const { return nextRow >= region.y + region.h; }
+
+	/**
+	 * Adds one source row. The row pointer refers to the pixel at the left
+	 * edge of the region, not to the start of the full row.
+	 **/
+	void addRow(int y, const void *row);
+
+	/**
+	 * Returns the output pixels, allocated with new[]. The caller takes
+	 * ownership.
+	 **/
+	FormatHandler::DecodedImage finish();
+
+	/**
+	 * Crops and scales an already fully decoded image.
+	 **/
+	static FormatHandler::DecodedImage resample(const FormatHandler::DecodedImage &img, const FormatHandler::DecodeSettings &settings);
+
+private:
+
+	void flushRow();
+
+	PixelFormat format;
+	size_t pixelSize;
+
+	Rect region;
+	int outWidth;
+	int outHeight;
+
+	int nextRow;
+	int accumRow;
+
+	unsigned char *outData;
+
+	// Per output column: first source column (relative to the region) and
+	// the number of source columns averaged into it.
+	std::vector<int> columnStart;
+	std::vector<int> columnCount;
+
+	std::vector<double> accum;
+	int accumCount;
+
+}; // RegionSampler
+
+} // image
+} // love
@@ -259,7 +259,7 @@ FormatHandler::DecodedImage EXRHandler::decode(Data *data)
 	return img;
 }
 
-FormatHandler::EncodedImage EXRHandler::encode(const DecodedImage &img, EncodedFormat encodedFormat)
+FormatHandler::EncodedImage EXRHandler::encode(const DecodedImage &img, EncodedFormat encodedFormat, const EncodeSettings& /*settings*/)
 {
 	if (!canEncode(img.format, encodedFormat))
 	{
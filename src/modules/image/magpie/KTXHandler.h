@@ -31,7 +31,7 @@ namespace magpie
 {
 
 /**
- * Handles KTX files with compressed image data inside.
+ * Handles KTX and KTX2 files with compressed image data inside.
  **/
 class KTXHandler : public FormatHandler
 {
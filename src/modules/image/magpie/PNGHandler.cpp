@@ -23,6 +23,8 @@
 // LOVE
 #include "common/Exception.h"
 #include "common/math.h"
+#include "image/RegionSampler.h"
+#include "thread/threads.h"
 
 // LodePNG
 #include "lodepng/lodepng.h"
@@ -32,6 +34,9 @@
 
 // C++
 #include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 // C
 #include <cstdlib>
@@ -97,35 +102,52 @@ static unsigned zlibDecompress(unsigned char **out, size_t *outsize, const unsig
 	return 0; // Success.
 }
 
-// Custom PNG compression function for LodePNG, using zlib.
-static unsigned zlibCompress(unsigned char **out, size_t *outsize, const unsigned char *in,
-                             size_t insize, const LodePNGCompressSettings* /*settings*/)
+// Reverses one of the PNG scanline filters in place. prev is the previous
+// unfiltered scanline, or all zeroes for the first one.
+static bool unfilterScanline(unsigned char *line, const unsigned char *prev, size_t bytewidth, size_t length, unsigned char filtertype)
 {
-	// Get the maximum compressed size of the data.
-	uLongf outdatasize = compressBound(insize);
-
-	// LodePNG uses malloc, realloc, and free.
-	unsigned char *outdata = (unsigned char *) malloc(outdatasize);
-
-	if (!outdata)
-		return 83; // "Memory allocation failed" error code for LodePNG.
-
-	// Use zlib to compress the PNG data.
-	int status = compress(outdata, &outdatasize, in, insize);
-
-	if (status != Z_OK)
+	switch (filtertype)
 	{
-		free(outdata);
-		return 10000; // "Unknown error code" for LodePNG.
+	case 0: // None
+		break;
+	case 1: // Sub
+		for (size_t i = bytewidth; i < length; i++)
+			line[i] += line[i - bytewidth];
+		break;
+	case 2: // Up
+		for (size_t i = 0; i < length; i++)
+			line[i] += prev[i];
+		break;
+	case 3: // Average
+		for (size_t i = 0; i < length; i++)
+		{
+			int a = i >= bytewidth ? line[i - bytewidth] : 0;
+			line[i] += (unsigned char) ((a + prev[i]) / 2);
+		}
+		break;
+	case 4: // Paeth
+		for (size_t i = 0; i < length; i++)
+		{
+			int a = i >= bytewidth ? line[i - bytewidth] : 0;
+			int b = prev[i];
+			int c = i >= bytewidth ? prev[i - bytewidth] : 0;
+			int pa = abs(b - c);
+			int pb = abs(a - c);
+			int pc = abs(a + b - 2 * c);
+
+			if (pa <= pb && pa <= pc)
+				line[i] += (unsigned char) a;
+			else if (pb <= pc)
+				line[i] += (unsigned char) b;
+			else
+				line[i] += (unsigned char) c;
+		}
+		break;
+	default:
+		return false;
 	}
 
-	if (out != nullptr)
-		*out = outdata;
-
-	if (outsize != nullptr)
-		*outsize = (size_t) outdatasize;
-
-	return 0; // Success.
+	return true;
 }
 
 bool PNGHandler::canDecode(Data *data)
@@ -140,6 +162,20 @@ bool PNGHandler::canDecode(Data *data)
 	return status == 0 && width > 0 && height > 0;
 }
 
+bool PNGHandler::canDecodeRegion(Data *data)
+{
+	unsigned int width = 0, height = 0;
+	unsigned char *indata = (unsigned char *) data->getData();
+	size_t insize = data->getSize();
+
+	lodepng::State state;
+	unsigned status = lodepng_inspect(&width, &height, &state, indata, insize);
+
+	// Interlaced images store their pixels out of row order, so they have to
+	// be decoded in full.
+	return status == 0 && width > 0 && height > 0 && state.info_png.interlace_method == 0;
+}
+
 bool PNGHandler::canEncode(PixelFormat rawFormat, EncodedFormat encodedFormat)
 {
 	return encodedFormat == ENCODED_PNG
@@ -199,62 +235,585 @@ PNGHandler::DecodedImage PNGHandler::decode(Data *fdata)
 	return img;
 }
 
-FormatHandler::EncodedImage PNGHandler::encode(const DecodedImage &img, EncodedFormat encodedFormat)
+// Applies a PNG scanline filter. prev is the previous unfiltered scanline, or
+// all zeroes for the first one.
+static void filterScanline(unsigned char *out, const unsigned char *line, const unsigned char *prev, size_t bytewidth, size_t length, unsigned char filtertype)
 {
-	if (!canEncode(img.format, encodedFormat))
-		throw love::Exception("PNG encoder cannot encode to non-PNG format.");
+	switch (filtertype)
+	{
+	case 0: // None
+		memcpy(out, line, length);
+		break;
+	case 1: // Sub
+		memcpy(out, line, bytewidth);
+		for (size_t i = bytewidth; i < length; i++)
+			out[i] = line[i] - line[i - bytewidth];
+		break;
+	case 2: // Up
+		for (size_t i = 0; i < length; i++)
+			out[i] = line[i] - prev[i];
+		break;
+	case 3: // Average
+		for (size_t i = 0; i < length; i++)
+		{
+			int a = i >= bytewidth ? line[i - bytewidth] : 0;
+			out[i] = line[i] - (unsigned char) ((a + prev[i]) / 2);
+		}
+		break;
+	case 4: // Paeth
+		for (size_t i = 0; i < length; i++)
+		{
+			int a = i >= bytewidth ? line[i - bytewidth] : 0;
+			int b = prev[i];
+			int c = i >= bytewidth ? prev[i - bytewidth] : 0;
+			int pa = abs(b - c);
+			int pb = abs(a - c);
+			int pc = abs(a + b - 2 * c);
+
+			if (pa <= pb && pa <= pc)
+				out[i] = line[i] - (unsigned char) a;
+			else if (pb <= pc)
+				out[i] = line[i] - (unsigned char) b;
+			else
+				out[i] = line[i] - (unsigned char) c;
+		}
+		break;
+	default:
+		break;
+	}
+}
 
-	EncodedImage encimg;
+struct PNGEncodeJob
+{
+	const FormatHandler::DecodedImage *img;
+	size_t componentsize;
+	size_t channels;
+	size_t bytewidth;
+	size_t linesize;
+	int level;
+	bool adaptivefilter;
+	int rowsPerBand;
+};
+
+// One horizontal band of the image, deflated independently of the others.
+struct PNGEncodeBand
+{
+	int firstRow = 0;
+	int lastRow = 0;
+	bool last = false;
+	bool failed = false;
+	uLong adler = 1;
+	size_t rawSize = 0;
+	std::vector<unsigned char> output;
+};
+
+class PNGFilterer
+{
+public:
 
-	lodepng::State state;
+	PNGFilterer(const PNGEncodeJob &job)
+		: job(job)
+		, zeroes(job.linesize, 0)
+		, lines{std::vector<unsigned char>(job.linesize), std::vector<unsigned char>(job.linesize)}
+		, candidate(job.linesize + 1)
+	{
+	}
 
-	state.info_raw.colortype = LCT_RGBA;
-	state.info_raw.bitdepth = img.format == PIXELFORMAT_RGBA16_UNORM ? 16 : 8;
+	// Writes the filter type byte and filtered bytes of a row to out. Rows
+	// must be filtered in order starting from any row.
+	void filterRow(int y, unsigned char *out)
+	{
+		const unsigned char *line = getLine(y, lines[y & 1]);
+		const unsigned char *prev = zeroes.data();
+		if (y > 0)
+			prev = getLine(y - 1, lines[(y - 1) & 1]);
 
-	state.info_png.color.colortype = LCT_RGBA;
-	state.info_png.color.bitdepth = state.info_raw.bitdepth;
+		size_t length = job.linesize;
 
-	state.encoder.zlibsettings.custom_zlib = zlibCompress;
+		if (!job.adaptivefilter)
+		{
+			// Paeth on its own compresses screenshots about as well as
+			// choosing per row, for a fraction of the filtering cost.
+			unsigned char type = job.level == 0 ? 0 : 4;
+			out[0] = type;
+			filterScanline(out + 1, line, prev, job.bytewidth, length, type);
+			return;
+		}
 
-	const uint8 *data = img.data;
-	uint16 *swappeddata = nullptr;
+		// Pick the filter with the smallest sum of absolute signed
+		// differences, which is the heuristic libpng and LodePNG use.
+		size_t bestsum = (size_t) -1;
+		for (unsigned char type = 0; type < 5; type++)
+		{
+			filterScanline(candidate.data() + 1, line, prev, job.bytewidth, length, type);
+
+			size_t sum = 0;
+			for (size_t i = 1; i <= length && sum < bestsum; i++)
+				sum += abs((signed char) candidate[i]);
+
+			if (sum < bestsum)
+			{
+				bestsum = sum;
+				candidate[0] = type;
+				memcpy(out, candidate.data(), length + 1);
+			}
+		}
+	}
 
-	// LodePNG expects big-endian raw pixel data when encoding a 16 bit image.
-#ifndef LOVE_BIG_ENDIAN
-	if (state.info_raw.bitdepth == 16)
+private:
+
+	const unsigned char *getLine(int y, std::vector<unsigned char> &storage)
 	{
-		try
+		const unsigned char *src = job.img->data + job.componentsize * 4 * job.img->width * y;
+
+		// PNG stores 16 bit components as big-endian.
+#ifdef LOVE_BIG_ENDIAN
+		const bool swap = false;
+#else
+		const bool swap = job.componentsize == 2;
+#endif
+
+		if (job.channels == 4 && !swap)
+			return src;
+
+		if (job.componentsize == 1)
 		{
-			swappeddata = new uint16[img.size / sizeof(uint16)];
+			for (int x = 0; x < job.img->width; x++)
+				memcpy(&storage[x * 3], &src[x * 4], 3);
 		}
-		catch (std::exception &)
+		else
 		{
-			throw love::Exception("Out of memory.");
+			const uint16 *src16 = (const uint16 *) src;
+			uint16 *dst16 = (uint16 *) storage.data();
+			for (int x = 0; x < job.img->width; x++)
+			{
+				for (size_t c = 0; c < job.channels; c++)
+				{
+					uint16 v = src16[x * 4 + c];
+					dst16[x * job.channels + c] = swap ? swapuint16(v) : v;
+				}
+			}
 		}
 
-		const uint16 *rawdata = (const uint16 *) img.data;
-		size_t numpixelcomponents = img.size / sizeof(uint16);
+		return storage.data();
+	}
 
-		for (size_t i = 0; i < numpixelcomponents; i++)
-			swappeddata[i] = swapuint16(rawdata[i]);
+	const PNGEncodeJob &job;
+	std::vector<unsigned char> zeroes;
+	std::vector<unsigned char> lines[2];
+	std::vector<unsigned char> candidate;
+
+}; // PNGFilterer
+
+static void deflateBand(const PNGEncodeJob &job, PNGEncodeBand &band)
+{
+	PNGFilterer filterer(job);
+	size_t filteredsize = job.linesize + 1;
+	std::vector<unsigned char> filtered(filteredsize);
 
-		data = (const uint8 *) swappeddata;
+	z_stream stream = {};
+	if (deflateInit2(&stream, job.level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+	{
+		band.failed = true;
+		return;
 	}
-#endif
 
-	unsigned status = lodepng_encode(&encimg.data, &encimg.size,
-	                                 data, img.width, img.height, &state);
+	// Prime the compressor with the end of the previous band, so matches
+	// across the band boundary aren't lost.
+	if (band.firstRow > 0)
+	{
+		const size_t windowsize = 32768;
+		int dictrows = (int) std::min<size_t>(band.firstRow, (windowsize + filteredsize - 1) / filteredsize);
+
+		std::vector<unsigned char> dict(dictrows * filteredsize);
+		for (int i = 0; i < dictrows; i++)
+			filterer.filterRow(band.firstRow - dictrows + i, dict.data() + i * filteredsize);
+
+		size_t dictsize = std::min(dict.size(), windowsize);
+		deflateSetDictionary(&stream, dict.data() + dict.size() - dictsize, (uInt) dictsize);
+	}
+
+	band.rawSize = (size_t) (band.lastRow - band.firstRow) * filteredsize;
+	band.output.resize(std::max<size_t>(band.rawSize / 4, 4096));
+
+	for (int y = band.firstRow; y <= band.lastRow && !band.failed; y++)
+	{
+		bool finishing = y == band.lastRow;
+		int flush = Z_NO_FLUSH;
+
+		if (finishing)
+		{
+			// Byte-align non-final bands with an empty stored block so they
+			// can be concatenated.
+			flush = band.last ? Z_FINISH : Z_SYNC_FLUSH;
+			stream.next_in = nullptr;
+			stream.avail_in = 0;
+		}
+		else
+		{
+			filterer.filterRow(y, filtered.data());
+			band.adler = adler32(band.adler, filtered.data(), (uInt) filteredsize);
+			stream.next_in = filtered.data();
+			stream.avail_in = (uInt) filteredsize;
+		}
+
+		while (true)
+		{
+			if (stream.total_out == band.output.size())
+				band.output.resize(band.output.size() * 2);
 
-	if (swappeddata != nullptr)
-		delete[] swappeddata;
+			stream.next_out = band.output.data() + stream.total_out;
+			stream.avail_out = (uInt) std::min<size_t>(band.output.size() - stream.total_out, 0x40000000);
+
+			int status = deflate(&stream, flush);
+
+			if (status == Z_STREAM_ERROR)
+			{
+				band.failed = true;
+				break;
+			}
+
+			if (flush == Z_FINISH ? status == Z_STREAM_END : (stream.avail_in == 0 && stream.avail_out > 0))
+				break;
+		}
+	}
+
+	band.output.resize(stream.total_out);
+	deflateEnd(&stream);
+}
+
+class PNGEncodeWorker : public love::thread::Threadable
+{
+public:
+
+	PNGEncodeWorker(const PNGEncodeJob &job, std::vector<PNGEncodeBand> &bands, std::atomic<int> &nextBand)
+		: job(job)
+		, bands(bands)
+		, nextBand(nextBand)
+	{
+		threadName = "PNGEncoder";
+	}
+
+	void threadFunction() override
+	{
+		deflateBands(job, bands, nextBand);
+	}
+
+	static void deflateBands(const PNGEncodeJob &job, std::vector<PNGEncodeBand> &bands, std::atomic<int> &nextBand)
+	{
+		for (int i = nextBand++; i < (int) bands.size(); i = nextBand++)
+			deflateBand(job, bands[i]);
+	}
+
+private:
+
+	const PNGEncodeJob &job;
+	std::vector<PNGEncodeBand> &bands;
+	std::atomic<int> &nextBand;
+
+}; // PNGEncodeWorker
+
+static bool isOpaque(const FormatHandler::DecodedImage &img)
+{
+	size_t pixelcount = (size_t) img.width * img.height;
+
+	if (img.format == PIXELFORMAT_RGBA16_UNORM)
+	{
+		const uint16 *pixels = (const uint16 *) img.data;
+		for (size_t i = 0; i < pixelcount; i++)
+		{
+			if (pixels[i * 4 + 3] != 0xFFFF)
+				return false;
+		}
+	}
+	else
+	{
+		for (size_t i = 0; i < pixelcount; i++)
+		{
+			if (img.data[i * 4 + 3] != 0xFF)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+static void writeChunk(std::vector<unsigned char> &out, const char *type, const unsigned char *data, size_t size)
+{
+	unsigned char header[8] = {
+		(unsigned char) (size >> 24), (unsigned char) (size >> 16), (unsigned char) (size >> 8), (unsigned char) size,
+		(unsigned char) type[0], (unsigned char) type[1], (unsigned char) type[2], (unsigned char) type[3],
+	};
+
+	out.insert(out.end(), header, header + 8);
+	if (size > 0)
+		out.insert(out.end(), data, data + size);
+
+	uLong crc = crc32(0, header + 4, 4);
+	if (size > 0)
+		crc = crc32(crc, data, (uInt) size);
+
+	unsigned char footer[4] = {
+		(unsigned char) (crc >> 24), (unsigned char) (crc >> 16), (unsigned char) (crc >> 8), (unsigned char) crc,
+	};
+
+	out.insert(out.end(), footer, footer + 4);
+}
+
+FormatHandler::EncodedImage PNGHandler::encode(const DecodedImage &img, EncodedFormat encodedFormat, const EncodeSettings &settings)
+{
+	if (!canEncode(img.format, encodedFormat))
+		throw love::Exception("PNG encoder cannot encode to non-PNG format.");
+
+	int level = settings.compressionLevel;
+	if (level < 0)
+		level = 6;
+	else if (level > 9)
+		throw love::Exception("Invalid PNG compression level: %d", level);
+
+	PNGEncodeJob job;
+	job.img = &img;
+	job.componentsize = img.format == PIXELFORMAT_RGBA16_UNORM ? 2 : 1;
+	// Screenshots are opaque, and dropping their alpha channel shrinks the
+	// data to be filtered and compressed by a quarter.
+	job.channels = isOpaque(img) ? 3 : 4;
+	job.bytewidth = job.componentsize * job.channels;
+	job.linesize = job.bytewidth * img.width;
+	job.level = level;
+	// Low levels trade some size for speed by using a single filter type.
+	job.adaptivefilter = level >= 4;
+
+	// The image is split into bands of roughly 1MB, independently of the
+	// number of threads, so the output doesn't depend on the CPU.
+	job.rowsPerBand = (int) std::max<size_t>(1, (1 << 20) / (job.linesize + 1));
+
+	std::vector<PNGEncodeBand> bands((img.height + job.rowsPerBand - 1) / job.rowsPerBand);
+	for (int i = 0; i < (int) bands.size(); i++)
+	{
+		bands[i].firstRow = i * job.rowsPerBand;
+		bands[i].lastRow = std::min((i + 1) * job.rowsPerBand, img.height);
+		bands[i].last = i == (int) bands.size() - 1;
+	}
+
+	std::atomic<int> nextband(0);
+
+	int threadcount = std::min((int) std::thread::hardware_concurrency(), (int) bands.size());
+	threadcount = std::min(std::max(threadcount, 1), 16);
+
+	std::vector<PNGEncodeWorker *> workers;
+	for (int i = 1; i < threadcount; i++)
+	{
+		PNGEncodeWorker *worker = new PNGEncodeWorker(job, bands, nextband);
+		if (worker->start())
+			workers.push_back(worker);
+		else
+			worker->release();
+	}
+
+	PNGEncodeWorker::deflateBands(job, bands, nextband);
+
+	for (PNGEncodeWorker *worker : workers)
+	{
+		worker->wait();
+		worker->release();
+	}
+
+	size_t compressedsize = 0;
+	for (const PNGEncodeBand &band : bands)
+	{
+		if (band.failed)
+			throw love::Exception("Could not encode PNG image (zlib error)");
+		compressedsize += band.output.size();
+	}
+
+	std::vector<unsigned char> out;
+	out.reserve(compressedsize + 64 + bands.size() * 12);
+
+	const unsigned char signature[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+	out.insert(out.end(), signature, signature + 8);
+
+	unsigned char ihdr[13] = {
+		(unsigned char) (img.width >> 24), (unsigned char) (img.width >> 16), (unsigned char) (img.width >> 8), (unsigned char) img.width,
+		(unsigned char) (img.height >> 24), (unsigned char) (img.height >> 16), (unsigned char) (img.height >> 8), (unsigned char) img.height,
+		(unsigned char) (job.componentsize * 8), // Bit depth.
+		(unsigned char) (job.channels == 3 ? 2 : 6), // RGB or RGBA color type.
+		0, 0, 0, // Compression, filter, and interlace methods.
+	};
+	writeChunk(out, "IHDR", ihdr, sizeof(ihdr));
+
+	// The bands are raw deflate data, so the zlib header (with its level
+	// hint) and the combined checksum are added around them.
+	uLong adler = 1;
+	for (const PNGEncodeBand &band : bands)
+		adler = adler32_combine(adler, band.adler, (z_off_t) band.rawSize);
+
+	unsigned char zlibflags = level <= 1 ? 0x01 : level <= 5 ? 0x5E : level == 6 ? 0x9C : 0xDA;
+	const unsigned char zlibheader[2] = {0x78, zlibflags};
+	bands.front().output.insert(bands.front().output.begin(), zlibheader, zlibheader + 2);
+
+	const unsigned char adlerbytes[4] = {
+		(unsigned char) (adler >> 24), (unsigned char) (adler >> 16), (unsigned char) (adler >> 8), (unsigned char) adler,
+	};
+	bands.back().output.insert(bands.back().output.end(), adlerbytes, adlerbytes + 4);
+
+	for (const PNGEncodeBand &band : bands)
+	{
+		const size_t maxchunksize = 1 << 30;
+		for (size_t offset = 0; offset < band.output.size(); offset += maxchunksize)
+		{
+			size_t size = std::min(band.output.size() - offset, maxchunksize);
+			writeChunk(out, "IDAT", band.output.data() + offset, size);
+		}
+	}
+
+	writeChunk(out, "IEND", nullptr, 0);
+
+	EncodedImage encimg;
+	encimg.size = out.size();
+	encimg.data = (unsigned char *) malloc(encimg.size);
+
+	if (encimg.data == nullptr)
+		throw love::Exception("Out of memory.");
+
+	memcpy(encimg.data, out.data(), encimg.size);
+	return encimg;
+}
+
+PNGHandler::DecodedImage PNGHandler::decodeRegion(Data *fdata, const DecodeSettings &settings)
+{
+	unsigned int width = 0, height = 0;
+	const unsigned char *indata = (const unsigned char *) fdata->getData();
+	size_t insize = fdata->getSize();
+
+	lodepng::State state;
+	unsigned status = lodepng_inspect(&width, &height, &state, indata, insize);
 
 	if (status != 0)
 	{
 		const char *err = lodepng_error_text(status);
-		throw love::Exception("Could not encode PNG image (%s)", err);
+		throw love::Exception("Could not decode PNG image (%s)", err);
 	}
 
-	return encimg;
+	state.info_raw.colortype = LCT_RGBA;
+	state.info_raw.bitdepth = state.info_png.color.bitdepth == 16 ? 16 : 8;
+
+	PixelFormat format = state.info_raw.bitdepth == 16 ? PIXELFORMAT_RGBA16_UNORM : PIXELFORMAT_RGBA8_UNORM;
+	RegionSampler sampler(format, (int) width, (int) height, settings);
+	const Rect &region = sampler.getRegion();
+
+	const LodePNGColorMode &color = state.info_png.color;
+	size_t bpp = lodepng_get_bpp(&color);
+	size_t bytewidth = std::max<size_t>(1, bpp / 8);
+	size_t linesize = ((size_t) width * bpp + 7) / 8;
+	size_t pixelsize = state.info_raw.bitdepth * 4 / 8;
+
+	// Only two scanlines of the encoded image and one converted row are kept,
+	// instead of the whole inflated and converted image.
+	std::vector<unsigned char> line(linesize + 1);
+	std::vector<unsigned char> prevline(linesize, 0);
+	std::vector<unsigned char> rgbaline(pixelsize * width);
+
+	z_stream stream = {};
+	if (inflateInit(&stream) != Z_OK)
+		throw love::Exception("Could not decode PNG image (zlib error)");
+
+	try
+	{
+		const unsigned char *end = indata + insize;
+		const unsigned char *chunk = indata + 8; // Skip the PNG signature.
+		size_t linepos = 0;
+		int y = 0;
+		bool streamend = false;
+
+		while (chunk + 12 <= end && !streamend && !sampler.isComplete())
+		{
+			size_t length = lodepng_chunk_length(chunk);
+			if (length > (size_t) (end - chunk) - 12)
+				throw love::Exception("Could not decode PNG image (corrupt chunk)");
+
+			if (lodepng_chunk_type_equals(chunk, "IEND"))
+				break;
+			else if (lodepng_chunk_type_equals(chunk, "PLTE") || lodepng_chunk_type_equals(chunk, "tRNS"))
+			{
+				status = lodepng_inspect_chunk(&state, chunk - indata, indata, insize);
+				if (status != 0)
+					throw love::Exception("Could not decode PNG image (%s)", lodepng_error_text(status));
+			}
+			else if (lodepng_chunk_type_equals(chunk, "IDAT"))
+			{
+				if (color.colortype == LCT_PALETTE && color.palettesize == 0)
+					throw love::Exception("Could not decode PNG image (missing palette)");
+
+				stream.next_in = (Bytef *) lodepng_chunk_data_const(chunk);
+				stream.avail_in = (uInt) length;
+
+				while (stream.avail_in > 0 && !streamend && !sampler.isComplete())
+				{
+					stream.next_out = line.data() + linepos;
+					stream.avail_out = (uInt) (line.size() - linepos);
+
+					int zstatus = inflate(&stream, Z_NO_FLUSH);
+					if (zstatus == Z_STREAM_END)
+						streamend = true;
+					else if (zstatus == Z_BUF_ERROR)
+						break;
+					else if (zstatus != Z_OK)
+						throw love::Exception("Could not decode PNG image (zlib error)");
+
+					linepos = line.size() - stream.avail_out;
+					if (linepos < line.size())
+						continue;
+
+					linepos = 0;
+					unsigned char *scanline = line.data() + 1;
+
+					if (!unfilterScanline(scanline, prevline.data(), bytewidth, linesize, line[0]))
+						throw love::Exception("Could not decode PNG image (invalid filter type)");
+
+					if (sampler.wantsRow(y))
+					{
+						unsigned char *dst = rgbaline.data() + region.x * pixelsize;
+
+						// Sub-byte pixels can't be addressed individually, so
+						// those rows are converted in full.
+						if (bpp >= 8)
+							status = lodepng_convert(dst, scanline + region.x * (bpp / 8), &state.info_raw, &color, region.w, 1);
+						else
+							status = lodepng_convert(rgbaline.data(), scanline, &state.info_raw, &color, width, 1);
+
+						if (status != 0)
+							throw love::Exception("Could not decode PNG image (%s)", lodepng_error_text(status));
+
+						// LodePNG keeps raw 16 bit images stored as big-endian.
+#ifndef LOVE_BIG_ENDIAN
+						if (state.info_raw.bitdepth == 16)
+						{
+							uint16 *pixeldata = (uint16 *) dst;
+							for (int i = 0; i < region.w * 4; i++)
+								pixeldata[i] = swapuint16(pixeldata[i]);
+						}
+#endif
+
+						sampler.addRow(y, dst);
+					}
+
+					memcpy(prevline.data(), scanline, linesize);
+					y++;
+				}
+			}
+
+			chunk = lodepng_chunk_next_const(chunk, end);
+		}
+	}
+	catch (love::Exception &)
+	{
+		inflateEnd(&stream);
+		throw;
+	}
+
+	inflateEnd(&stream);
+
+	return sampler.finish();
 }
 
 void PNGHandler::freeRawPixels(unsigned char *mem)
@@ -45,7 +45,10 @@ class PNGHandler : public FormatHandler
 	bool canEncode(PixelFormat rawFormat, EncodedFormat encodedFormat) override;
 
 	DecodedImage decode(Data *data) override;
-	EncodedImage encode(const DecodedImage &img, EncodedFormat format) override;
+
+	bool canDecodeRegion(Data *data) override;
+	DecodedImage decodeRegion(Data *data, const DecodeSettings &settings) override;
+	EncodedImage encode(const DecodedImage &img, EncodedFormat format, const EncodeSettings &settings) override;
 
 	void freeRawPixels(unsigned char *mem) override;
 	void freeEncodedImage(unsigned char *mem) override;
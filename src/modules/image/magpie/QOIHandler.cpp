@@ -81,7 +81,7 @@ FormatHandler::DecodedImage QOIHandler::decode(Data *data)
 	return img;
 }
 
-FormatHandler::EncodedImage QOIHandler::encode(const DecodedImage &img, EncodedFormat format)
+FormatHandler::EncodedImage QOIHandler::encode(const DecodedImage &img, EncodedFormat format, const EncodeSettings& /*settings*/)
 {
 	EncodedImage encodedImg;
 
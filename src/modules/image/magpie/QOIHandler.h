@@ -45,7 +45,7 @@ class QOIHandler : public FormatHandler
 	bool canEncode(PixelFormat rawFormat, EncodedFormat encodedFormat) override;
 
 	DecodedImage decode(Data *data) override;
-	EncodedImage encode(const DecodedImage &img, EncodedFormat format) override;
+	EncodedImage encode(const DecodedImage &img, EncodedFormat format, const EncodeSettings &settings) override;
 
 	void freeRawPixels(unsigned char *mem) override;
 	void freeEncodedImage(unsigned char *mem) override;
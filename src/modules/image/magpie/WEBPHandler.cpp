@@ -22,9 +22,12 @@
 
  // LOVE
 #include "common/Exception.h"
+#include "image/RegionSampler.h"
 
 // C++
+#include <algorithm>
 #include <new>
+#include <vector>
 
 // Simple WebP
 #define SIMPLEWEBP_IMPLEMENTATION
@@ -82,6 +85,97 @@ WEBPHandler::DecodedImage WEBPHandler::decode(Data *data)
 	return output;
 }
 
+bool WEBPHandler::canDecodeRegion(Data *data)
+{
+	simplewebp *swebp = nullptr;
+	simplewebp_error err = simplewebp_load_from_memory(data->getData(), data->getSize(), nullptr, &swebp);
+
+	if (err != SIMPLEWEBP_NO_ERROR || swebp == nullptr)
+		return false;
+
+	// Lossless images are only decoded straight to full-size RGBA.
+	bool lossy = !simplewebp_is_lossless(swebp);
+	simplewebp_unload(swebp);
+
+	return lossy;
+}
+
+// Chroma planes are stored at half resolution. This matches the bilinear
+// upsampling simplewebp_decode uses, evaluated for a single full-size pixel.
+static simplewebp_u8 sampleChroma(const simplewebp_u8 *plane, size_t w, size_t h, size_t x, size_t y)
+{
+	size_t cx = x / 2;
+	size_t cy = y / 2;
+	size_t nx = (x & 1) ? std::min(cx + 1, w - 1) : (cx == 0 ? 0 : cx - 1);
+	size_t ny = (y & 1) ? std::min(cy + 1, h - 1) : (cy == 0 ? 0 : cy - 1);
+
+	unsigned v = 9u * plane[cy * w + cx] + 3u * plane[cy * w + nx] + 3u * plane[ny * w + cx] + plane[ny * w + nx];
+	return (simplewebp_u8) ((v + 8u) / 16u);
+}
+
+WEBPHandler::DecodedImage WEBPHandler::decodeRegion(Data *data, const DecodeSettings &settings)
+{
+	simplewebp *swebp = nullptr;
+	simplewebp_error err = simplewebp_load_from_memory(data->getData(), data->getSize(), nullptr, &swebp);
+
+	if (err != SIMPLEWEBP_NO_ERROR)
+		throw love::Exception("Could not decode WebP image (%s)", simplewebp_get_error_text(err));
+
+	try
+	{
+		size_t width, height;
+		simplewebp_get_dimensions(swebp, &width, &height);
+
+		RegionSampler sampler(PIXELFORMAT_RGBA8_UNORM, (int) width, (int) height, settings);
+		const Rect &region = sampler.getRegion();
+
+		// The YUVA420 planes take 2.5 bytes per pixel, compared to the 4 bytes
+		// of full-size RGBA plus the temporary planes simplewebp_decode uses.
+		size_t chromawidth = (width + 1) / 2;
+		size_t chromaheight = (height + 1) / 2;
+		std::vector<simplewebp_u8> planes(width * height * 2 + chromawidth * chromaheight * 2);
+
+		simplewebp_u8 *yplane = planes.data();
+		simplewebp_u8 *aplane = yplane + width * height;
+		simplewebp_u8 *uplane = aplane + width * height;
+		simplewebp_u8 *vplane = uplane + chromawidth * chromaheight;
+
+		err = simplewebp_decode_yuva(swebp, yplane, uplane, vplane, aplane, nullptr);
+		simplewebp_unload(swebp);
+		swebp = nullptr;
+
+		if (err != SIMPLEWEBP_NO_ERROR)
+			throw love::Exception("Could not decode WebP image (%s)", simplewebp_get_error_text(err));
+
+		std::vector<swebp__pixel> row(region.w);
+
+		for (int y = region.y; y < region.y + region.h; y++)
+		{
+			for (int x = 0; x < region.w; x++)
+			{
+				size_t px = region.x + x;
+				size_t i = y * width + px;
+
+				simplewebp_u8 u = sampleChroma(uplane, chromawidth, chromaheight, px, y);
+				simplewebp_u8 v = sampleChroma(vplane, chromawidth, chromaheight, px, y);
+
+				swebp__yuv2rgb_plain(yplane[i], u, v, &row[x]);
+				row[x].a = aplane[i];
+			}
+
+			sampler.addRow(y, row.data());
+		}
+
+		return sampler.finish();
+	}
+	catch (std::exception &)
+	{
+		if (swebp != nullptr)
+			simplewebp_unload(swebp);
+		throw;
+	}
+}
+
 void WEBPHandler::freeRawPixels(unsigned char *mem)
 {
 	delete[] mem;
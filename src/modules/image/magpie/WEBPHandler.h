@@ -39,6 +39,8 @@ class WEBPHandler: public FormatHandler
 
 	bool canDecode(Data *data) override;
 	DecodedImage decode(Data *data) override;
+	bool canDecodeRegion(Data *data) override;
+	DecodedImage decodeRegion(Data *data, const DecodeSettings &settings) override;
 	void freeRawPixels(unsigned char *mem) override;
 };
 
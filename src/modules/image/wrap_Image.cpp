@@ -34,6 +34,35 @@ namespace image
 
 #define instance() (Module::getInstance<Image>(Module::M_IMAGE))
 
+static void luax_checkdecodesettings(lua_State *L, int idx, FormatHandler::DecodeSettings &s)
+{
+	luaL_checktype(L, idx, LUA_TTABLE);
+
+	lua_getfield(L, idx, "region");
+	if (!lua_isnoneornil(L, -1))
+	{
+		luaL_checktype(L, -1, LUA_TTABLE);
+
+		int *fields[] = {&s.region.x, &s.region.y, &s.region.w, &s.region.h};
+		for (int i = 0; i < 4; i++)
+		{
+			lua_rawgeti(L, -1, i + 1);
+			if (!lua_isnumber(L, -1))
+				luaL_error(L, "The 'region' setting must be a table of the form {x, y, width, height}.");
+			*fields[i] = (int) lua_tointeger(L, -1);
+			lua_pop(L, 1);
+		}
+
+		s.hasRegion = true;
+	}
+	lua_pop(L, 1);
+
+	lua_getfield(L, idx, "scale");
+	if (!lua_isnoneornil(L, -1))
+		s.scale = (float) luaL_checknumber(L, -1);
+	lua_pop(L, 1);
+}
+
 int w_newImageData(lua_State *L)
 {
 	// Case 1: width & height.
@@ -85,11 +114,22 @@ int w_newImageData(lua_State *L)
 	}
 	else if (filesystem::luax_cangetdata(L, 1)) // Case 2: File(Data).
 	{
+		bool hassettings = !lua_isnoneornil(L, 2);
+		FormatHandler::DecodeSettings settings;
+		if (hassettings)
+			luax_checkdecodesettings(L, 2, settings);
+
 		Data *data = love::filesystem::luax_getdata(L, 1);
 
 		ImageData *t = nullptr;
 		luax_catchexcept(L,
-			[&]() { t = instance()->newImageData(data); },
+			[&]()
+			{
+				if (hassettings)
+					t = instance()->newImageData(data, settings);
+				else
+					t = instance()->newImageData(data);
+			},
 			[&](bool) { data->release(); }
 		);
 
@@ -128,6 +168,41 @@ int w_isCompressed(lua_State *L)
 	return 1;
 }
 
+int w_compress(lua_State *L)
+{
+	std::vector<ImageData *> mipmaps;
+
+	if (lua_istable(L, 1))
+	{
+		int n = (int) luax_objlen(L, 1);
+		for (int i = 1; i <= n; i++)
+		{
+			lua_rawgeti(L, 1, i);
+			mipmaps.push_back(luax_checkimagedata(L, -1));
+			lua_pop(L, 1);
+		}
+
+		if (mipmaps.empty())
+			return luaL_error(L, "At least one ImageData is required.");
+	}
+	else
+		mipmaps.push_back(luax_checkimagedata(L, 1));
+
+	PixelFormat format = PIXELFORMAT_UNKNOWN;
+	const char *fstr = luaL_checkstring(L, 2);
+	if (!getConstant(fstr, format))
+		return luax_enumerror(L, "pixel format", fstr);
+
+	float quality = (float) luaL_optnumber(L, 3, 0.5);
+
+	CompressedImageData *t = nullptr;
+	luax_catchexcept(L, [&](){ t = instance()->compress(mipmaps, format, quality); });
+
+	luax_pushtype(L, CompressedImageData::type, t);
+	t->release();
+	return 1;
+}
+
 int w_newCubeFaces(lua_State *L)
 {
 	ImageData *id = luax_checkimagedata(L, 1);
@@ -145,6 +220,7 @@ static const luaL_Reg functions[] =
 	{ "newCompressedData", w_newCompressedData },
 	{ "isCompressed", w_isCompressed },
 	{ "newCubeFaces", w_newCubeFaces },
+	{ "compress", w_compress },
 	{ 0, 0 }
 };
 
@@ -152,6 +228,7 @@ static const lua_CFunction types[] =
 {
 	luaopen_imagedata,
 	luaopen_compressedimagedata,
+	luaopen_encodejob,
 	0
 };
 
@@ -19,6 +19,7 @@
  **/
 
 #include "wrap_ImageData.h"
+#include "EncodeJob.h"
 
 #include "data/wrap_Data.h"
 #include "filesystem/File.h"
@@ -234,26 +235,44 @@ int w_ImageData_paste(lua_State *L)
 	return 0;
 }
 
-int w_ImageData_encode(lua_State *L)
+static void luax_checkencodeargs(lua_State *L, FormatHandler::EncodedFormat &format, std::string &filename, bool &hasfilename, FormatHandler::EncodeSettings &settings)
 {
-	ImageData *t = luax_checkimagedata(L, 1);
-
-	FormatHandler::EncodedFormat format;
 	const char *fmt = luaL_checkstring(L, 2);
 	if (!ImageData::getConstant(fmt, format))
-		return luax_enumerror(L, "encoded image format", ImageData::getConstants(format), fmt);
+		luax_enumerror(L, "encoded image format", ImageData::getConstants(format), fmt);
 
-	bool hasfilename = false;
+	hasfilename = false;
 
-	std::string filename = "Image." + std::string(fmt);
+	filename = "Image." + std::string(fmt);
 	if (!lua_isnoneornil(L, 3))
 	{
 		hasfilename = true;
 		filename = luax_checkstring(L, 3);
 	}
 
+	if (!lua_isnoneornil(L, 4))
+	{
+		luaL_checktype(L, 4, LUA_TTABLE);
+
+		lua_getfield(L, 4, "level");
+		if (!lua_isnoneornil(L, -1))
+			settings.compressionLevel = (int) luaL_checkinteger(L, -1);
+		lua_pop(L, 1);
+	}
+}
+
+int w_ImageData_encode(lua_State *L)
+{
+	ImageData *t = luax_checkimagedata(L, 1);
+
+	FormatHandler::EncodedFormat format;
+	std::string filename;
+	bool hasfilename = false;
+	FormatHandler::EncodeSettings settings;
+	luax_checkencodeargs(L, format, filename, hasfilename, settings);
+
 	love::filesystem::FileData *filedata = nullptr;
-	luax_catchexcept(L, [&](){ filedata = t->encode(format, filename.c_str(), hasfilename); });
+	luax_catchexcept(L, [&](){ filedata = t->encode(format, filename.c_str(), hasfilename, settings); });
 
 	luax_pushtype(L, filedata);
 	filedata->release();
@@ -261,6 +280,52 @@ int w_ImageData_encode(lua_State *L)
 	return 1;
 }
 
+int w_ImageData_encodeAsync(lua_State *L)
+{
+	ImageData *t = luax_checkimagedata(L, 1);
+
+	FormatHandler::EncodedFormat format;
+	std::string filename;
+	bool hasfilename = false;
+	FormatHandler::EncodeSettings settings;
+	luax_checkencodeargs(L, format, filename, hasfilename, settings);
+
+	EncodeJob *job = nullptr;
+	luax_catchexcept(L, [&](){ job = t->encodeAsync(format, filename.c_str(), hasfilename, settings); });
+
+	luax_pushtype(L, job);
+	job->release();
+
+	return 1;
+}
+
+int w_ImageData_generateMipmaps(lua_State *L)
+{
+	ImageData *t = luax_checkimagedata(L, 1);
+
+	ImageData::MipmapFilter filter = ImageData::MIPMAP_FILTER_BOX;
+	if (!lua_isnoneornil(L, 2))
+	{
+		const char *str = luaL_checkstring(L, 2);
+		if (!ImageData::getConstant(str, filter))
+			return luax_enumerror(L, "mipmap filter", ImageData::getConstants(filter), str);
+	}
+
+	bool srgb = luax_optboolean(L, 3, false);
+
+	std::vector<StrongRef<ImageData>> chain;
+	luax_catchexcept(L, [&](){ chain = t->generateMipmaps(filter, srgb); });
+
+	lua_createtable(L, (int) chain.size(), 0);
+	for (int i = 0; i < (int) chain.size(); i++)
+	{
+		luax_pushtype(L, chain[i].get());
+		lua_rawseti(L, -2, i + 1);
+	}
+
+	return 1;
+}
+
 // C functions in a struct, necessary for the FFI versions of ImageData methods.
 struct FFI_ImageData
 {
@@ -298,6 +363,8 @@ static const luaL_Reg w_ImageData_functions[] =
 	{ "paste", w_ImageData_paste },
 	{ "mapPixel", w_ImageData_mapPixel },
 	{ "encode", w_ImageData_encode },
+	{ "encodeAsync", w_ImageData_encodeAsync },
+	{ "generateMipmaps", w_ImageData_generateMipmaps },
 	{ 0, 0 }
 };
 
@@ -225,6 +225,7 @@ function love.init()
 		audio = {
 			mixwithsystem = true, -- Only relevant for Android / iOS.
 			mic = false, -- Only relevant for Android.
+			offline = false, -- Mix in software with love.audio.render instead of playing.
 		},
 		console = false, -- Only relevant for windows.
 		identity = false,
@@ -344,6 +345,10 @@ function love.init()
 		love._requestRecordingPermission(c.audio and c.audio.mic)
 	end
 
+	if love._setAudioOffline then
+		love._setAudioOffline(c.audio and c.audio.offline)
+	end
+
 	-- Gets desired modules.
 	for k,v in ipairs{
 		"data",
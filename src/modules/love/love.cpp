@@ -473,6 +473,14 @@ static int w__requestRecordingPermission(lua_State *L)
 	return 0;
 }
 
+static int w__setAudioOffline(lua_State *L)
+{
+#ifdef LOVE_ENABLE_AUDIO
+	love::audio::setOfflineAudio((bool) lua_toboolean(L, 1));
+#endif
+	return 0;
+}
+
 static int w_love_markDeprecated(lua_State *L)
 {
 	int level = (int)luaL_checkinteger(L, 1);
@@ -592,6 +600,8 @@ int luaopen_love(lua_State *L)
 	lua_setfield(L, -2, "_setAudioMixWithSystem");
 	lua_pushcfunction(L, w__requestRecordingPermission);
 	lua_setfield(L, -2, "_requestRecordingPermission");
+	lua_pushcfunction(L, w__setAudioOffline);
+	lua_setfield(L, -2, "_setAudioOffline");
 
 	lua_newtable(L);
 
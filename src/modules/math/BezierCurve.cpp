@@ -79,6 +79,66 @@ void subdivide(vector<love::Vector2> &points, int k)
 		points[i-1 + left.size() - 1] = right[right.size() - i - 1];
 }
 
+/**
+ * Split a Bezier polygon of count points at t using de casteljau. Either
+ * output may be null, and right may be the same array as points. temp must
+ * hold count points.
+ **/
+void split(const love::Vector2 *points, size_t count, float t, love::Vector2 *left, love::Vector2 *right, love::Vector2 *temp)
+{
+	std::copy(points, points + count, temp);
+
+	for (size_t step = 1; step < count; ++step)
+	{
+		if (left)
+			left[step - 1] = temp[0];
+		if (right)
+			right[count - step] = temp[count - step];
+		for (size_t i = 0; i < count - step; ++i)
+			temp[i] += (temp[i+1] - temp[i]) * t;
+	}
+
+	if (left)
+		left[count - 1] = temp[0];
+	if (right)
+		right[0] = temp[0];
+}
+
+/**
+ * Check whether all points of a Bezier polygon are within sqrt(tolerancesq)
+ * of the line segment between its end points. The curve lies within the
+ * convex hull of the polygon, so it's then within that distance as well.
+ **/
+bool isFlat(const love::Vector2 *points, size_t count, double tolerancesq)
+{
+	const love::Vector2 &a = points[0];
+	const love::Vector2 &b = points[count - 1];
+
+	double dx = b.x - a.x;
+	double dy = b.y - a.y;
+	double lengthsq = dx * dx + dy * dy;
+
+	for (size_t i = 1; i + 1 < count; ++i)
+	{
+		double px = points[i].x - a.x;
+		double py = points[i].y - a.y;
+
+		if (lengthsq > 0.0)
+		{
+			double t = std::min(std::max((px * dx + py * dy) / lengthsq, 0.0), 1.0);
+			px -= t * dx;
+			py -= t * dy;
+		}
+
+		if (px * px + py * py > tolerancesq)
+			return false;
+	}
+
+	return true;
+}
+
+const int MAX_ADAPTIVE_DEPTH = 16;
+
 }
 
 namespace love
@@ -203,6 +263,28 @@ Vector2 BezierCurve::evaluate(double t) const
 	return points[0];
 }
 
+void BezierCurve::evaluate(double t1, double t2, int count, Vector2 *out) const
+{
+	if (t1 < 0 || t1 > 1 || t2 < 0 || t2 > 1)
+		throw Exception("Invalid evaluation parameter: must be between 0 and 1");
+	if (controlPoints.size() < 2)
+		throw Exception("Invalid Bezier curve: Not enough control points.");
+
+	vector<Vector2> points(controlPoints.size());
+
+	for (int p = 0; p < count; ++p)
+	{
+		double t = count > 1 ? t1 + (t2 - t1) * p / (count - 1) : t1;
+
+		std::copy(controlPoints.begin(), controlPoints.end(), points.begin());
+		for (size_t step = 1; step < controlPoints.size(); ++step)
+			for (size_t i = 0; i < controlPoints.size() - step; ++i)
+				points[i] = points[i] * (1-t) + points[i+1] * t;
+
+		out[p] = points[0];
+	}
+}
+
 BezierCurve* BezierCurve::getSegment(double t1, double t2) const
 {
 	if (t1 < 0 || t2 > 1)
@@ -275,5 +357,61 @@ vector<Vector2> BezierCurve::renderSegment(double start, double end, int accurac
 	return vertices;
 }
 
+void BezierCurve::renderAdaptive(double tolerance, double t1, double t2, std::vector<Vector2> &out, std::vector<Vector2> &scratch) const
+{
+	if (controlPoints.size() < 2)
+		throw Exception("Invalid Bezier curve: Not enough control points.");
+	if (!(tolerance > 0))
+		throw Exception("Invalid tolerance: must be greater than 0.");
+	if (t1 < 0 || t2 > 1)
+		throw Exception("Invalid segment parameters: must be between 0 and 1");
+	if (t2 < t1)
+		throw Exception("Invalid segment parameters: t1 must be smaller than t2");
+
+	size_t count = controlPoints.size();
+
+	// One temporary polygon for splitting, followed by a stack of polygons
+	// left to flatten. Subdivision is depth-first so the stack never holds
+	// more than one polygon per level.
+	scratch.resize(count * (MAX_ADAPTIVE_DEPTH + 3));
+	Vector2 *temp = scratch.data();
+	Vector2 *stack = temp + count;
+	int depths[MAX_ADAPTIVE_DEPTH + 2];
+
+	std::copy(controlPoints.begin(), controlPoints.end(), stack);
+
+	// Restrict to the segment the same way getSegment does.
+	if (t2 < 1)
+		split(stack, count, (float) t2, stack, nullptr, temp);
+	if (t1 > 0)
+		split(stack, count, t2 > 0 ? (float) (t1 / t2) : 0.0f, nullptr, stack, temp);
+
+	double tolerancesq = tolerance * tolerance;
+
+	out.push_back(stack[0]);
+
+	int top = 1;
+	depths[0] = 0;
+
+	while (top > 0)
+	{
+		top--;
+		Vector2 *curve = stack + top * count;
+		int depth = depths[top];
+
+		if (depth >= MAX_ADAPTIVE_DEPTH || isFlat(curve, count, tolerancesq))
+		{
+			out.push_back(curve[count - 1]);
+			continue;
+		}
+
+		// The right half replaces this polygon and the left half goes on top
+		// of it, so the left half is flattened first.
+		split(curve, count, 0.5f, curve + count, curve, temp);
+		depths[top] = depths[top + 1] = depth + 1;
+		top += 2;
+	}
+}
+
 } // namespace math
 } // namespace love
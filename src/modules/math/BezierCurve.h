@@ -115,6 +115,14 @@ class BezierCurve : public Object
 	 **/
 	Vector2 evaluate(double t) const;
 
+	/**
+	 * Evaluates the curve at count evenly spaced times from t1 to t2.
+	 * @param t1 Curve parameter of the first point.
+	 * @param t2 Curve parameter of the last point.
+	 * @param count Number of points to write to out.
+	 **/
+	void evaluate(double t1, double t2, int count, Vector2 *out) const;
+
 	/**
 	 * Get curve segment starting at t1 and ending at t2.
 	 * The new curve will be parametrized from 0 <= t <= 1.
@@ -140,6 +148,16 @@ class BezierCurve : public Object
 	 **/
 	std::vector<Vector2> renderSegment(double start, double end, int accuracy = 4) const;
 
+	/**
+	 * Renders the segment from t1 to t2 of the curve by adaptive subdivision,
+	 * splitting only where the control polygon is further than tolerance from
+	 * a straight line.
+	 * @param tolerance Maximum distance between the curve and the output.
+	 * @param out Points are appended to this.
+	 * @param scratch Working memory, which can be reused between calls.
+	 **/
+	void renderAdaptive(double tolerance, double t1, double t2, std::vector<Vector2> &out, std::vector<Vector2> &scratch) const;
+
 private:
 	std::vector<Vector2> controlPoints;
 };
@@ -29,6 +29,9 @@
 // STL
 #include <cmath>
 #include <list>
+#include <set>
+#include <algorithm>
+#include <numeric>
 #include <iostream>
 
 // C
@@ -80,6 +83,177 @@ inline bool is_ear(const Vector2 &a, const Vector2 &b, const Vector2 &c, const s
 	return is_oriented_ccw(a,b,c) && !any_point_in_triangle(vertices, a,b,c);
 }
 
+// The monotone partition sweeps from top to bottom (with y pointing up), and
+// from left to right along horizontal lines.
+inline bool is_above(const Vector2 &a, const Vector2 &b)
+{
+	return a.y > b.y || (a.y == b.y && a.x < b.x);
+}
+
+// det(a-o, b-o), positive if o->a->b turns counter clockwise
+inline double cross(const Vector2 &o, const Vector2 &a, const Vector2 &b)
+{
+	return ((double) a.x - o.x) * ((double) b.y - o.y) - ((double) a.y - o.y) * ((double) b.x - o.x);
+}
+
+enum SweepVertexType
+{
+	SWEEP_VERTEX_START,
+	SWEEP_VERTEX_END,
+	SWEEP_VERTEX_SPLIT,
+	SWEEP_VERTEX_MERGE,
+	SWEEP_VERTEX_REGULAR,
+};
+
+// Orders the edges crossing the sweep line from left to right. Edge i goes
+// downwards from vertex i to vertex next[i]. Also compares edges against a
+// point on the sweep line, to find the edge directly left of a vertex.
+struct SweepEdgeLess
+{
+	using is_transparent = void;
+
+	const Vector2 *points;
+	const size_t *next;
+
+	bool operator () (size_t a, size_t b) const
+	{
+		if (a == b)
+			return false;
+
+		const Vector2 &atop = points[a], &abottom = points[next[a]];
+		const Vector2 &btop = points[b], &bbottom = points[next[b]];
+
+		// Compare the lower of the two top vertices against the other edge.
+		if (!is_above(atop, btop))
+		{
+			double c = cross(btop, bbottom, atop);
+			if (c == 0)
+				c = cross(btop, bbottom, abottom);
+			return c < 0;
+		}
+		else
+		{
+			double c = cross(atop, abottom, btop);
+			if (c == 0)
+				c = cross(atop, abottom, bbottom);
+			return c > 0;
+		}
+	}
+
+	bool operator () (size_t e, const Vector2 &p) const
+	{
+		return cross(points[e], points[next[e]], p) > 0;
+	}
+
+	bool operator () (const Vector2 &p, size_t e) const
+	{
+		return cross(points[e], points[next[e]], p) < 0;
+	}
+};
+
+// Adds a triangle, wound counter clockwise.
+inline void add_triangle(const std::vector<Vector2> &points, size_t a, size_t b, size_t c, std::vector<love::uint32> &indices)
+{
+	if (cross(points[a], points[b], points[c]) < 0)
+		std::swap(b, c);
+
+	indices.push_back((love::uint32) a);
+	indices.push_back((love::uint32) b);
+	indices.push_back((love::uint32) c);
+}
+
+// Triangulates a y-monotone polygon wound counter clockwise, in linear time.
+void triangulate_monotone(const std::vector<Vector2> &points, const std::vector<size_t> &face, std::vector<love::uint32> &indices)
+{
+	size_t k = face.size();
+	if (k < 3)
+		throw love::Exception("Cannot triangulate polygon.");
+
+	size_t top = 0, bottom = 0;
+	for (size_t i = 1; i < k; i++)
+	{
+		if (is_above(points[face[i]], points[face[top]]))
+			top = i;
+		if (is_above(points[face[bottom]], points[face[i]]))
+			bottom = i;
+	}
+
+	// Walking forward from the top vertex follows the left chain down to the
+	// bottom vertex, walking backward follows the right chain. Merge both
+	// into sweep order, remembering which chain each vertex is on.
+	std::vector<std::pair<size_t, bool>> sorted;
+	sorted.reserve(k);
+	sorted.emplace_back(face[top], true);
+
+	size_t l = (top + 1) % k;
+	size_t r = (top + k - 1) % k;
+	while (l != bottom && r != bottom)
+	{
+		if (is_above(points[face[l]], points[face[r]]))
+		{
+			sorted.emplace_back(face[l], true);
+			l = (l + 1) % k;
+		}
+		else
+		{
+			sorted.emplace_back(face[r], false);
+			r = (r + k - 1) % k;
+		}
+	}
+	for (; l != bottom; l = (l + 1) % k)
+		sorted.emplace_back(face[l], true);
+	for (; r != bottom; r = (r + k - 1) % k)
+		sorted.emplace_back(face[r], false);
+
+	size_t last = face[bottom];
+
+	std::vector<std::pair<size_t, bool>> stack = {sorted[0], sorted[1]};
+
+	for (size_t j = 2; j < sorted.size(); j++)
+	{
+		std::pair<size_t, bool> u = sorted[j];
+
+		if (u.second != stack.back().second)
+		{
+			// Connect to everything on the opposite chain.
+			for (size_t i = 0; i + 1 < stack.size(); i++)
+				add_triangle(points, u.first, stack[i].first, stack[i + 1].first, indices);
+
+			std::pair<size_t, bool> prev = stack.back();
+			stack.clear();
+			stack.push_back(prev);
+			stack.push_back(u);
+		}
+		else
+		{
+			// Cut off convex corners along the same chain.
+			std::pair<size_t, bool> popped = stack.back();
+			stack.pop_back();
+
+			while (!stack.empty())
+			{
+				size_t s = stack.back().first;
+				double c = u.second
+					? cross(points[s], points[popped.first], points[u.first])
+					: cross(points[u.first], points[popped.first], points[s]);
+
+				if (c <= 0)
+					break;
+
+				add_triangle(points, s, popped.first, u.first, indices);
+				popped = stack.back();
+				stack.pop_back();
+			}
+
+			stack.push_back(popped);
+			stack.push_back(u);
+		}
+	}
+
+	for (size_t i = 0; i + 1 < stack.size(); i++)
+		add_triangle(points, last, stack[i].first, stack[i + 1].first, indices);
+}
+
 } // anonymous namespace
 
 namespace love
@@ -152,6 +326,241 @@ std::vector<Triangle> triangulate(const std::vector<love::Vector2> &polygon)
 	return triangles;
 }
 
+void triangulate(const std::vector<love::Vector2> &vertices, const std::vector<int> &ringsizes, std::vector<uint32> &indices)
+{
+	size_t n = vertices.size();
+
+	// Link up the rings so the outer polygon winds counter clockwise (with y
+	// pointing up) and holes wind clockwise. The interior is then always to
+	// the left of each edge i -> next[i].
+	std::vector<size_t> next(n), prev(n);
+	size_t start = 0;
+
+	for (size_t ring = 0; ring < ringsizes.size(); ring++)
+	{
+		if (ringsizes[ring] < 3)
+			throw love::Exception("Polygons and holes need at least 3 vertices.");
+
+		size_t count = (size_t) ringsizes[ring];
+		if (start + count > n)
+			throw love::Exception("Polygon ring sizes don't match the vertex count.");
+
+		double area = 0.0;
+		for (size_t i = 0; i < count; i++)
+		{
+			const Vector2 &a = vertices[start + i];
+			const Vector2 &b = vertices[start + (i + 1) % count];
+			area += (double) a.x * b.y - (double) b.x * a.y;
+		}
+
+		bool reverse = ring == 0 ? area < 0 : area > 0;
+
+		for (size_t i = 0; i < count; i++)
+		{
+			size_t after = start + (i + 1) % count;
+			size_t before = start + (i + count - 1) % count;
+			next[start + i] = reverse ? before : after;
+			prev[start + i] = reverse ? after : before;
+		}
+
+		start += count;
+	}
+
+	if (start != n || n < 3)
+		throw love::Exception("Polygon ring sizes don't match the vertex count.");
+
+	std::vector<SweepVertexType> types(n);
+	for (size_t i = 0; i < n; i++)
+	{
+		const Vector2 &a = vertices[prev[i]], &b = vertices[i], &c = vertices[next[i]];
+		bool prevbelow = is_above(b, a);
+		bool nextbelow = is_above(b, c);
+		bool convex = cross(a, b, c) > 0;
+
+		if (prevbelow && nextbelow)
+			types[i] = convex ? SWEEP_VERTEX_START : SWEEP_VERTEX_SPLIT;
+		else if (!prevbelow && !nextbelow)
+			types[i] = convex ? SWEEP_VERTEX_END : SWEEP_VERTEX_MERGE;
+		else
+			types[i] = SWEEP_VERTEX_REGULAR;
+	}
+
+	std::vector<size_t> order(n);
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return is_above(vertices[a], vertices[b]); });
+
+	// Partition into monotone polygons by adding diagonals at split and merge
+	// vertices (de Berg et al., Computational Geometry, chapter 3.2).
+	typedef std::set<size_t, SweepEdgeLess> SweepStatus;
+	SweepStatus status(SweepEdgeLess {vertices.data(), next.data()});
+	std::vector<SweepStatus::iterator> statusedges(n, status.end());
+	std::vector<size_t> helper(n);
+	std::vector<std::pair<size_t, size_t>> diagonals;
+
+	auto insertedge = [&](size_t v)
+	{
+		auto result = status.insert(v);
+		if (!result.second)
+			throw love::Exception("Cannot triangulate polygon.");
+		statusedges[v] = result.first;
+		helper[v] = v;
+	};
+
+	auto removeedge = [&](size_t e, size_t v)
+	{
+		if (statusedges[e] == status.end())
+			throw love::Exception("Cannot triangulate polygon.");
+		if (types[helper[e]] == SWEEP_VERTEX_MERGE)
+			diagonals.emplace_back(v, helper[e]);
+		status.erase(statusedges[e]);
+		statusedges[e] = status.end();
+	};
+
+	auto leftedge = [&](size_t v) -> size_t
+	{
+		auto it = status.lower_bound(vertices[v]);
+		if (it == status.begin())
+			throw love::Exception("Cannot triangulate polygon.");
+		return *(--it);
+	};
+
+	for (size_t v : order)
+	{
+		switch (types[v])
+		{
+		case SWEEP_VERTEX_START:
+			insertedge(v);
+			break;
+		case SWEEP_VERTEX_END:
+			removeedge(prev[v], v);
+			break;
+		case SWEEP_VERTEX_SPLIT:
+		{
+			size_t e = leftedge(v);
+			diagonals.emplace_back(v, helper[e]);
+			helper[e] = v;
+			insertedge(v);
+			break;
+		}
+		case SWEEP_VERTEX_MERGE:
+		{
+			removeedge(prev[v], v);
+			size_t e = leftedge(v);
+			if (types[helper[e]] == SWEEP_VERTEX_MERGE)
+				diagonals.emplace_back(v, helper[e]);
+			helper[e] = v;
+			break;
+		}
+		case SWEEP_VERTEX_REGULAR:
+		default:
+			if (is_above(vertices[prev[v]], vertices[v]))
+			{
+				// The interior is to the right of v.
+				removeedge(prev[v], v);
+				insertedge(v);
+			}
+			else
+			{
+				size_t e = leftedge(v);
+				if (types[helper[e]] == SWEEP_VERTEX_MERGE)
+					diagonals.emplace_back(v, helper[e]);
+				helper[e] = v;
+			}
+			break;
+		}
+	}
+
+	// Walk the faces of the polygon edges plus both directions of each
+	// diagonal. Half-edge ids below n are polygon edges.
+	struct HalfEdge
+	{
+		size_t to;
+		size_t id;
+	};
+
+	std::vector<std::vector<HalfEdge>> diagonaledges(n);
+	for (size_t i = 0; i < diagonals.size(); i++)
+	{
+		size_t a = diagonals[i].first, b = diagonals[i].second;
+		diagonaledges[a].push_back({b, n + i * 2 + 0});
+		diagonaledges[b].push_back({a, n + i * 2 + 1});
+	}
+
+	// Leave a vertex through the first edge clockwise from the one we arrived
+	// on, which keeps the face to the left.
+	auto nexthalfedge = [&](size_t from, size_t at) -> HalfEdge
+	{
+		HalfEdge best = {next[at], at};
+		if (diagonaledges[at].empty())
+			return best;
+
+		const Vector2 &c = vertices[at];
+		double ax = (double) vertices[from].x - c.x, ay = (double) vertices[from].y - c.y;
+
+		auto clockwiseangle = [&](size_t to)
+		{
+			double bx = (double) vertices[to].x - c.x, by = (double) vertices[to].y - c.y;
+			double angle = -atan2(ax * by - ay * bx, ax * bx + ay * by);
+			return angle <= 0.0 ? angle + 2.0 * LOVE_M_PI : angle;
+		};
+
+		double bestangle = clockwiseangle(best.to);
+		for (const HalfEdge &e : diagonaledges[at])
+		{
+			double angle = clockwiseangle(e.to);
+			if (angle < bestangle)
+			{
+				best = e;
+				bestangle = angle;
+			}
+		}
+
+		return best;
+	};
+
+	std::vector<bool> visited(n + diagonals.size() * 2, false);
+	std::vector<size_t> face;
+
+	indices.clear();
+	indices.reserve((n + diagonals.size()) * 3);
+
+	auto walkface = [&](size_t from, const HalfEdge &start)
+	{
+		face.clear();
+		visited[start.id] = true;
+
+		size_t at = start.to;
+		while (true)
+		{
+			face.push_back(from);
+
+			HalfEdge e = nexthalfedge(from, at);
+			if (e.id == start.id)
+				break;
+			if (visited[e.id])
+				throw love::Exception("Cannot triangulate polygon.");
+
+			visited[e.id] = true;
+			from = at;
+			at = e.to;
+		}
+
+		triangulate_monotone(vertices, face, indices);
+	};
+
+	for (size_t i = 0; i < n; i++)
+	{
+		if (!visited[i])
+			walkface(i, {next[i], i});
+
+		for (const HalfEdge &e : diagonaledges[i])
+		{
+			if (!visited[e.id])
+				walkface(i, e);
+		}
+	}
+}
+
 bool isConvex(const std::vector<love::Vector2> &polygon)
 {
 	if (polygon.size() < 3)
@@ -177,6 +586,63 @@ bool isConvex(const std::vector<love::Vector2> &polygon)
 	return true;
 }
 
+void noiseField(NoiseType type, float *dst, int width, int firstrow, int rowcount, double x0, double y0, double dx, double dy, int octaves, double lacunarity, double gain)
+{
+	octaves = std::max(octaves, 1);
+
+	double amplitudesum = 0.0;
+	double amplitude = 1.0;
+	for (int i = 0; i < octaves; i++)
+	{
+		amplitudesum += amplitude;
+		amplitude *= gain;
+	}
+
+	double scale = amplitudesum != 0.0 ? 1.0 / amplitudesum : 0.0;
+
+	std::vector<double> row(width);
+
+	for (int y = firstrow; y < firstrow + rowcount; y++)
+	{
+		std::fill(row.begin(), row.end(), 0.0);
+
+		double frequency = 1.0;
+		amplitude = 1.0;
+
+		// One octave at a time across the row, so the noise function is picked
+		// once per octave rather than per sample.
+		for (int octave = 0; octave < octaves; octave++)
+		{
+			double py = (y0 + y * dy) * frequency;
+
+			if (type == NOISE_PERLIN)
+			{
+				for (int x = 0; x < width; x++)
+					row[x] += amplitude * Noise1234::noise((x0 + x * dx) * frequency, py);
+			}
+			else
+			{
+				for (int x = 0; x < width; x++)
+					row[x] += amplitude * SimplexNoise1234::noise((x0 + x * dx) * frequency, py);
+			}
+
+			frequency *= lacunarity;
+			amplitude *= gain;
+		}
+
+		float *out = dst + (size_t) (y - firstrow) * width;
+		for (int x = 0; x < width; x++)
+			out[x] = (float) (row[x] * scale * 0.5 + 0.5);
+	}
+}
+
+STRINGMAP_BEGIN(NoiseType, NOISE_MAX_ENUM, noiseType)
+{
+	{ "simplex", NOISE_SIMPLEX },
+	{ "perlin",  NOISE_PERLIN  },
+}
+STRINGMAP_END(NoiseType, NOISE_MAX_ENUM, noiseType)
+
 /**
  * http://en.wikipedia.org/wiki/SRGB#The_reverse_transformation
  **/
@@ -25,6 +25,7 @@
 
 // LOVE
 #include "common/Module.h"
+#include "common/StringMap.h"
 #include "common/math.h"
 #include "common/Vector.h"
 #include "common/int.h"
@@ -44,6 +45,13 @@ namespace math
 class BezierCurve;
 class Transform;
 
+enum NoiseType
+{
+	NOISE_SIMPLEX,
+	NOISE_PERLIN,
+	NOISE_MAX_ENUM
+};
+
 struct Triangle
 {
 	Triangle(const Vector2 &x, const Vector2 &y, const Vector2 &z)
@@ -60,6 +68,16 @@ struct Triangle
  **/
 std::vector<Triangle> triangulate(const std::vector<love::Vector2> &polygon);
 
+/**
+ * Triangulate a simple polygon with optional holes, in O(n log n) time using
+ * a monotone partition.
+ *
+ * @param vertices The outer polygon's vertices, followed by each hole's.
+ * @param ringsizes The vertex count of the outer polygon and of each hole.
+ * @param indices Receives three indices into vertices for each triangle.
+ **/
+void triangulate(const std::vector<love::Vector2> &vertices, const std::vector<int> &ringsizes, std::vector<uint32> &indices);
+
 /**
  * Checks whether a polygon is convex.
  *
@@ -92,6 +110,18 @@ static double perlinNoise2(double x, double y);
 static double perlinNoise3(double x, double y, double z);
 static double perlinNoise4(double x, double y, double z, double w);
 
+/**
+ * Fills dst with rows [firstrow, firstrow + rowcount) of a 2D fractal noise
+ * field, width floats per row, with values in [0, 1]. Sample (x, y) is taken
+ * at (x0 + x * dx, y0 + y * dy), so filling a field in several row ranges
+ * gives exactly the same values as filling it at once. Each octave scales
+ * the frequency by lacunarity and the amplitude by gain, and the sum is
+ * normalized so a single octave matches simplexNoise2 / perlinNoise2.
+ **/
+void noiseField(NoiseType type, float *dst, int width, int firstrow, int rowcount, double x0, double y0, double dx, double dy, int octaves, double lacunarity, double gain);
+
+STRINGMAP_DECLARE(NoiseType);
+
 
 class Math : public Module
 {
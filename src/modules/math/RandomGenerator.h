@@ -27,10 +27,12 @@
 #include "common/math.h"
 #include "common/int.h"
 #include "common/Object.h"
+#include "common/StringMap.h"
 
 // C++
 #include <limits>
 #include <string>
+#include <vector>
 
 namespace love
 {
@@ -43,6 +45,14 @@ class RandomGenerator : public Object
 
 	static love::Type type;
 
+	enum Distribution
+	{
+		DISTRIBUTION_UNIFORM,
+		DISTRIBUTION_INTEGER,
+		DISTRIBUTION_NORMAL,
+		DISTRIBUTION_MAX_ENUM
+	};
+
 	union Seed
 	{
 		uint64 b64;
@@ -112,6 +122,16 @@ class RandomGenerator : public Object
 	 **/
 	double randomNormal(double stddev);
 
+	/**
+	 * Fills an array with count pseudo random numbers, producing the same
+	 * sequence as repeated single calls with the same state.
+	 *
+	 * Uniform: 32-bit floats, as random() * (b - a) + a.
+	 * Integer: 32-bit integers, as floor(random() * (b - a + 1)) + a.
+	 * Normal: 32-bit floats, as randomNormal(a) + b.
+	 **/
+	void fill(void *dst, size_t count, Distribution distribution, double a, double b);
+
 	/**
 	 * Set pseudo-random seed.
 	 * It's up to the implementation how to use this.
@@ -134,12 +154,19 @@ class RandomGenerator : public Object
 	 **/
 	std::string getState() const;
 
+	static bool getConstant(const char *in, Distribution &out);
+	static bool getConstant(Distribution in, const char *&out);
+	static std::vector<std::string> getConstants(Distribution);
+
 private:
 
 	Seed seed;
 	Seed rng_state;
 	double last_randomnormal;
 
+	static StringMap<Distribution, DISTRIBUTION_MAX_ENUM>::Entry distributionEntries[];
+	static StringMap<Distribution, DISTRIBUTION_MAX_ENUM> distributions;
+
 }; // RandomGenerator
 
 } // math
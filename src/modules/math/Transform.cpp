@@ -118,6 +118,16 @@ love::Vector2 Transform::inverseTransformPoint(love::Vector2 p)
 	return result;
 }
 
+void Transform::transformPoints(love::Vector2 *points, int count) const
+{
+	matrix.transformXY(points, points, count);
+}
+
+void Transform::inverseTransformPoints(love::Vector2 *points, int count)
+{
+	getInverseMatrix().transformXY(points, points, count);
+}
+
 const Matrix4 &Transform::getMatrix() const
 {
 	return matrix;
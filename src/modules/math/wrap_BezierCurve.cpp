@@ -157,6 +157,31 @@ int w_BezierCurve_evaluate(lua_State *L)
 
 }
 
+int w_BezierCurve_evaluateRange(lua_State *L)
+{
+	BezierCurve *curve = luax_checkbeziercurve(L, 1);
+	double t1 = luaL_checknumber(L, 2);
+	double t2 = luaL_checknumber(L, 3);
+	int count = (int) luaL_checkinteger(L, 4);
+
+	if (count < 1)
+		return luaL_error(L, "Invalid point count: %d", count);
+
+	std::vector<Vector2> points(count);
+	luax_catchexcept(L, [&](){ curve->evaluate(t1, t2, count, points.data()); });
+
+	lua_createtable(L, count * 2, 0);
+	for (int i = 0; i < count; ++i)
+	{
+		lua_pushnumber(L, points[i].x);
+		lua_rawseti(L, -2, 2*i+1);
+		lua_pushnumber(L, points[i].y);
+		lua_rawseti(L, -2, 2*i+2);
+	}
+
+	return 1;
+}
+
 int w_BezierCurve_getSegment(lua_State *L)
 {
 	BezierCurve *curve = luax_checkbeziercurve(L, 1);
@@ -213,6 +238,29 @@ int w_BezierCurve_renderSegment(lua_State *L)
 	return 1;
 }
 
+int w_BezierCurve_renderAdaptive(lua_State *L)
+{
+	BezierCurve *curve = luax_checkbeziercurve(L, 1);
+	double tolerance = luaL_optnumber(L, 2, 0.25);
+	double t1 = luaL_optnumber(L, 3, 0.0);
+	double t2 = luaL_optnumber(L, 4, 1.0);
+
+	std::vector<Vector2> points;
+	std::vector<Vector2> scratch;
+	luax_catchexcept(L, [&](){ curve->renderAdaptive(tolerance, t1, t2, points, scratch); });
+
+	lua_createtable(L, (int) points.size() * 2, 0);
+	for (int i = 0; i < (int) points.size(); ++i)
+	{
+		lua_pushnumber(L, points[i].x);
+		lua_rawseti(L, -2, 2*i+1);
+		lua_pushnumber(L, points[i].y);
+		lua_rawseti(L, -2, 2*i+2);
+	}
+
+	return 1;
+}
+
 static const luaL_Reg w_BezierCurve_functions[] =
 {
 	{"getDegree", w_BezierCurve_getDegree},
@@ -226,9 +274,11 @@ static const luaL_Reg w_BezierCurve_functions[] =
 	{"rotate", w_BezierCurve_rotate},
 	{"scale", w_BezierCurve_scale},
 	{"evaluate", w_BezierCurve_evaluate},
+	{"evaluateRange", w_BezierCurve_evaluateRange},
 	{"getSegment", w_BezierCurve_getSegment},
 	{"render", w_BezierCurve_render},
 	{"renderSegment", w_BezierCurve_renderSegment},
+	{"renderAdaptive", w_BezierCurve_renderAdaptive},
 	{ 0, 0 }
 };
 
@@ -25,6 +25,7 @@
 #include "MathModule.h"
 #include "BezierCurve.h"
 #include "Transform.h"
+#include "image/ImageData.h"
 
 #include <cmath>
 #include <iostream>
@@ -215,6 +216,70 @@ int w_triangulate(lua_State *L)
 	return 1;
 }
 
+static void checkpolygonring(lua_State *L, int idx, std::vector<love::Vector2> &vertices, std::vector<int> &ringsizes)
+{
+	// The values pushed below would shift a relative index.
+	if (idx < 0)
+		idx = lua_gettop(L) + idx + 1;
+
+	luaL_checktype(L, idx, LUA_TTABLE);
+
+	int top = (int) luax_objlen(L, idx);
+	for (int i = 1; i <= top; i += 2)
+	{
+		lua_rawgeti(L, idx, i);
+		lua_rawgeti(L, idx, i+1);
+
+		Vector2 v;
+		v.x = (float) luaL_checknumber(L, -2);
+		v.y = (float) luaL_checknumber(L, -1);
+		vertices.push_back(v);
+
+		lua_pop(L, 2);
+	}
+
+	ringsizes.push_back(top / 2);
+}
+
+int w_triangulateIndices(lua_State *L)
+{
+	std::vector<love::Vector2> vertices;
+	std::vector<int> ringsizes;
+
+	checkpolygonring(L, 1, vertices, ringsizes);
+
+	if (ringsizes[0] < 3)
+		return luaL_error(L, "Need at least 3 vertices to triangulate (got %d).", ringsizes[0]);
+
+	if (!lua_isnoneornil(L, 2))
+	{
+		luaL_checktype(L, 2, LUA_TTABLE);
+		int holecount = (int) luax_objlen(L, 2);
+
+		for (int i = 1; i <= holecount; i++)
+		{
+			lua_rawgeti(L, 2, i);
+			checkpolygonring(L, -1, vertices, ringsizes);
+			lua_pop(L, 1);
+
+			if (ringsizes.back() < 3)
+				return luaL_error(L, "Need at least 3 vertices in hole %d (got %d).", i, ringsizes.back());
+		}
+	}
+
+	std::vector<uint32> indices;
+	luax_catchexcept(L, [&]() { triangulate(vertices, ringsizes, indices); });
+
+	lua_createtable(L, (int) indices.size(), 0);
+	for (int i = 0; i < (int) indices.size(); i++)
+	{
+		lua_pushinteger(L, (lua_Integer) indices[i] + 1);
+		lua_rawseti(L, -2, i + 1);
+	}
+
+	return 1;
+}
+
 int w_isConvex(lua_State *L)
 {
 	std::vector<love::Vector2> vertices;
@@ -408,6 +473,138 @@ int w_simplexNoise(lua_State* L)
 	return 1;
 }
 
+int w_flattenBezierCurves(lua_State *L)
+{
+	luaL_checktype(L, 1, LUA_TTABLE);
+	double tolerance = luaL_optnumber(L, 2, 0.25);
+	int count = (int) luax_objlen(L, 1);
+
+	std::vector<Vector2> points;
+	std::vector<Vector2> scratch;
+
+	lua_createtable(L, count, 0);
+
+	for (int i = 1; i <= count; i++)
+	{
+		lua_rawgeti(L, 1, i);
+		BezierCurve *curve = luax_totype<BezierCurve>(L, -1);
+		lua_pop(L, 1);
+
+		if (curve == nullptr)
+			return luaL_error(L, "Expected a BezierCurve at index %d of the curve table.", i);
+
+		// The point and scratch buffers are shared by all curves.
+		points.clear();
+		luax_catchexcept(L, [&](){ curve->renderAdaptive(tolerance, 0.0, 1.0, points, scratch); });
+
+		lua_createtable(L, (int) points.size() * 2, 0);
+		for (int j = 0; j < (int) points.size(); j++)
+		{
+			lua_pushnumber(L, points[j].x);
+			lua_rawseti(L, -2, 2*j+1);
+			lua_pushnumber(L, points[j].y);
+			lua_rawseti(L, -2, 2*j+2);
+		}
+
+		lua_rawseti(L, -2, i);
+	}
+
+	return 1;
+}
+
+int w_noiseField(lua_State *L)
+{
+	const char *typestr = luaL_checkstring(L, 1);
+	NoiseType type = NOISE_MAX_ENUM;
+	if (!getConstant(typestr, type))
+		return luax_enumerror(L, "noise type", getConstants(type), typestr);
+
+	image::ImageData *imagedata = luax_totype<image::ImageData>(L, 2);
+	love::Data *data = nullptr;
+
+	int width = 0;
+	int height = 0;
+	int startidx = 3;
+
+	if (imagedata != nullptr)
+	{
+		if (imagedata->getPixelSetFunction() == nullptr)
+			return luaL_error(L, "love.math.noiseField does not support the %s pixel format.", getPixelFormatName(imagedata->getFormat()));
+
+		width = imagedata->getWidth();
+		height = imagedata->getHeight();
+	}
+	else
+	{
+		// Data of 32-bit floats, with the row width as an extra argument.
+		data = luax_checktype<love::Data>(L, 2);
+		width = (int) luaL_checkinteger(L, 3);
+		if (width <= 0)
+			return luaL_error(L, "Invalid noise field width: %d", width);
+		height = (int) (data->getSize() / (sizeof(float) * width));
+		startidx = 4;
+	}
+
+	double x0 = luaL_checknumber(L, startidx + 0);
+	double y0 = luaL_checknumber(L, startidx + 1);
+	double dx = luaL_checknumber(L, startidx + 2);
+	double dy = luaL_checknumber(L, startidx + 3);
+	int octaves = (int) luaL_optinteger(L, startidx + 4, 1);
+	double lacunarity = luaL_optnumber(L, startidx + 5, 2.0);
+	double gain = luaL_optnumber(L, startidx + 6, 0.5);
+
+	if (octaves < 1)
+		return luaL_error(L, "Invalid octave count: %d", octaves);
+
+	// A Data smaller than one row has nothing to fill.
+	if (height == 0)
+		return 0;
+
+	// An optional 1-based row range, so several threads sharing the target can
+	// each fill part of it.
+	int firstrow = (int) luaL_optinteger(L, startidx + 7, 1) - 1;
+	if (firstrow < 0 || firstrow >= height)
+		return luaL_error(L, "Invalid first row: %d (must be between 1 and %d)", firstrow + 1, height);
+
+	int rowcount = (int) luaL_optinteger(L, startidx + 8, height - firstrow);
+	if (rowcount <= 0 || rowcount > height - firstrow)
+		return luaL_error(L, "Invalid row count: %d (must be between 1 and %d)", rowcount, height - firstrow);
+
+	if (data != nullptr)
+	{
+		float *dst = (float *) data->getData() + (size_t) firstrow * width;
+		noiseField(type, dst, width, firstrow, rowcount, x0, y0, dx, dy, octaves, lacunarity, gain);
+		return 0;
+	}
+
+	// Generate a row at a time and convert it to the ImageData's format. The
+	// ImageData is only locked while a row is written, so threads filling
+	// different row ranges mostly generate noise in parallel.
+	auto setpixel = imagedata->getPixelSetFunction();
+	size_t pixelsize = imagedata->getPixelSize();
+	uint8 *pixels = (uint8 *) imagedata->getData();
+	std::vector<float> row(width);
+
+	luax_catchexcept(L, [&]()
+	{
+		for (int y = firstrow; y < firstrow + rowcount; y++)
+		{
+			noiseField(type, row.data(), width, y, 1, x0, y0, dx, dy, octaves, lacunarity, gain);
+
+			love::thread::Lock lock(imagedata->getMutex());
+
+			uint8 *rowpixels = pixels + (size_t) y * width * pixelsize;
+			for (int x = 0; x < width; x++)
+			{
+				Colorf c(row[x], row[x], row[x], 1.0f);
+				setpixel(c, (image::ImageData::Pixel *) (rowpixels + x * pixelsize));
+			}
+		}
+	});
+
+	return 0;
+}
+
 // C functions in a struct, necessary for the FFI versions of math functions.
 struct FFI_Math
 {
@@ -450,6 +647,9 @@ static const luaL_Reg functions[] =
 	{ "newBezierCurve", w_newBezierCurve },
 	{ "newTransform", w_newTransform },
 	{ "triangulate", w_triangulate },
+	{ "triangulateIndices", w_triangulateIndices },
+	{ "noiseField", w_noiseField },
+	{ "flattenBezierCurves", w_flattenBezierCurves },
 	{ "isConvex", w_isConvex },
 	{ "gammaToLinear", w_gammaToLinear },
 	{ "linearToGamma", w_linearToGamma },
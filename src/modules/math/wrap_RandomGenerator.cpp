@@ -19,6 +19,7 @@
  **/
 
 #include "wrap_RandomGenerator.h"
+#include "common/Data.h"
 
 #include <cmath>
 #include <algorithm>
@@ -85,6 +86,57 @@ int w_RandomGenerator_randomNormal(lua_State *L)
 	return 1;
 }
 
+int w_RandomGenerator_fill(lua_State *L)
+{
+	RandomGenerator *rng = luax_checkrandomgenerator(L, 1);
+	love::Data *data = luax_checktype<love::Data>(L, 2);
+
+	// All distributions produce 4-byte values.
+	size_t maxcount = data->getSize() / 4;
+	lua_Integer count = luaL_optinteger(L, 3, (lua_Integer) maxcount);
+	if (count < 0 || (size_t) count > maxcount)
+		return luaL_error(L, "Invalid count %d (the Data can hold at most %d values.)", (int) count, (int) maxcount);
+
+	RandomGenerator::Distribution distribution = RandomGenerator::DISTRIBUTION_UNIFORM;
+	if (!lua_isnoneornil(L, 4))
+	{
+		const char *str = luaL_checkstring(L, 4);
+		if (!RandomGenerator::getConstant(str, distribution))
+			return luax_enumerror(L, "random distribution", RandomGenerator::getConstants(distribution), str);
+	}
+
+	double a = 0.0;
+	double b = 0.0;
+
+	if (distribution == RandomGenerator::DISTRIBUTION_UNIFORM)
+	{
+		a = luaL_optnumber(L, 5, 0.0);
+		b = luaL_optnumber(L, 6, 1.0);
+	}
+	else if (distribution == RandomGenerator::DISTRIBUTION_INTEGER)
+	{
+		// Same argument handling as RandomGenerator:random(min, max).
+		if (lua_isnoneornil(L, 6))
+		{
+			a = 1.0;
+			b = luaL_checknumber(L, 5);
+		}
+		else
+		{
+			a = luaL_checknumber(L, 5);
+			b = luaL_checknumber(L, 6);
+		}
+	}
+	else if (distribution == RandomGenerator::DISTRIBUTION_NORMAL)
+	{
+		a = luaL_optnumber(L, 5, 1.0);
+		b = luaL_optnumber(L, 6, 0.0);
+	}
+
+	rng->fill(data->getData(), (size_t) count, distribution, a, b);
+	return 0;
+}
+
 int w_RandomGenerator_setSeed(lua_State *L)
 {
 	RandomGenerator *rng = luax_checkrandomgenerator(L, 1);
@@ -141,6 +193,7 @@ static const luaL_Reg w_RandomGenerator_functions[] =
 {
 	{ "_random", w_RandomGenerator__random }, // random() is defined in wrap_RandomGenerator.lua.
 	{ "randomNormal", w_RandomGenerator_randomNormal },
+	{ "fill", w_RandomGenerator_fill },
 	{ "setSeed", w_RandomGenerator_setSeed },
 	{ "getSeed", w_RandomGenerator_getSeed },
 	{ "setState", w_RandomGenerator_setState },
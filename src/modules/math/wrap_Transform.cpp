@@ -19,6 +19,11 @@
  **/
 
 #include "wrap_Transform.h"
+#include "common/Data.h"
+
+// C++
+#include <algorithm>
+#include <vector>
 
 namespace love
 {
@@ -293,6 +298,73 @@ int w_Transform_inverseTransformPoint(lua_State *L)
 	return 2;
 }
 
+static int transformPoints(lua_State *L, bool inverse)
+{
+	Transform *t = luax_checktransform(L, 1);
+
+	if (lua_istable(L, 2))
+	{
+		// Flat table of x, y pairs, written back in place.
+		int count = (int) luax_objlen(L, 2) / 2;
+		if (!lua_isnoneornil(L, 3))
+			count = std::min(count, (int) luaL_checkinteger(L, 3));
+
+		std::vector<love::Vector2> points(std::max(count, 0));
+
+		for (int i = 0; i < count; i++)
+		{
+			lua_rawgeti(L, 2, i * 2 + 1);
+			lua_rawgeti(L, 2, i * 2 + 2);
+			points[i].x = (float) luaL_checknumber(L, -2);
+			points[i].y = (float) luaL_checknumber(L, -1);
+			lua_pop(L, 2);
+		}
+
+		if (inverse)
+			t->inverseTransformPoints(points.data(), count);
+		else
+			t->transformPoints(points.data(), count);
+
+		for (int i = 0; i < count; i++)
+		{
+			lua_pushnumber(L, points[i].x);
+			lua_rawseti(L, 2, i * 2 + 1);
+			lua_pushnumber(L, points[i].y);
+			lua_rawseti(L, 2, i * 2 + 2);
+		}
+	}
+	else
+	{
+		// Packed 32-bit float x, y pairs, transformed in place.
+		love::Data *data = luax_checktype<love::Data>(L, 2);
+
+		size_t maxcount = data->getSize() / sizeof(love::Vector2);
+		int count = (int) luaL_optinteger(L, 3, (lua_Integer) maxcount);
+
+		if (count < 0 || (size_t) count > maxcount)
+			return luaL_error(L, "Invalid point count %d (the Data can hold at most %d points.)", count, (int) maxcount);
+
+		love::Vector2 *points = (love::Vector2 *) data->getData();
+
+		if (inverse)
+			t->inverseTransformPoints(points, count);
+		else
+			t->transformPoints(points, count);
+	}
+
+	return 0;
+}
+
+int w_Transform_transformPoints(lua_State *L)
+{
+	return transformPoints(L, false);
+}
+
+int w_Transform_inverseTransformPoints(lua_State *L)
+{
+	return transformPoints(L, true);
+}
+
 int w_Transform__mul(lua_State *L)
 {
 	Transform *t1 = luax_checktransform(L, 1);
@@ -320,6 +392,8 @@ static const luaL_Reg functions[] =
 	{ "getMatrix", w_Transform_getMatrix },
 	{ "transformPoint", w_Transform_transformPoint },
 	{ "inverseTransformPoint", w_Transform_inverseTransformPoint },
+	{ "transformPoints", w_Transform_transformPoints },
+	{ "inverseTransformPoints", w_Transform_inverseTransformPoints },
 	{ "__mul", w_Transform__mul },
 	{ 0, 0 }
 };
@@ -29,16 +29,20 @@ namespace sound
 
 love::Type Decoder::type("Decoder", &Object::type);
 
-Decoder::Decoder(Stream *stream, int bufferSize)
+Decoder::Decoder(Stream *stream, int bufferSize, int bitDepth)
 	: stream(stream)
 	, bufferSize(bufferSize)
 	, sampleRate(DEFAULT_SAMPLE_RATE)
+	, bitDepth(bitDepth)
 	, buffer(0)
 	, eof(false)
 {
 	if (!stream->isReadable() || !stream->isSeekable())
 		throw love::Exception("Decoder input stream must be readable and seekable.");
 
+	if (bitDepth != 16 && bitDepth != 32)
+		throw love::Exception("Invalid decoder bit depth: %d", bitDepth);
+
 	try
 	{
 		buffer = new char[bufferSize];
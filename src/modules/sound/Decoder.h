@@ -49,7 +49,7 @@ class Decoder : public Object
 
 	static love::Type type;
 
-	Decoder(Stream *stream, int bufferSize);
+	Decoder(Stream *stream, int bufferSize, int bitDepth);
 	virtual ~Decoder();
 
 	/**
@@ -69,7 +69,7 @@ class Decoder : public Object
 	static const int DEFAULT_CHANNELS = 2;
 
 	/**
-	 * 16 bit audio is the default.
+	 * 16 bit audio is the default. 32 bit decodes to floating point samples.
 	 **/
 	static const int DEFAULT_BIT_DEPTH = 16;
 
@@ -134,8 +134,9 @@ class Decoder : public Object
 	virtual int getChannelCount() const = 0;
 
 	/**
-	 * Gets the number of bits per sample. Supported values are 8 or 16.
-	 * @return Either 8, 16, or 0 if unsupported.
+	 * Gets the number of bits per sample. Supported values are 8, 16, or 32
+	 * (floating point).
+	 * @return Either 8, 16, 32, or 0 if unsupported.
 	 **/
 	virtual int getBitDepth() const = 0;
 
@@ -151,6 +152,14 @@ class Decoder : public Object
 	 **/
 	virtual double getDuration() = 0;
 
+	/**
+	 * Does slow one-time work which getDuration and seek would otherwise do
+	 * on their first call, such as scanning the whole stream. It doesn't
+	 * change the decoding position, and it can be called while another thread
+	 * is using the Decoder.
+	 **/
+	virtual void prepareSeeking() {}
+
 	STRINGMAP_CLASS_DECLARE(StreamSource);
 
 protected:
@@ -165,6 +174,10 @@ class Decoder : public Object
 	// The desired frequency of the samples. 44100, 22050, or 11025.
 	int sampleRate;
 
+	// The requested sample format. 16 for integer PCM (which may also produce
+	// 8 bit data for 8 bit sources), or 32 for floating point.
+	int bitDepth;
+
 	// Holds internal memory.
 	void *buffer;
 
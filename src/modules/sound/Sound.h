@@ -59,7 +59,7 @@ class Sound : public Module
 	 * Creates a new SoundData with the specified number of samples and format.
 	 * @param samples The number of samples.
 	 * @param sampleRate Number of samples per second.
-	 * @param bitDepth Bits per sample (8 or 16).
+	 * @param bitDepth Bits per sample (8, 16, or 32 for floats).
 	 * @param channels Either 1 for mono, or 2 for stereo.
 	 * @return A new SoundData object, or zero in case of errors.
 	 **/
@@ -71,7 +71,7 @@ class Sound : public Module
 	 * @param data Buffer to load data from.
 	 * @param samples The number of samples.
 	 * @param sampleRate Number of samples per second.
-	 * @param bitDepth Bits per sample (8 or 16).
+	 * @param bitDepth Bits per sample (8, 16, or 32 for floats).
 	 * @param channels Either 1 for mono, or 2 for stereo.
 	 * @return A new SoundData object, or zero in case of errors.
 	 **/
@@ -82,9 +82,10 @@ class Sound : public Module
 	 * specified file.
 	 * @param stream The readable Stream with encoded sound data.
 	 * @param bufferSize The size of each decoded chunk.
+	 * @param bitDepth The sample format to decode to (16, or 32 for floats).
 	 * @return A Decoder object on success, or zero if no decoder could be found.
 	 **/
-	virtual Decoder *newDecoder(Stream *stream, int bufferSize) = 0;
+	virtual Decoder *newDecoder(Stream *stream, int bufferSize, int bitDepth) = 0;
 
 protected:
 
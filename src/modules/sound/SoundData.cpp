@@ -23,8 +23,10 @@
 // C
 #include <cstdlib>
 #include <cstring>
+#include <cmath>
 
 // C++
+#include <algorithm>
 #include <limits>
 #include <iostream>
 #include <vector>
@@ -36,6 +38,52 @@ namespace sound
 
 love::Type SoundData::type("SoundData", &Data::type);
 
+// Number of samples processed at a time by the bulk operations below.
+static const size_t CHUNK_SAMPLES = 1024;
+
+static bool isValidBitDepth(int bitDepth)
+{
+	return bitDepth == 8 || bitDepth == 16 || bitDepth == 32;
+}
+
+// Converts interleaved samples to normalized floats. These loops are kept
+// trivial so the compiler can vectorize them.
+static void samplesToFloat(const uint8 *src, int bitDepth, float *dst, size_t count)
+{
+	if (bitDepth == 32)
+		memcpy(dst, src, count * sizeof(float));
+	else if (bitDepth == 16)
+	{
+		const int16 *s = (const int16 *) src;
+		for (size_t i = 0; i < count; i++)
+			dst[i] = (float) s[i] / (float) LOVE_INT16_MAX;
+	}
+	else
+	{
+		for (size_t i = 0; i < count; i++)
+			dst[i] = ((float) src[i] - 128.0f) / 127.0f;
+	}
+}
+
+// Converts normalized floats back to interleaved samples, saturating integer
+// formats.
+static void floatToSamples(const float *src, uint8 *dst, int bitDepth, size_t count)
+{
+	if (bitDepth == 32)
+		memcpy(dst, src, count * sizeof(float));
+	else if (bitDepth == 16)
+	{
+		int16 *d = (int16 *) dst;
+		for (size_t i = 0; i < count; i++)
+			d[i] = (int16) (std::min(std::max(src[i], -1.0f), 1.0f) * (float) LOVE_INT16_MAX);
+	}
+	else
+	{
+		for (size_t i = 0; i < count; i++)
+			dst[i] = (uint8) ((std::min(std::max(src[i], -1.0f), 1.0f) * 127.0f) + 128.0f);
+	}
+}
+
 SoundData::SoundData(Decoder *decoder)
 	: data(0)
 	, size(0)
@@ -43,7 +91,7 @@ SoundData::SoundData(Decoder *decoder)
 	, bitDepth(0)
 	, channels(0)
 {
-	if (decoder->getBitDepth() != 8 && decoder->getBitDepth() != 16)
+	if (!isValidBitDepth(decoder->getBitDepth()))
 		throw love::Exception("Invalid bit depth: %d", decoder->getBitDepth());
 
 	size_t bufferSize = 524288; // 0x80000
@@ -137,7 +185,7 @@ void SoundData::load(int samples, int sampleRate, int bitDepth, int channels, co
 	if (sampleRate <= 0)
 		throw love::Exception("Invalid sample rate: %d", sampleRate);
 
-	if (bitDepth != 8 && bitDepth != 16)
+	if (!isValidBitDepth(bitDepth))
 		throw love::Exception("Invalid bit depth: %d", bitDepth);
 
 	if (channels <= 0)
@@ -210,7 +258,13 @@ void SoundData::setSample(int i, float sample)
 	if (i < 0 || (size_t) i >= size/(bitDepth/8))
 		throw love::Exception("Attempt to set out-of-range sample!");
 
-	if (bitDepth == 16)
+	if (bitDepth == 32)
+	{
+		// 32-bit sample values are floats.
+		float *s = (float *) data;
+		s[i] = sample;
+	}
+	else if (bitDepth == 16)
 	{
 		// 16-bit sample values are signed.
 		int16 *s = (int16 *) data;
@@ -237,7 +291,13 @@ float SoundData::getSample(int i) const
 	if (i < 0 || (size_t) i >= size/(bitDepth/8))
 		throw love::Exception("Attempt to get out-of-range sample!");
 
-	if (bitDepth == 16)
+	if (bitDepth == 32)
+	{
+		// 32-bit sample values are floats.
+		const float *s = (const float *) data;
+		return s[i];
+	}
+	else if (bitDepth == 16)
 	{
 		// 16-bit sample values are signed.
 		int16 *s = (int16 *) data;
@@ -267,22 +327,37 @@ void SoundData::copyFrom(const SoundData *src, int srcStart, int count, int dstS
 	size_t srcBytesPerSample = (size_t) src->channels * src->bitDepth/8;
 	
 	// Check range
-	if (dstStart < 0 || (dstStart+count) * bytesPerSample > size)
+	if (count < 0)
+		throw love::Exception("Invalid sample count: %d", count);
+	if (dstStart < 0 || (uint64) ((int64) dstStart + count) * bytesPerSample > size)
 		throw love::Exception("Destination out-of-range!");
-	if (srcStart < 0 || (srcStart+count) * srcBytesPerSample > src->size)
+	if (srcStart < 0 || (uint64) ((int64) srcStart + count) * srcBytesPerSample > src->size)
 		throw love::Exception("Source out-of-range!");
 
+	const uint8 *srcData = src->data + (size_t) srcStart * srcBytesPerSample;
+	uint8 *dstData = data + (size_t) dstStart * bytesPerSample;
+
 	if (bitDepth != src->bitDepth)
 	{
-		// Bit depth mismatch, use get/setSample at loop
-		for (int i = 0; i < count * channels; i++)
-			setSample(dstStart * channels + i, src->getSample(srcStart * channels + i));
+		// Bit depth mismatch, convert through floats. Integer formats saturate
+		// instead of wrapping around.
+		size_t total = (size_t) count * channels;
+		int dstSampleSize = bitDepth / 8;
+		int srcSampleSize = src->bitDepth / 8;
+		float chunk[CHUNK_SAMPLES];
+
+		for (size_t i = 0; i < total; i += CHUNK_SAMPLES)
+		{
+			size_t n = std::min(CHUNK_SAMPLES, total - i);
+			samplesToFloat(srcData + i * srcSampleSize, src->bitDepth, chunk, n);
+			floatToSamples(chunk, dstData + i * dstSampleSize, bitDepth, n);
+		}
 	}
 	else if (this->data == src->data)
 		// May overlap, use memmove
-		memmove(data + dstStart * bytesPerSample, src->data + srcStart * bytesPerSample, count * bytesPerSample);
+		memmove(dstData, srcData, (size_t) count * bytesPerSample);
 	else
-		memcpy(data + dstStart * bytesPerSample, src->data + srcStart * bytesPerSample, count * bytesPerSample);
+		memcpy(dstData, srcData, (size_t) count * bytesPerSample);
 }
 
 SoundData *SoundData::slice(int start, int length) const
@@ -300,5 +375,208 @@ SoundData *SoundData::slice(int start, int length) const
 	return new SoundData(data + start * channels * bitDepth/8, length, sampleRate, bitDepth, channels);
 }
 
+void SoundData::mix(const SoundData *src, int srcStart, int count, int dstStart, float gain)
+{
+	if (channels != src->channels)
+		throw love::Exception("Channel count mismatch!");
+
+	size_t bytesPerSample = (size_t) channels * bitDepth/8;
+	size_t srcBytesPerSample = (size_t) src->channels * src->bitDepth/8;
+
+	// Check range. The ends are computed in 64 bits so a large count can't
+	// wrap around.
+	if (count < 0)
+		throw love::Exception("Invalid sample count: %d", count);
+	if (dstStart < 0 || (uint64) ((int64) dstStart + count) * bytesPerSample > size)
+		throw love::Exception("Destination out-of-range!");
+	if (srcStart < 0 || (uint64) ((int64) srcStart + count) * srcBytesPerSample > src->size)
+		throw love::Exception("Source out-of-range!");
+
+	size_t total = (size_t) count * channels;
+
+	if (bitDepth == 32 && src->bitDepth == 32)
+	{
+		float *d = (float *) data + (size_t) dstStart * channels;
+		const float *s = (const float *) src->data + (size_t) srcStart * channels;
+
+		// Mixing a SoundData region into itself may overlap.
+		if (this->data == src->data && s < d && s + total > d)
+		{
+			for (size_t i = total; i > 0; i--)
+				d[i - 1] += s[i - 1] * gain;
+		}
+		else
+		{
+			for (size_t i = 0; i < total; i++)
+				d[i] += s[i] * gain;
+		}
+		return;
+	}
+
+	// Overlapping integer data is mixed from a copy of the source.
+	std::vector<uint8> srcCopy;
+	const uint8 *srcData = src->data + (size_t) srcStart * srcBytesPerSample;
+	if (this->data == src->data)
+	{
+		srcCopy.assign(srcData, srcData + (size_t) count * srcBytesPerSample);
+		srcData = srcCopy.data();
+	}
+
+	uint8 *dstData = data + (size_t) dstStart * bytesPerSample;
+	int dstSampleSize = bitDepth / 8;
+	int srcSampleSize = src->bitDepth / 8;
+
+	float dstChunk[CHUNK_SAMPLES];
+	float srcChunk[CHUNK_SAMPLES];
+
+	for (size_t i = 0; i < total; i += CHUNK_SAMPLES)
+	{
+		size_t n = std::min(CHUNK_SAMPLES, total - i);
+
+		samplesToFloat(dstData + i * dstSampleSize, bitDepth, dstChunk, n);
+		samplesToFloat(srcData + i * srcSampleSize, src->bitDepth, srcChunk, n);
+
+		for (size_t j = 0; j < n; j++)
+			dstChunk[j] += srcChunk[j] * gain;
+
+		floatToSamples(dstChunk, dstData + i * dstSampleSize, bitDepth, n);
+	}
+}
+
+void SoundData::applyGain(float gain, int start, int count)
+{
+	int totalSamples = getSampleCount();
+
+	if (count < 0)
+		count = totalSamples - start;
+
+	if (start < 0 || count < 0 || (int64) start + count > totalSamples)
+		throw love::Exception("Attempt to apply gain to out-of-range samples!");
+
+	size_t total = (size_t) count * channels;
+	int sampleSize = bitDepth / 8;
+	uint8 *d = data + (size_t) start * channels * sampleSize;
+
+	if (bitDepth == 32)
+	{
+		float *f = (float *) d;
+		for (size_t i = 0; i < total; i++)
+			f[i] *= gain;
+		return;
+	}
+
+	float chunk[CHUNK_SAMPLES];
+
+	for (size_t i = 0; i < total; i += CHUNK_SAMPLES)
+	{
+		size_t n = std::min(CHUNK_SAMPLES, total - i);
+
+		samplesToFloat(d + i * sampleSize, bitDepth, chunk, n);
+
+		for (size_t j = 0; j < n; j++)
+			chunk[j] *= gain;
+
+		floatToSamples(chunk, d + i * sampleSize, bitDepth, n);
+	}
+}
+
+SoundData *SoundData::resample(int newSampleRate) const
+{
+	if (newSampleRate <= 0)
+		throw love::Exception("Invalid sample rate: %d", newSampleRate);
+
+	int srcCount = getSampleCount();
+	double ratio = (double) sampleRate / (double) newSampleRate;
+	int64 dstCount = (int64) std::ceil((double) srcCount / ratio);
+
+	if (dstCount <= 0 || dstCount > std::numeric_limits<int>::max())
+		throw love::Exception("Invalid sample count: %lld", (long long) dstCount);
+
+	std::vector<float> src((size_t) srcCount * channels);
+	samplesToFloat(data, bitDepth, src.data(), src.size());
+
+	std::vector<float> dst((size_t) dstCount * channels);
+
+	for (int64 i = 0; i < dstCount; i++)
+	{
+		double pos = (double) i * ratio;
+		int64 i0 = std::min((int64) pos, (int64) srcCount - 1);
+		int64 i1 = std::min(i0 + 1, (int64) srcCount - 1);
+		float t = (float) (pos - (double) i0);
+
+		const float *a = &src[i0 * channels];
+		const float *b = &src[i1 * channels];
+		float *out = &dst[i * channels];
+
+		for (int c = 0; c < channels; c++)
+			out[c] = a[c] + (b[c] - a[c]) * t;
+	}
+
+	SoundData *resampled = new SoundData((int) dstCount, newSampleRate, bitDepth, channels);
+	floatToSamples(dst.data(), resampled->data, bitDepth, dst.size());
+	return resampled;
+}
+
+SoundData *SoundData::convert(int newBitDepth, int newChannels) const
+{
+	if (!isValidBitDepth(newBitDepth))
+		throw love::Exception("Invalid bit depth: %d", newBitDepth);
+
+	if (newChannels <= 0)
+		throw love::Exception("Invalid channel count: %d", newChannels);
+
+	int count = getSampleCount();
+	SoundData *converted = new SoundData(count, sampleRate, newBitDepth, newChannels);
+
+	size_t framesPerChunk = std::max<size_t>(CHUNK_SAMPLES / std::max(channels, newChannels), 1);
+	std::vector<float> src(framesPerChunk * channels);
+	std::vector<float> dst(framesPerChunk * newChannels);
+
+	int srcSampleSize = bitDepth / 8;
+	int dstSampleSize = newBitDepth / 8;
+
+	for (size_t frame = 0; frame < (size_t) count; frame += framesPerChunk)
+	{
+		size_t n = std::min(framesPerChunk, (size_t) count - frame);
+
+		samplesToFloat(data + frame * channels * srcSampleSize, bitDepth, src.data(), n * channels);
+
+		if (newChannels == channels)
+			std::copy(src.begin(), src.begin() + n * channels, dst.begin());
+		else if (newChannels == 1)
+		{
+			float scale = 1.0f / (float) channels;
+			for (size_t i = 0; i < n; i++)
+			{
+				float sum = 0.0f;
+				for (int c = 0; c < channels; c++)
+					sum += src[i * channels + c];
+				dst[i] = sum * scale;
+			}
+		}
+		else if (channels == 1)
+		{
+			for (size_t i = 0; i < n; i++)
+			{
+				for (int c = 0; c < newChannels; c++)
+					dst[i * newChannels + c] = src[i];
+			}
+		}
+		else
+		{
+			int shared = std::min(channels, newChannels);
+			for (size_t i = 0; i < n; i++)
+			{
+				for (int c = 0; c < newChannels; c++)
+					dst[i * newChannels + c] = c < shared ? src[i * channels + c] : 0.0f;
+			}
+		}
+
+		floatToSamples(dst.data(), converted->data + frame * newChannels * dstSampleSize, newBitDepth, n * newChannels);
+	}
+
+	return converted;
+}
+
 } // sound
 } // love
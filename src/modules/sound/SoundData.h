@@ -61,9 +61,38 @@ class SoundData : public love::Data
 	float getSample(int i) const;
 	float getSample(int i, int channel) const;
 
+	/**
+	 * Replaces samples with ones from another SoundData. Integer formats
+	 * saturate when the bit depths differ.
+	 **/
 	void copyFrom(const SoundData *src, int srcStart, int count, int dstStart);
 	SoundData *slice(int start, int length = -1) const;
 
+	/**
+	 * Adds samples from another SoundData (scaled by gain) to this one's.
+	 * Integer formats saturate instead of wrapping around.
+	 **/
+	void mix(const SoundData *src, int srcStart, int count, int dstStart, float gain);
+
+	/**
+	 * Multiplies a range of samples by the given gain. A negative count means
+	 * all samples after the start.
+	 **/
+	void applyGain(float gain, int start = 0, int count = -1);
+
+	/**
+	 * Creates a new SoundData with the given sample rate, using linear
+	 * interpolation between the original samples.
+	 **/
+	SoundData *resample(int sampleRate) const;
+
+	/**
+	 * Creates a new SoundData with a different sample format and/or channel
+	 * count. Down-mixing to mono averages all channels, up-mixing from mono
+	 * duplicates the channel, other conversions keep the shared channels.
+	 **/
+	SoundData *convert(int bitDepth, int channels) const;
+
 private:
 
 	void load(int samples, int sampleRate, int bitDepth, int channels, const void *newData = 0);
@@ -50,8 +50,8 @@ static SInt64 getSizeFunc(void *inClientData)
 	return stream->getSize();
 }
 
-CoreAudioDecoder::CoreAudioDecoder(Stream *stream, int bufferSize)
-	: Decoder(stream, bufferSize)
+CoreAudioDecoder::CoreAudioDecoder(Stream *stream, int bufferSize, int bitDepth)
+	: Decoder(stream, bufferSize, bitDepth)
 	, audioFile(nullptr)
 	, extAudioFile(nullptr)
 	, inputInfo()
@@ -80,12 +80,15 @@ CoreAudioDecoder::CoreAudioDecoder(Stream *stream, int bufferSize)
 		if (err != noErr)
 			throw love::Exception("Could not determine CoreAudio file format.");
 
-		// Set the output format to 16 bit signed integer (native-endian) data.
+		// Set the output format to 16 bit signed integer (native-endian) data,
+		// or 32 bit floats if requested.
 		// Keep the channel count and sample rate of the source format.
 		outputInfo.mSampleRate = inputInfo.mSampleRate;
 		outputInfo.mChannelsPerFrame = inputInfo.mChannelsPerFrame;
 
 		int bytes = (inputInfo.mBitsPerChannel == 8) ? 1 : 2;
+		if (bitDepth == 32)
+			bytes = 4;
 
 		outputInfo.mFormatID = kAudioFormatLinearPCM;
 		outputInfo.mBitsPerChannel = bytes * 8;
@@ -94,9 +97,11 @@ CoreAudioDecoder::CoreAudioDecoder(Stream *stream, int bufferSize)
 		outputInfo.mBytesPerPacket = bytes * outputInfo.mChannelsPerFrame;
 		outputInfo.mFormatFlags = kAudioFormatFlagsNativeEndian | kAudioFormatFlagIsPacked;
 
-		// unsigned 8-bit or signed 16-bit integer PCM data.
+		// unsigned 8-bit or signed 16-bit integer PCM data, or float data.
 		if (outputInfo.mBitsPerChannel == 16)
 			outputInfo.mFormatFlags |= kAudioFormatFlagIsSignedInteger;
+		else if (outputInfo.mBitsPerChannel == 32)
+			outputInfo.mFormatFlags |= kAudioFormatFlagIsFloat;
 
 		// Set the desired output format.
 		propertySize = sizeof(outputInfo);
@@ -133,7 +138,7 @@ void CoreAudioDecoder::closeAudioFile()
 love::sound::Decoder *CoreAudioDecoder::clone()
 {
 	StrongRef<Stream> s(stream->clone(), Acquire::NORETAIN);
-	return new CoreAudioDecoder(s, bufferSize);
+	return new CoreAudioDecoder(s, bufferSize, bitDepth);
 }
 
 int CoreAudioDecoder::decode()
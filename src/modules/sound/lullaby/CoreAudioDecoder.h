@@ -47,7 +47,7 @@ class CoreAudioDecoder : public Decoder
 {
 public:
 
-	CoreAudioDecoder(Stream *stream, int bufferSize);
+	CoreAudioDecoder(Stream *stream, int bufferSize, int bitDepth);
 	virtual ~CoreAudioDecoder();
 
 	love::sound::Decoder *clone() override;
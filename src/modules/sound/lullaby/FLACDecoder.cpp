@@ -46,8 +46,8 @@ static drflac_bool32 onSeek(void* pUserData, int offset, drflac_seek_origin orig
 	return stream->seek(offset, seekorigin) ? DRFLAC_TRUE : DRFLAC_FALSE;
 }
 
-FLACDecoder::FLACDecoder(Stream *stream, int nbufferSize)
-	: Decoder(stream, nbufferSize)
+FLACDecoder::FLACDecoder(Stream *stream, int nbufferSize, int bitDepth)
+	: Decoder(stream, nbufferSize, bitDepth)
 {
 	flac = drflac_open(onRead, onSeek, stream, nullptr);
 	if (flac == nullptr)
@@ -62,14 +62,22 @@ FLACDecoder::~FLACDecoder()
 love::sound::Decoder *FLACDecoder::clone()
 {
 	StrongRef<Stream> s(stream->clone(), Acquire::NORETAIN);
-	return new FLACDecoder(s, bufferSize);
+	return new FLACDecoder(s, bufferSize, bitDepth);
 }
 
 int FLACDecoder::decode()
 {
-	// `bufferSize` is in bytes, so divide by 2.
-	drflac_uint64 read = drflac_read_pcm_frames_s16(flac, bufferSize / 2 / flac->channels, (drflac_int16 *) buffer);
-	read *= 2 * flac->channels;
+	// `bufferSize` is in bytes, so divide by the sample size.
+	int sampleSize = bitDepth / 8;
+	drflac_uint64 maxRead = bufferSize / sampleSize / flac->channels;
+	drflac_uint64 read = 0;
+
+	if (bitDepth == 32)
+		read = drflac_read_pcm_frames_f32(flac, maxRead, (float *) buffer);
+	else
+		read = drflac_read_pcm_frames_s16(flac, maxRead, (drflac_int16 *) buffer);
+
+	read *= sampleSize * flac->channels;
 
 	if ((int) read < bufferSize)
 		eof = true;
@@ -105,7 +113,7 @@ int FLACDecoder::getChannelCount() const
 
 int FLACDecoder::getBitDepth() const
 {
-	return 16;
+	return bitDepth;
 }
 
 int FLACDecoder::getSampleRate() const
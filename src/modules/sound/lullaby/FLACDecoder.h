@@ -38,7 +38,7 @@ namespace lullaby
 class FLACDecoder : public Decoder
 {
 public:
-	FLACDecoder(Stream *stream, int bufferSize);
+	FLACDecoder(Stream *stream, int bufferSize, int bitDepth);
 	~FLACDecoder();
 
 	love::sound::Decoder *clone() override;
@@ -23,6 +23,8 @@
 #include "MP3Decoder.h"
 #include "common/Exception.h"
 
+#include <algorithm>
+
 namespace love
 {
 namespace sound
@@ -133,8 +135,10 @@ drmp3_bool32 MP3Decoder::onSeek(void *pUserData, int offset, drmp3_seek_origin o
 	return decoder->stream->seek(pos, Stream::SEEKORIGIN_BEGIN) ? DRMP3_TRUE : DRMP3_FALSE;
 }
 
-MP3Decoder::MP3Decoder(Stream *stream, int bufferSize)
-: Decoder(stream, bufferSize)
+MP3Decoder::MP3Decoder(Stream *stream, int bufferSize, int bitDepth)
+: Decoder(stream, bufferSize, bitDepth)
+, duration(-1.0)
+, seekingPrepared(false)
 {
 	// Check for possible ID3 tag and skip it if necessary.
 	offset = findFirstValidHeader(stream);
@@ -147,30 +151,8 @@ MP3Decoder::MP3Decoder(Stream *stream, int bufferSize)
 
 	sampleRate = mp3.sampleRate;
 
-	// calculate duration
-	drmp3_uint64 pcmCount, mp3FrameCount;
-	if (!drmp3_get_mp3_and_pcm_frame_count(&mp3, &mp3FrameCount, &pcmCount))
-	{
-		drmp3_uninit(&mp3);
-		throw love::Exception("Could not calculate mp3 duration.");
-	}
-	duration = ((double) pcmCount) / ((double) mp3.sampleRate);
-
-	// create seek table
-	drmp3_uint32 mp3FrameInt = (drmp3_uint32) mp3FrameCount;
-	seekTable.resize((size_t) mp3FrameCount, {0ULL, 0ULL, 0, 0});
-	if (!drmp3_calculate_seek_points(&mp3, &mp3FrameInt, seekTable.data()))
-	{
-		drmp3_uninit(&mp3);
-		throw love::Exception("Could not calculate mp3 seek table");
-	}
-
-	// bind seek table
-	if (!drmp3_bind_seek_table(&mp3, mp3FrameInt, seekTable.data()))
-	{
-		drmp3_uninit(&mp3);
-		throw love::Exception("Could not bind mp3 seek table");
-	}
+	// The duration and seek table both need a scan through the whole file, so
+	// they're created on demand by prepareSeeking instead of here.
 }
 
 MP3Decoder::~MP3Decoder()
@@ -181,25 +163,146 @@ MP3Decoder::~MP3Decoder()
 love::sound::Decoder *MP3Decoder::clone()
 {
 	StrongRef<Stream> s(stream->clone(), Acquire::NORETAIN);
-	return new MP3Decoder(s, bufferSize);
+	return new MP3Decoder(s, bufferSize, bitDepth);
 }
 
 int MP3Decoder::decode()
 {
 	// bufferSize is in char
-	int maxRead = bufferSize / sizeof(int16_t) / mp3.channels;
-	int read = (int) drmp3_read_pcm_frames_s16(&mp3, maxRead, (drmp3_int16 *) buffer);
+	int sampleSize = bitDepth / 8;
+	int maxRead = bufferSize / sampleSize / mp3.channels;
+	int read = 0;
+
+	if (bitDepth == 32)
+		read = (int) drmp3_read_pcm_frames_f32(&mp3, maxRead, (float *) buffer);
+	else
+		read = (int) drmp3_read_pcm_frames_s16(&mp3, maxRead, (drmp3_int16 *) buffer);
 
 	if (read < maxRead)
 		eof = true;
 
-	return read * sizeof(int16_t) * mp3.channels;
+	return read * sampleSize * mp3.channels;
+}
+
+void MP3Decoder::prepareSeeking()
+{
+	{
+		love::thread::Lock lock(seekTableMutex);
+		if (seekingPrepared)
+			return;
+	}
+
+	double newDuration = -1.0;
+	std::vector<SeekPoint> newSeekTable;
+
+	// The scan uses its own stream and MP3 handle, so it doesn't move this
+	// decoder's position and can run while another thread is decoding.
+	try
+	{
+		StrongRef<Stream> s(stream->clone(), Acquire::NORETAIN);
+		MP3Decoder scanner(s, bufferSize, bitDepth);
+		drmp3 *smp3 = &scanner.mp3;
+
+		if (drmp3_seek_to_start_of_stream(smp3))
+		{
+			uint64 pcmFrame = 0;
+			while (true)
+			{
+				// Only the frame headers and side info are parsed, the audio
+				// isn't decoded.
+				uint64 bytePos = smp3->streamCursor - smp3->dataSize;
+				drmp3_uint32 frames = drmp3_decode_next_frame_ex(smp3, nullptr);
+
+				newSeekTable.push_back({bytePos, pcmFrame});
+
+				if (frames == 0)
+					break;
+
+				pcmFrame += frames;
+			}
+
+			newDuration = (double) pcmFrame / (double) smp3->sampleRate;
+		}
+	}
+	catch (love::Exception &)
+	{
+		// Seeking falls back to decoding from the start, and the duration
+		// stays unknown.
+		newSeekTable.clear();
+	}
+
+	love::thread::Lock lock(seekTableMutex);
+	if (!seekingPrepared)
+	{
+		duration = newDuration;
+		seekTable = std::move(newSeekTable);
+		seekTable.shrink_to_fit();
+		seekingPrepared = true;
+	}
+}
+
+bool MP3Decoder::seekToFrame(uint64 frame)
+{
+	love::thread::Lock lock(seekTableMutex);
+
+	if (frame == 0 || seekTable.size() < 2)
+		return drmp3_seek_to_pcm_frame(&mp3, frame) == DRMP3_TRUE;
+
+	// The MP3 frame which contains the target PCM frame.
+	auto it = std::upper_bound(seekTable.begin(), seekTable.end() - 1, frame,
+		[](uint64 f, const SeekPoint &p) { return f < p.pcmFrame; });
+	size_t target = (size_t) (it - seekTable.begin()) - 1;
+
+	// Frames can take their data from the bit reservoir in up to 511 bytes of
+	// the frames before them, and the output of a frame depends on the frame
+	// before it. Decoding starts early enough to fill both in.
+	size_t start = target;
+	while (start > 0 && (start == target || seekTable[target - 1].bytePos - seekTable[start].bytePos < 1024))
+		start--;
+
+	if (!drmp3__on_seek_64(&mp3, seekTable[start].bytePos, drmp3_seek_origin_start))
+		return false;
+
+	drmp3_reset(&mp3);
+
+	// dr_mp3 skips frames whose bit reservoir data isn't available, so the
+	// frame which was decoded is looked up from the stream position.
+	size_t decoded = start;
+	while (decoded < target)
+	{
+		if (drmp3_decode_next_frame(&mp3) == 0)
+			return false;
+
+		uint64 endPos = mp3.streamCursor - mp3.dataSize;
+		auto next = std::lower_bound(seekTable.begin(), seekTable.end(), endPos,
+			[](const SeekPoint &p, uint64 pos) { return p.bytePos < pos; });
+
+		if (next == seekTable.begin())
+			return false;
+
+		decoded = (size_t) (next - seekTable.begin()) - 1;
+	}
+
+	if (decoded != target)
+	{
+		if (!drmp3_seek_to_start_of_stream(&mp3))
+			return false;
+		return drmp3_seek_forward_by_pcm_frames__brute_force(&mp3, frame) == DRMP3_TRUE;
+	}
+
+	// The target frame's PCM data is loaded, skip to the exact sample in it.
+	mp3.currentPCMFrame = seekTable[target].pcmFrame;
+	return drmp3_seek_forward_by_pcm_frames__brute_force(&mp3, frame - mp3.currentPCMFrame) == DRMP3_TRUE;
 }
 
 bool MP3Decoder::seek(double s)
 {
 	drmp3_uint64 targetSample = (drmp3_uint64) (s * mp3.sampleRate);
-	drmp3_bool32 success = drmp3_seek_to_pcm_frame(&mp3, targetSample);
+
+	if (targetSample > 0)
+		prepareSeeking();
+
+	bool success = seekToFrame(targetSample);
 
 	if (success)
 		eof = false;
@@ -224,11 +327,14 @@ int MP3Decoder::getChannelCount() const
 
 int MP3Decoder::getBitDepth() const
 {
-	return 16;
+	return bitDepth;
 }
 
 double MP3Decoder::getDuration()
 {
+	prepareSeeking();
+
+	love::thread::Lock lock(seekTableMutex);
 	return duration;
 }
 
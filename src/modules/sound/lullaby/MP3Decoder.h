@@ -24,6 +24,7 @@
 // LOVE
 #include "common/Stream.h"
 #include "sound/Decoder.h"
+#include "thread/threads.h"
 
 // dr_mp3
 #include "dr/dr_mp3.h"
@@ -41,7 +42,7 @@ class MP3Decoder: public love::sound::Decoder
 {
 public:
 
-	MP3Decoder(Stream *stream, int bufsize);
+	MP3Decoder(Stream *stream, int bufsize, int bitDepth);
 	virtual ~MP3Decoder();
 
 	love::sound::Decoder *clone() override;
@@ -52,19 +53,32 @@ class MP3Decoder: public love::sound::Decoder
 	int getChannelCount() const override;
 	int getBitDepth() const override;
 	double getDuration() override;
+	void prepareSeeking() override;
 
 private:
 	static size_t onRead(void *pUserData, void *pBufferOut, size_t bytesToRead);
 	static drmp3_bool32 onSeek(void *pUserData, int offset, drmp3_seek_origin origin);
 
+	bool seekToFrame(uint64 frame);
+
 	// MP3 handle
 	drmp3 mp3;
-	// Used for fast seeking
-	std::vector<drmp3_seek_point> seekTable;
 	// Position of first MP3 frame found
 	int64 offset;
 
+	// Stream position and first PCM frame of an MP3 frame.
+	struct SeekPoint
+	{
+		uint64 bytePos;
+		uint64 pcmFrame;
+	};
+
+	// One seek point per MP3 frame, followed by the end of the stream. Created
+	// lazily by prepareSeeking along with the duration.
+	std::vector<SeekPoint> seekTable;
 	double duration;
+	bool seekingPrepared;
+	love::thread::MutexRef seekTableMutex;
 }; // MP3Decoder
 
 } // lullaby
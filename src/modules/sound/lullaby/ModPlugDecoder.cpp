@@ -25,6 +25,8 @@
 #include "common/Exception.h"
 #include "common/Data.h"
 
+#include <string.h>
+
 namespace love
 {
 namespace sound
@@ -32,15 +34,15 @@ namespace sound
 namespace lullaby
 {
 
-ModPlugDecoder::ModPlugDecoder(Stream *stream, int bufferSize)
-	: Decoder(stream, bufferSize)
+ModPlugDecoder::ModPlugDecoder(Stream *stream, int bufferSize, int bitDepth)
+	: Decoder(stream, bufferSize, bitDepth)
 	, plug(0)
 	, duration(-2.0)
 {
 	// Set some ModPlug settings.
 	settings.mFlags = MODPLUG_ENABLE_OVERSAMPLING | MODPLUG_ENABLE_NOISE_REDUCTION;
 	settings.mChannels = 2;
-	settings.mBits = 16;
+	settings.mBits = bitDepth;
 	settings.mFrequency = sampleRate;
 	settings.mResamplingMode = MODPLUG_RESAMPLE_LINEAR;
 
@@ -98,7 +100,7 @@ ModPlugDecoder::~ModPlugDecoder()
 love::sound::Decoder *ModPlugDecoder::clone()
 {
 	StrongRef<Stream> s(stream->clone(), Acquire::NORETAIN);
-	return new ModPlugDecoder(s, bufferSize);
+	return new ModPlugDecoder(s, bufferSize, bitDepth);
 }
 
 int ModPlugDecoder::decode()
@@ -108,6 +110,19 @@ int ModPlugDecoder::decode()
 	if (r == 0)
 		eof = true;
 
+	// ModPlug renders 32 bit integers, convert them to floats in place.
+	if (bitDepth == 32)
+	{
+		uint8 *samples = (uint8 *) buffer;
+		for (int i = 0; i + 4 <= r; i += 4)
+		{
+			int32 s;
+			memcpy(&s, samples + i, sizeof(int32));
+			float f = (float) s / 2147483648.0f;
+			memcpy(samples + i, &f, sizeof(float));
+		}
+	}
+
 	return r;
 }
 
@@ -119,8 +134,9 @@ bool ModPlugDecoder::seek(double s)
 
 bool ModPlugDecoder::rewind()
 {
-	// Let's reload.
+	// Let's reload. ModPlug's settings are global, so make sure ours are used.
 	ModPlug_Unload(plug);
+	ModPlug_SetSettings(&settings);
 	plug = ModPlug_Load(data->getData(), (int) data->getSize());
 	ModPlug_SetMasterVolume(plug, 128);
 	eof = false;
@@ -139,7 +155,7 @@ int ModPlugDecoder::getChannelCount() const
 
 int ModPlugDecoder::getBitDepth() const
 {
-	return 16;
+	return bitDepth;
 }
 
 double ModPlugDecoder::getDuration()
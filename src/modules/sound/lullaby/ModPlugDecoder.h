@@ -47,7 +47,7 @@ class ModPlugDecoder : public Decoder
 {
 public:
 
-	ModPlugDecoder(Stream *stream, int bufferSize);
+	ModPlugDecoder(Stream *stream, int bufferSize, int bitDepth);
 	virtual ~ModPlugDecoder();
 
 	love::sound::Decoder *clone() override;
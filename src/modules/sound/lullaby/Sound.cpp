@@ -37,16 +37,16 @@
 
 struct DecoderImpl
 {
-	love::sound::Decoder *(*create)(love::Stream *stream, int bufferSize);
+	love::sound::Decoder *(*create)(love::Stream *stream, int bufferSize, int bitDepth);
 };
 
 template<typename DecoderType>
 DecoderImpl DecoderImplFor()
 {
 	DecoderImpl decoderImpl;
-	decoderImpl.create = [](love::Stream *stream, int bufferSize) -> love::sound::Decoder*
+	decoderImpl.create = [](love::Stream *stream, int bufferSize, int bitDepth) -> love::sound::Decoder*
 	{
-		return new DecoderType(stream, bufferSize);
+		return new DecoderType(stream, bufferSize, bitDepth);
 	};
 	return decoderImpl;
 }
@@ -67,7 +67,7 @@ Sound::~Sound()
 {
 }
 
-sound::Decoder *Sound::newDecoder(Stream *stream, int bufferSize)
+sound::Decoder *Sound::newDecoder(Stream *stream, int bufferSize, int bitDepth)
 {
 	std::vector<DecoderImpl> possibleDecoders = {
 		DecoderImplFor<WaveDecoder>(),
@@ -89,7 +89,7 @@ sound::Decoder *Sound::newDecoder(Stream *stream, int bufferSize)
 		try
 		{
 			stream->seek(0);
-			sound::Decoder *decoder = possibleDecoder.create(stream, bufferSize);
+			sound::Decoder *decoder = possibleDecoder.create(stream, bufferSize, bitDepth);
 			return decoder;
 		}
 		catch (love::Exception &e)
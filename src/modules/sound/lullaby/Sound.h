@@ -49,7 +49,7 @@ class Sound : public love::sound::Sound
 	virtual ~Sound();
 
 	/// @copydoc love::sound::Sound::newDecoder
-	sound::Decoder *newDecoder(Stream *stream, int bufferSize) override;
+	sound::Decoder *newDecoder(Stream *stream, int bufferSize, int bitDepth) override;
 
 }; // Sound
 
@@ -75,8 +75,8 @@ static long vorbisTell(void *datasource)
  * END CALLBACK FUNCTIONS
  **/
 
-VorbisDecoder::VorbisDecoder(Stream *stream, int bufferSize)
-	: Decoder(stream, bufferSize)
+VorbisDecoder::VorbisDecoder(Stream *stream, int bufferSize, int bitDepth)
+	: Decoder(stream, bufferSize, bitDepth)
 	, duration(-2.0)
 {
 	ov_callbacks callbacks = {};
@@ -100,11 +100,14 @@ VorbisDecoder::~VorbisDecoder()
 love::sound::Decoder *VorbisDecoder::clone()
 {
 	StrongRef<Stream> s(stream->clone(), Acquire::NORETAIN);
-	return new VorbisDecoder(s, bufferSize);
+	return new VorbisDecoder(s, bufferSize, bitDepth);
 }
 
 int VorbisDecoder::decode()
 {
+	if (bitDepth == 32)
+		return decodeFloat();
+
 	int size = 0;
 
 #ifdef LOVE_BIG_ENDIAN
@@ -115,7 +118,7 @@ int VorbisDecoder::decode()
 
 	while (size < bufferSize)
 	{
-		long result = ov_read(&handle, (char *) buffer + size, bufferSize - size, endian, (getBitDepth() == 16 ? 2 : 1), 1, 0);
+		long result = ov_read(&handle, (char *) buffer + size, bufferSize - size, endian, 2, 1, 0);
 
 		if (result == OV_HOLE)
 			continue;
@@ -133,16 +136,56 @@ int VorbisDecoder::decode()
 	return size;
 }
 
+int VorbisDecoder::decodeFloat()
+{
+	int channels = vorbisInfo->channels;
+	int frameSize = (int) sizeof(float) * channels;
+	int size = 0;
+
+	while (size + frameSize <= bufferSize)
+	{
+		float **pcm = nullptr;
+		long frames = ov_read_float(&handle, &pcm, (bufferSize - size) / frameSize, nullptr);
+
+		if (frames == OV_HOLE)
+			continue;
+		else if (frames <= OV_EREAD)
+			return -1;
+		else if (frames == 0)
+		{
+			eof = true;
+			break;
+		}
+
+		// libvorbis hands out planar channels, OpenAL wants interleaved ones.
+		float *out = (float *) ((char *) buffer + size);
+		for (long i = 0; i < frames; i++)
+		{
+			for (int c = 0; c < channels; c++)
+				out[i * channels + c] = pcm[c][i];
+		}
+
+		size += (int) frames * frameSize;
+	}
+
+	return size;
+}
+
 bool VorbisDecoder::seek(double s)
 {
 	int result = 0;
 
-	// Avoid ov_time_seek (which calls ov_pcm_seek) when seeking to 0, to avoid
-	// a bug in libvorbis <= 1.3.4 when seeking to PCM 0 in multiplexed streams.
-	if (s <= 0.000001)
+	// Seek to an exact PCM frame rather than through ov_time_seek, which
+	// accumulates floating point error across links. libvorbis bisects the
+	// stream by page granule positions, so this doesn't scan from the start.
+	ogg_int64_t frame = (ogg_int64_t) (s * (double) vorbisInfo->rate);
+
+	// Avoid ov_pcm_seek when seeking to 0, to avoid a bug in libvorbis <= 1.3.4
+	// when seeking to PCM 0 in multiplexed streams.
+	if (frame <= 0)
 		result = ov_raw_seek(&handle, 0);
 	else
-		result = ov_time_seek(&handle, s);
+		result = ov_pcm_seek(&handle, frame);
 
 	if (result == 0)
 	{
@@ -181,7 +224,7 @@ int VorbisDecoder::getChannelCount() const
 
 int VorbisDecoder::getBitDepth() const
 {
-	return 16;
+	return bitDepth;
 }
 
 int VorbisDecoder::getSampleRate() const
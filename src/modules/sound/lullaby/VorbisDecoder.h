@@ -42,7 +42,7 @@ class VorbisDecoder : public Decoder
 {
 public:
 
-	VorbisDecoder(Stream *stream, int bufferSize);
+	VorbisDecoder(Stream *stream, int bufferSize, int bitDepth);
 	virtual ~VorbisDecoder();
 
 	love::sound::Decoder *clone() override;
@@ -57,6 +57,8 @@ class VorbisDecoder : public Decoder
 
 private:
 
+	int decodeFloat();
+
 	OggVorbis_File handle;
 	vorbis_info *vorbisInfo;
 	double duration;
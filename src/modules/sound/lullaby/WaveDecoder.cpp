@@ -56,8 +56,8 @@ static wuff_sint32 tell_callback(void *userdata, wuff_uint64 *offset)
 
 static wuff_callback WaveDecoderCallbacks = {read_callback, seek_callback, tell_callback};
 
-WaveDecoder::WaveDecoder(Stream *stream, int bufferSize)
-	: Decoder(stream, bufferSize)
+WaveDecoder::WaveDecoder(Stream *stream, int bufferSize, int bitDepth)
+	: Decoder(stream, bufferSize, bitDepth)
 {
 	int wuff_status = wuff_open(&handle, &WaveDecoderCallbacks, stream);
 	if (wuff_status < 0)
@@ -72,7 +72,13 @@ WaveDecoder::WaveDecoder(Stream *stream, int bufferSize)
 		if (info.channels > 2)
 			throw love::Exception("WAVE Multichannel audio not supported");
 
-		if (info.format != WUFF_FORMAT_PCM_U8 && info.format != WUFF_FORMAT_PCM_S16)
+		if (bitDepth == 32)
+		{
+			wuff_status = wuff_format(handle, WUFF_FORMAT_IEEE_FLOAT_32);
+			if (wuff_status < 0)
+				throw love::Exception("Could not set WAVE output format");
+		}
+		else if (info.format != WUFF_FORMAT_PCM_U8 && info.format != WUFF_FORMAT_PCM_S16)
 		{
 			wuff_status = wuff_format(handle, WUFF_FORMAT_PCM_S16);
 			if (wuff_status < 0)
@@ -94,7 +100,7 @@ WaveDecoder::~WaveDecoder()
 love::sound::Decoder *WaveDecoder::clone()
 {
 	StrongRef<Stream> s(stream->clone(), Acquire::NORETAIN);
-	return new WaveDecoder(s, bufferSize);
+	return new WaveDecoder(s, bufferSize, bitDepth);
 }
 
 int WaveDecoder::decode()
@@ -158,6 +164,9 @@ int WaveDecoder::getChannelCount() const
 
 int WaveDecoder::getBitDepth() const
 {
+	if (bitDepth == 32)
+		return 32;
+
 	return info.bits_per_sample == 8 ? 8 : 16;
 }
 
@@ -38,7 +38,7 @@ class WaveDecoder : public Decoder
 {
 public:
 
-	WaveDecoder(Stream *stream, int bufferSize);
+	WaveDecoder(Stream *stream, int bufferSize, int bitDepth);
 	virtual ~WaveDecoder();
 
 	love::sound::Decoder *clone() override;
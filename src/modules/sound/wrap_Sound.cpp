@@ -36,6 +36,7 @@ namespace sound
 int w_newDecoder(lua_State *L)
 {
 	int bufferSize = (int)luaL_optinteger(L, 2, Decoder::DEFAULT_BUFFER_SIZE);
+	int bitDepth = (int)luaL_optinteger(L, 4, Decoder::DEFAULT_BIT_DEPTH);
 	love::Stream *stream = nullptr;
 
 	if (love::filesystem::luax_cangetfile(L, 1))
@@ -75,7 +76,7 @@ int w_newDecoder(lua_State *L)
 
 	Decoder *t = nullptr;
 	luax_catchexcept(L,
-		[&]() { t = instance()->newDecoder(stream, bufferSize); },
+		[&]() { t = instance()->newDecoder(stream, bufferSize, bitDepth); },
 		[&](bool) { stream->release(); }
 	);
 
@@ -146,6 +146,54 @@ int w_SoundData_slice(lua_State *L)
 	return 1;
 }
 
+int w_SoundData_mix(lua_State *L)
+{
+	SoundData *dst = luax_checksounddata(L, 1);
+	const SoundData *src = luax_checksounddata(L, 2);
+
+	int srcStart = (int) luaL_checkinteger(L, 3);
+	int count = (int) luaL_checkinteger(L, 4);
+	int dstStart = (int) luaL_optinteger(L, 5, 0);
+	float gain = (float) luaL_optnumber(L, 6, 1.0);
+
+	luax_catchexcept(L, [&](){ dst->mix(src, srcStart, count, dstStart, gain); });
+	return 0;
+}
+
+int w_SoundData_applyGain(lua_State *L)
+{
+	SoundData *t = luax_checksounddata(L, 1);
+	float gain = (float) luaL_checknumber(L, 2);
+	int start = (int) luaL_optinteger(L, 3, 0);
+	int count = (int) luaL_optinteger(L, 4, -1);
+
+	luax_catchexcept(L, [&](){ t->applyGain(gain, start, count); });
+	return 0;
+}
+
+int w_SoundData_resample(lua_State *L)
+{
+	SoundData *t = luax_checksounddata(L, 1), *c = nullptr;
+	int sampleRate = (int) luaL_checkinteger(L, 2);
+
+	luax_catchexcept(L, [&](){ c = t->resample(sampleRate); });
+	luax_pushtype(L, c);
+	c->release();
+	return 1;
+}
+
+int w_SoundData_convert(lua_State *L)
+{
+	SoundData *t = luax_checksounddata(L, 1), *c = nullptr;
+	int bitDepth = (int) luaL_checkinteger(L, 2);
+	int channels = (int) luaL_optinteger(L, 3, t->getChannelCount());
+
+	luax_catchexcept(L, [&](){ c = t->convert(bitDepth, channels); });
+	luax_pushtype(L, c);
+	c->release();
+	return 1;
+}
+
 static const luaL_Reg w_SoundData_functions[] =
 {
 	{ "clone", w_SoundData_clone },
@@ -158,6 +206,10 @@ static const luaL_Reg w_SoundData_functions[] =
 	{ "getSample", w_SoundData_getSample },
 	{ "copyFrom", w_SoundData_copyFrom },
 	{ "slice", w_SoundData_slice },
+	{ "mix", w_SoundData_mix },
+	{ "applyGain", w_SoundData_applyGain },
+	{ "resample", w_SoundData_resample },
+	{ "convert", w_SoundData_convert },
 
 	{ 0, 0 }
 };
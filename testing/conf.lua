@@ -8,6 +8,10 @@ function love.conf(t)
   t.window.depth = true
   t.window.stencil = true
   t.window.usedpiscale = false
+  -- use the software-mixed audio module, for testing love.audio.render
+  for _, a in ipairs(love.rawGameArguments or {}) do
+    if a == '--offlineaudio' then t.audio.offline = true end
+  end
 end
 
 -- custom crash message here to catch anything that might occur with modules 
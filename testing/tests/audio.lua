@@ -396,6 +396,89 @@ love.test.audio.play = function(test)
 end
 
 
+-- love.audio.render
+love.test.audio.render = function(test)
+  -- rendering is only available when t.audio.offline is set, which the test
+  -- conf does when run with --offlineaudio
+  local ok, err = pcall(love.audio.render, 16)
+  if not ok then
+    test:assertNotEquals(nil, string.find(err, 'offline'), 'check error mentions offline module')
+    return test:skipTest('offline audio module not in use')
+  end
+  test:assertObject(err)
+  test:assertEquals(16, err:getSampleCount(), 'check sample count')
+  test:assertEquals(32, err:getBitDepth(), 'check default bit depth')
+  -- check a centered mono source is mixed into both channels
+  local sounddata = love.sound.newSoundData(32, 44100, 16, 1)
+  for i=0,31 do sounddata:setSample(i, 0.5) end
+  local source = love.audio.newSource(sounddata)
+  source:play()
+  local target = love.sound.newSoundData(16, 44100, 32, 2)
+  love.audio.render(target)
+  test:assertRange(target:getSample(0, 1), 0.35, 0.36, 'check left gain')
+  test:assertRange(target:getSample(0, 2), 0.35, 0.36, 'check right gain')
+  test:assertEquals(16, source:tell('samples'), 'check source advanced')
+  -- check the source stops once its data runs out
+  love.audio.render(target, 0, 16)
+  love.audio.render(target, 0, 1)
+  test:assertFalse(source:isPlaying(), 'check source finished')
+  test:assertEquals(0, target:getSample(0, 1), 'check silence replaces old samples')
+  -- check the loopback device records rendered audio into a reused sounddata
+  local device = love.audio.getRecordingDevices()[1]
+  test:assertTrue(device:start(8, 44100, 16, 1), 'check loopback started')
+  source:play()
+  love.audio.render(target, 0, 4)
+  test:assertEquals(4, device:getSampleCount(), 'check samples recorded')
+  local chunk = love.sound.newSoundData(2, 44100, 16, 1)
+  test:assertEquals(2, device:getData(chunk), 'check chunk filled')
+  test:assertRange(chunk:getSample(0), 0.35, 0.36, 'check recorded sample')
+  test:assertEquals(2, device:getSampleCount(), 'check samples consumed')
+  device:stop()
+  love.audio.stop()
+  -- check resampled loopback audio stays continuous across renders
+  local ramp = love.sound.newSoundData(64, 44100, 32, 2)
+  for i=0,63 do
+    ramp:setSample(i, 1, i/64)
+    ramp:setSample(i, 2, i/64)
+  end
+  device:start(64, 22050, 32, 2)
+  love.audio.newSource(ramp):play()
+  for i=1,8 do love.audio.render(target, 0, 3) end
+  local recorded = device:getData()
+  test:assertEquals(12, recorded:getSampleCount(), 'check resampled count')
+  for i=1,recorded:getSampleCount()-1 do
+    test:assertRange(recorded:getSample(i, 1) - recorded:getSample(i - 1, 1),
+      0.031, 0.032, 'check resampled step ' .. i)
+  end
+  device:stop()
+  love.audio.stop()
+  -- check integer targets saturate instead of wrapping around
+  local loud = love.sound.newSoundData(16, 44100, 32, 2)
+  for i=0,31 do loud:setSample(i, 1) end
+  love.audio.newSource(loud):play()
+  love.audio.newSource(loud):play()
+  local itarget = love.sound.newSoundData(4, 44100, 16, 2)
+  love.audio.render(itarget)
+  test:assertEquals(1, itarget:getSample(0, 1), 'check left saturates')
+  test:assertEquals(1, itarget:getSample(0, 2), 'check right saturates')
+  love.audio.stop()
+  -- check 5.1 is downmixed: centre at -3dB on both sides, no LFE
+  local surround = love.sound.newSoundData(16, 44100, 32, 6)
+  for i=0,15 do
+    surround:setSample(i, 3, 0.5)
+    surround:setSample(i, 4, 1)
+  end
+  love.audio.newSource(surround):play()
+  love.audio.render(target, 0, 4)
+  test:assertRange(target:getSample(0, 1), 0.146, 0.147, 'check 5.1 left')
+  test:assertRange(target:getSample(0, 2), 0.146, 0.147, 'check 5.1 right')
+  love.audio.stop()
+  -- check channel layouts without a downmix are rejected
+  local ok3 = pcall(love.audio.newSource, love.sound.newSoundData(4, 44100, 16, 3))
+  test:assertFalse(ok3, 'check 3 channels rejected')
+end
+
+
 -- love.audio.setDistanceModel
 love.test.audio.setDistanceModel = function(test)
   -- check setting each of the distance models is accepted and val returned
@@ -505,6 +588,38 @@ love.test.audio.setPosition = function(test)
 end
 
 
+-- love.audio.setSourceStates
+love.test.audio.setSourceStates = function(test)
+  local sounddata = love.sound.newSoundData(64, 44100, 16, 1)
+  local source1 = love.audio.newSource(sounddata)
+  local source2 = love.audio.newSource(sounddata)
+  -- check states from a table are applied
+  love.audio.setSourceStates({source1, source2}, {
+    1, 2, 3, 4, 5, 6, 0.5, 2,
+    -1, -2, -3, 0, 0, 0, 0.25, 0.5
+  })
+  local x, y, z = source1:getPosition()
+  test:assertEquals(1, x, 'check x position')
+  test:assertEquals(3, z, 'check z position')
+  local vx, vy, vz = source1:getVelocity()
+  test:assertEquals(5, vy, 'check y velocity')
+  test:assertEquals(0.5, source1:getVolume(), 'check volume')
+  test:assertEquals(2, source1:getPitch(), 'check pitch')
+  test:assertEquals(-2, select(2, source2:getPosition()), 'check second source')
+  test:assertEquals(0.25, source2:getVolume(), 'check second volume')
+  -- check states from packed data are applied
+  local data = love.data.pack('data', 'ffffffff', 7, 8, 9, 0, 0, 0, 0.75, 1)
+  love.audio.setSourceStates({source1}, data)
+  test:assertEquals(7, (source1:getPosition()), 'check data position')
+  test:assertEquals(0.75, source1:getVolume(), 'check data volume')
+  -- check invalid input errors
+  local ok = pcall(love.audio.setSourceStates, {source1}, {1, 2, 3})
+  test:assertFalse(ok, 'check too few values')
+  ok = pcall(love.audio.setSourceStates, {source1}, {0, 0, 0, 0, 0, 0, 1, 0})
+  test:assertFalse(ok, 'check invalid pitch')
+end
+
+
 -- love.audio.setVelocity
 love.test.audio.setVelocity = function(test)
   -- check setting velocity vals are returned
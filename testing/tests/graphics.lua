@@ -1,6 +1,35 @@
 -- love.graphics
 
 
+-- packs a list of numbers into a Data of 32 bit floats
+local function packFloats(values)
+  local packed = {}
+  for _, v in ipairs(values) do
+    table.insert(packed, love.data.pack('string', 'f', v))
+  end
+  return love.data.newByteData(table.concat(packed))
+end
+
+
+-- returns how many pixels differ (by more than the optional tolerance in any
+-- component) between two ImageData of the same size
+local function countPixelDifferences(a, b, tolerance)
+  tolerance = tolerance or 0
+  local count = 0
+  for x=0,a:getWidth()-1 do
+    for y=0,a:getHeight()-1 do
+      local r1, g1, b1, a1 = a:getPixel(x, y)
+      local r2, g2, b2, a2 = b:getPixel(x, y)
+      if math.abs(r1-r2) > tolerance or math.abs(g1-g2) > tolerance or
+        math.abs(b1-b2) > tolerance or math.abs(a1-a2) > tolerance then
+        count = count + 1
+      end
+    end
+  end
+  return count
+end
+
+
 --------------------------------------------------------------------------------
 --------------------------------------------------------------------------------
 ------------------------------------OBJECTS-------------------------------------
@@ -325,6 +354,116 @@ love.test.graphics.Font = function(test)
   local imgdata2 = love.graphics.readbackTexture(canvas)
   test:compareImg(imgdata2)
 
+  -- check atlas prewarming and saving/loading
+  local warm = love.graphics.newFont('resources/font.ttf', 8)
+  warm:prewarm('ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789')
+  local atlas = warm:saveAtlas()
+  test:assertObject(atlas)
+  local cold = love.graphics.newFont('resources/font.ttf', 8)
+  cold:loadAtlas(atlas)
+  -- glyphs added a few at a time are uploaded in several pieces
+  local trickle = love.graphics.newFont('resources/font.ttf', 8)
+  for _, chars in ipairs({'W', 'ab', 'g', 'lHe', 'oQ', 'i'}) do
+    trickle:prewarm(chars)
+  end
+  local results = {}
+  for i, f in ipairs({warm, cold, trickle}) do
+    love.graphics.setCanvas(canvas)
+      love.graphics.clear(0, 0, 0, 0)
+      love.graphics.setFont(f)
+      love.graphics.print('Hello', 0, 0)
+    love.graphics.setCanvas()
+    results[i] = love.graphics.readbackTexture(canvas)
+  end
+  test:assertEquals(0, countPixelDifferences(results[1], results[2]),
+    'check loaded atlas matches')
+  test:assertEquals(0, countPixelDifferences(results[1], results[3]),
+    'check incrementally uploaded atlas matches')
+  local other = love.graphics.newFont('resources/font.ttf', 16)
+  test:assertFalse(pcall(other.loadAtlas, other, atlas), 'check atlas size mismatch')
+  local builtin = love.graphics.newFont(8)
+  test:assertFalse(pcall(builtin.loadAtlas, builtin, atlas), 'check atlas face mismatch')
+  local mono = love.graphics.newFont('resources/font.ttf', 8, 'mono')
+  test:assertFalse(pcall(mono.loadAtlas, mono, atlas), 'check atlas hinting mismatch')
+  -- corrupted atlases are rejected before anything is replaced
+  local atlasstr = atlas:getString()
+  local function patchAtlas(offset, value)
+    local bytes = love.data.pack('string', '<i4', value)
+    return love.data.newByteData(atlasstr:sub(1, offset) .. bytes .. atlasstr:sub(offset + 5))
+  end
+  local skylinecount = love.data.unpack('<i4', atlasstr, 53)
+  local glyphcount = love.data.unpack('<i4', atlasstr, 57)
+  local skylineoffset = #atlasstr - glyphcount * 80 - skylinecount * 12
+  test:assertFalse(pcall(cold.loadAtlas, cold, patchAtlas(skylineoffset, 0)),
+    'check atlas skyline gap')
+  test:assertFalse(pcall(cold.loadAtlas, cold, patchAtlas(skylineoffset + 8, 100000)),
+    'check atlas skyline overlap')
+  test:assertFalse(pcall(cold.loadAtlas, cold, patchAtlas(48, 0x7FFFFFFF)),
+    'check atlas texture count overflow')
+  test:assertFalse(pcall(cold.loadAtlas, cold, love.data.newByteData(atlasstr:sub(1, -2))),
+    'check truncated atlas')
+
+  -- check atlas stats and glyph eviction
+  local stats = warm:getAtlasStats()
+  test:assertEquals(1, stats.textures, 'check atlas texture count')
+  test:assertGreaterEqual(62, stats.glyphs, 'check atlas glyph count')
+  test:assertRange(stats.occupancy, 0, 1, 'check atlas occupancy')
+  test:assertEquals(0, warm:evictUnusedGlyphs(), 'check no glyphs evicted')
+  love.graphics.setCanvas(canvas)
+    love.graphics.clear(0, 0, 0, 0)
+    love.graphics.setFont(warm)
+    love.graphics.print('Hi', 0, 0)
+  love.graphics.setCanvas()
+  local before = love.graphics.readbackTexture(canvas)
+  test:assertGreaterEqual(60, warm:evictUnusedGlyphs(), 'check unused glyphs evicted')
+  test:assertRange(warm:getAtlasStats().glyphs, 2, 3, 'check used glyphs kept')
+  love.graphics.setCanvas(canvas)
+    love.graphics.clear(0, 0, 0, 0)
+    love.graphics.print('Hi', 0, 0)
+  love.graphics.setCanvas()
+  local after = love.graphics.readbackTexture(canvas)
+  test:assertEquals(0, countPixelDifferences(before, after),
+    'check text after eviction matches')
+
+  -- check glyphs drawn from cached layouts and text batches aren't evicted
+  local evictfont = love.graphics.newFont('resources/font.ttf', 8)
+  local batch = love.graphics.newTextBatch(evictfont, 'World')
+  local function drawEvictText(drawbatch)
+    love.graphics.setCanvas(canvas)
+      love.graphics.clear(0, 0, 0, 0)
+      love.graphics.setFont(evictfont)
+      love.graphics.print('Hello', 0, 0)
+      if drawbatch then love.graphics.draw(batch, 0, 8) end
+    love.graphics.setCanvas()
+  end
+  drawEvictText(true)
+  test:assertEquals(0, evictfont:evictUnusedGlyphs(), 'check new glyphs kept')
+  drawEvictText(true)
+  test:assertEquals(0, evictfont:evictUnusedGlyphs(), 'check cached glyphs kept')
+  drawEvictText(false)
+  test:assertEquals(3, evictfont:evictUnusedGlyphs(), 'check undrawn batch glyphs evicted')
+
+  -- check sdf fonts draw at different scales
+  local sdffont = love.graphics.newFont('resources/font.ttf', 16, {sdf = true})
+  test:assertTrue(sdffont:isSDF(), 'check sdf font')
+  test:assertFalse(font:isSDF(), 'check regular font')
+  for _, scale in ipairs({0.5, 2}) do
+    love.graphics.setCanvas(canvas)
+      love.graphics.clear(0, 0, 0, 0)
+      love.graphics.setFont(sdffont)
+      love.graphics.print('H', 0, 0, 0, scale, scale)
+    love.graphics.setCanvas()
+    local sdfdata = love.graphics.readbackTexture(canvas)
+    local covered = 0
+    for y=0,15 do
+      for x=0,15 do
+        local _, _, _, a = sdfdata:getPixel(x, y)
+        if a > 0.5 then covered = covered + 1 end
+      end
+    end
+    test:assertGreaterEqual(1, covered, 'check sdf glyph drawn at scale ' .. scale)
+  end
+
 end
 
 
@@ -519,6 +658,33 @@ love.test.graphics.Mesh = function(test)
   test:assertEquals(1, g5, 'check reset vertex color 1')
   test:assertEquals(0, b5, 'check reset vertex color 2')
 
+  -- check setting vertices from Data, starting partway into the Data
+  local mesh3 = love.graphics.newMesh({
+    { name = 'VertexPosition', format = 'floatvec2', location = 0 }
+  }, 4, 'points')
+  local posdata = packFloats({0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5})
+  mesh3:setVertices(posdata, 2, 2, 4)
+  local px1, py1 = mesh3:getVertex(1)
+  local px2, py2 = mesh3:getVertex(2)
+  local px3, py3 = mesh3:getVertex(3)
+  local px4, py4 = mesh3:getVertex(4)
+  test:assertEquals(0, px1, 'check data vertex before start untouched')
+  test:assertEquals(3, px2, 'check data vertex start x')
+  test:assertEquals(3, py2, 'check data vertex start y')
+  test:assertEquals(4, px3, 'check data vertex count x')
+  test:assertEquals(0, px4, 'check data vertex after count untouched')
+  mesh3:setVertices(posdata, 1, nil, 5)
+  px1, py1 = mesh3:getVertex(1)
+  px2, py2 = mesh3:getVertex(2)
+  px3, py3 = mesh3:getVertex(3)
+  test:assertEquals(4, px1, 'check data start without count x')
+  test:assertEquals(5, px2, 'check data start without count end')
+  test:assertEquals(4, px3, 'check data end stops copying')
+  test:assertFalse(pcall(mesh3.setVertices, mesh3, posdata, 1, nil, 7),
+    'check data start past the end')
+  test:assertFalse(pcall(mesh3.setVertices, mesh3, posdata, 1, nil, 0),
+    'check data start below 1')
+
   -- check setting the vertex map 
   local vmap1 = mesh1:getVertexMap()
   test:assertEquals(nil, vmap1, 'check no map by def')
@@ -1213,6 +1379,69 @@ love.test.graphics.SpriteBatch = function(test)
   local imgdata5 = love.graphics.readbackTexture(canvas)
   test:compareImg(imgdata5)
 
+  -- instanced sbatch should match the regular one
+  local isbatch = love.graphics.newSpriteBatch(texture2, 64, 'dynamic', true)
+  local rsbatch = love.graphics.newSpriteBatch(texture2, 64, 'dynamic')
+  test:assertTrue(isbatch:isInstanced(), 'check instanced')
+  test:assertFalse(rsbatch:isInstanced(), 'check not instanced')
+  for s=1,100 do
+    local quad = s % 2 == 0 and quad1 or quad2
+    local x, y, r = (s*7) % 64, math.floor(s/2), 0
+    isbatch:setColor(1, s/100, 1, 1)
+    rsbatch:setColor(1, s/100, 1, 1)
+    isbatch:add(quad, x, y, r, 2, 3)
+    rsbatch:add(quad, x, y, r, 2, 3)
+  end
+  test:assertEquals(100, isbatch:getCount(), 'check instanced count')
+  isbatch:setDrawRange(11, 80)
+  rsbatch:setDrawRange(11, 80)
+  local results = {}
+  for i, batch in ipairs({isbatch, rsbatch}) do
+    love.graphics.setCanvas(canvas)
+      love.graphics.clear(0, 0, 0, 1)
+      love.graphics.draw(batch, 0, 0)
+    love.graphics.setCanvas()
+    results[i] = love.graphics.readbackTexture(canvas)
+  end
+  test:assertEquals(0, countPixelDifferences(results[1], results[2], 0.01),
+    'check instanced matches regular')
+
+  -- setSprites from packed data should match add
+  local packed = {}
+  rsbatch:clear()
+  rsbatch:setDrawRange()
+  rsbatch:setColor(1, 1, 1, 1)
+  for s=1,100 do
+    local x, y = (s*7) % 64, math.floor(s/2)
+    local q = s % 2 == 0 and 1 or 2
+    rsbatch:add(q == 1 and quad1 or quad2, x, y, 0, 2, 3)
+    table.insert(packed, love.data.pack('string', 'fffff', x, y, 2, 3, q))
+  end
+  local psbatch = love.graphics.newSpriteBatch(texture2, 16)
+  local spritedata = love.data.newByteData(table.concat(packed))
+  psbatch:setSprites(spritedata, {'x', 'y', 'sx', 'sy', 'quad'}, 1, 100, {quad1, quad2})
+  test:assertEquals(100, psbatch:getCount(), 'check setSprites count')
+  test:assertGreaterEqual(100, psbatch:getBufferSize(), 'check setSprites grows')
+  local ok = pcall(psbatch.setSprites, psbatch, spritedata, {'x', 'quad'}, 1, 10)
+  test:assertFalse(ok, 'check setSprites requires quads')
+  -- invalid quad indices are rejected before any sprite is replaced
+  for _, badquad in ipairs({0/0, 1e30, 3, 0}) do
+    local baddata = love.data.newByteData(love.data.pack('string', 'fffff', 40, 40, 1, 1, 1) ..
+      love.data.pack('string', 'fffff', 40, 40, 1, 1, badquad))
+    ok = pcall(psbatch.setSprites, psbatch, baddata, {'x', 'y', 'sx', 'sy', 'quad'}, 1, 2, {quad1, quad2})
+    test:assertFalse(ok, 'check invalid quad index ' .. tostring(badquad) .. ' rejected')
+  end
+  test:assertEquals(100, psbatch:getCount(), 'check count kept after invalid data')
+  for i, batch in ipairs({psbatch, rsbatch}) do
+    love.graphics.setCanvas(canvas)
+      love.graphics.clear(0, 0, 0, 1)
+      love.graphics.draw(batch, 0, 0)
+    love.graphics.setCanvas()
+    results[i] = love.graphics.readbackTexture(canvas)
+  end
+  test:assertEquals(0, countPixelDifferences(results[1], results[2], 0.01),
+    'check setSprites matches add')
+
 end
 
 
@@ -1533,6 +1762,19 @@ love.test.graphics.line = function(test)
   love.graphics.setCanvas()
   local imgdata = love.graphics.readbackTexture(canvas)
   test:compareImg(imgdata)
+  -- packed float data should draw the same lines as the table variant
+  local data = packFloats({1,1,16,1,16,16,1,16,1,1,0,0,8,8,16,0,8,8,16,16,8,8,0,16})
+  local datacanvas = love.graphics.newCanvas(16, 16)
+  love.graphics.setCanvas(datacanvas)
+    love.graphics.clear(0, 0, 0, 1)
+    love.graphics.setColor(1, 0, 0, 1)
+    love.graphics.line(data, 1, 5)
+    love.graphics.setColor(1, 1, 0, 1)
+    love.graphics.line(data, 6)
+    love.graphics.setColor(1, 1, 1, 1)
+  love.graphics.setCanvas()
+  local dataimg = love.graphics.readbackTexture(datacanvas)
+  test:assertEquals(0, countPixelDifferences(imgdata, dataimg), 'check data variant')
 end
 
 
@@ -1550,6 +1792,20 @@ love.test.graphics.points = function(test)
   love.graphics.pop()
   local imgdata = love.graphics.readbackTexture(canvas)
   test:compareImg(imgdata)
+  -- packed float data should draw the same points as the table variant
+  local data = packFloats({0,0,15,0,15,15,0,15,0,0,1,1,7,7,14,1,7,8,14,14,8,8,1,14,8,7})
+  local datacanvas = love.graphics.newCanvas(16, 16)
+  love.graphics.push("all")
+    love.graphics.setCanvas(datacanvas)
+    love.graphics.clear(0, 0, 0, 1)
+    love.graphics.translate(0.5, 0.5)
+    love.graphics.setColor(1, 0, 0, 1)
+    love.graphics.points(data, 1, 5)
+    love.graphics.setColor(1, 1, 0, 1)
+    love.graphics.points(data, 6, 8)
+  love.graphics.pop()
+  local dataimg = love.graphics.readbackTexture(datacanvas)
+  test:assertEquals(0, countPixelDifferences(imgdata, dataimg), 'check data variant')
 end
 
 
@@ -1566,6 +1822,22 @@ love.test.graphics.polygon = function(test)
   love.graphics.setCanvas()
   local imgdata = love.graphics.readbackTexture(canvas)
   test:compareImg(imgdata)
+  -- packed float data should draw the same polygons as the table variant
+  local filldata = packFloats({1, 1, 4, 5, 8, 10, 16, 2, 7, 3, 5, 16, 16, 16, 1, 8})
+  local linedata = packFloats({2, 2, 4, 5, 3, 7, 8, 15, 12, 4, 5, 10})
+  local ok = pcall(love.graphics.polygon, "fill", filldata, 7)
+  test:assertFalse(ok, 'check too few vertices')
+  local datacanvas = love.graphics.newCanvas(16, 16)
+  love.graphics.setCanvas(datacanvas)
+    love.graphics.clear(0, 0, 0, 1)
+    love.graphics.setColor(1, 0, 0, 1)
+    love.graphics.polygon("fill", filldata)
+    love.graphics.setColor(1, 1, 0, 1)
+    love.graphics.polygon("line", linedata)
+    love.graphics.setColor(1, 1, 1, 1)
+  love.graphics.setCanvas()
+  local dataimg = love.graphics.readbackTexture(datacanvas)
+  test:assertEquals(0, countPixelDifferences(imgdata, dataimg), 'check data variant')
 end
 
 
@@ -1646,9 +1918,16 @@ end
 
 -- love.graphics.captureScreenshot
 love.test.graphics.captureScreenshot = function(test)
-  love.graphics.captureScreenshot('example-screenshot.png')
+  local job = love.graphics.captureScreenshot('example-screenshot.png')
+  test:assertObject(job)
+  -- the screenshot is captured at the end of the frame, and saved on a
+  -- background thread
+  local ok = pcall(job.wait, job)
+  test:assertFalse(ok, 'check job cannot be waited on before capture')
   test:waitFrames(1)
-  -- need to wait until end of the frame for the screenshot
+  job:wait()
+  test:assertTrue(job:isComplete(), 'check screenshot job complete')
+  test:assertEquals(nil, job:getError(), 'check screenshot saved')
   test:assertTrue(love.filesystem.exists('example-screenshot.png'))
   love.filesystem.remove('example-screenshot.png')
   -- test callback version
@@ -2899,12 +3178,25 @@ end
 love.test.graphics.getStats = function(test)
   local stattypes = {
     'drawcalls', 'canvasswitches', 'texturememory', 'shaderswitches',
-    'drawcallsbatched', 'textures', 'fonts'
+    'drawcallsbatched', 'textures', 'fonts', 'textlayoutcachehits',
+    'textlayoutcachemisses'
   }
   local stats = love.graphics.getStats()
   for s=1,#stattypes do
     test:assertNotEquals(nil, stats[stattypes[s] ], 'expected a key for stat: ' .. stattypes[s])
   end
+  -- printing the same text again should reuse its cached layout
+  local font = love.graphics.newFont(12)
+  local canvas = love.graphics.newCanvas(64, 64)
+  love.graphics.setCanvas(canvas)
+    love.graphics.print('cached text', font, 0, 0)
+    local before = love.graphics.getStats()
+    love.graphics.print('cached text', font, 10, 10)
+    love.graphics.printf('other text', font, 0, 20, 64, 'center')
+    local after = love.graphics.getStats()
+  love.graphics.setCanvas()
+  test:assertEquals(before.textlayoutcachehits + 1, after.textlayoutcachehits, 'check text layout cache hit')
+  test:assertEquals(before.textlayoutcachemisses + 1, after.textlayoutcachemisses, 'check text layout cache miss')
 end
 
 
@@ -96,6 +96,56 @@ love.test.image.ImageData = function(test)
   test:assertNotNil(read2)
   love.filesystem.remove('test-encode.exr')
 
+  -- check fast png compression round trips
+  local fastpng = idata:encode('png', nil, { level = 1 })
+  local fastdata = love.image.newImageData(fastpng)
+  test:assertEquals(64, fastdata:getWidth(), 'check fast png w')
+  local fr, fg, fb = fastdata:getPixel(25, 25)
+  test:assertEquals(1, fr+fg+fb, 'check fast png pixel')
+  local ok = pcall(idata.encode, idata, 'png', nil, { level = 10 })
+  test:assertFalse(ok, 'check invalid png level')
+
+  -- check encoding on a background thread
+  local job = idata:encodeAsync('png')
+  test:assertObject(job)
+  job:wait()
+  test:assertTrue(job:isComplete(), 'check encode job complete')
+  test:assertFalse(job:hasError(), 'check encode job succeeded')
+  local asyncdata = love.image.newImageData(job:getFileData())
+  test:assertEquals(64, asyncdata:getHeight(), 'check async png h')
+
+  -- check large images, which are compressed in several bands, round trip
+  local large = love.image.newImageData(1024, 512)
+  large:mapPixel(function(x, y)
+    return (x % 251) / 255, (y % 127) / 255, ((x * y) % 256) / 255, ((x + y) % 256) / 255
+  end)
+  local largejob = large:encodeAsync('png')
+  largejob:wait()
+  test:assertFalse(largejob:hasError(), 'check large encode job succeeded')
+  local largedata = love.image.newImageData(largejob:getFileData())
+  test:assertEquals(large:getString(), largedata:getString(), 'check large png round trip')
+  large:mapPixel(function(x, y, r, g, b) return r, g, b, 1 end)
+  local opaquedata = love.image.newImageData(large:encode('png'))
+  test:assertEquals(large:getString(), opaquedata:getString(), 'check large opaque png round trip')
+
+  -- check mipmap chain generation
+  local mips = idata:generateMipmaps('box')
+  test:assertEquals(7, #mips, 'check mipmap count')
+  test:assertEquals(idata, mips[1], 'check first mipmap is source')
+  test:assertEquals(1, mips[7]:getWidth(), 'check last mipmap w')
+  test:assertEquals(1, mips[7]:getHeight(), 'check last mipmap h')
+  local mdata = love.image.newImageData(4, 2, 'rgba32f')
+  mdata:mapPixel(function(x, y) return x / 4, 0.5, 0, 1 end)
+  local boxmips = mdata:generateMipmaps('box')
+  local br, bg = boxmips[2]:getPixel(0, 0)
+  test:assertRange(br, 0.124, 0.126, 'check box filtered r')
+  test:assertRange(bg, 0.499, 0.501, 'check box filtered g')
+  local lmips = mdata:generateMipmaps('lanczos', true)
+  test:assertEquals(3, #lmips, 'check non-square mipmap count')
+  local _, lg = lmips[3]:getPixel(0, 0)
+  test:assertRange(lg, 0.499, 0.501, 'check lanczos keeps constant channel')
+  test:assertEquals('rgba32f', lmips[3]:getFormat(), 'check mipmap format')
+
   -- check linear
   test:assertFalse(idata:isLinear(), 'check not linear')
   idata:setLinear(true)
@@ -111,6 +161,42 @@ end
 --------------------------------------------------------------------------------
 
 
+-- love.image.compress
+love.test.image.compress = function(test)
+  local idata = love.image.newImageData('resources/love.png')
+  for _, format in ipairs({'DXT1', 'BC7', 'ETC2rgb', 'ASTC4x4'}) do
+    local cdata = love.image.compress(idata, format, 0.5)
+    test:assertObject(cdata)
+    test:assertEquals(format, cdata:getFormat(), 'check ' .. format .. ' format')
+    test:assertEquals(64, cdata:getWidth(), 'check ' .. format .. ' width')
+    test:assertEquals(1, cdata:getMipmapCount(), 'check ' .. format .. ' mipmaps')
+  end
+  local mipped = love.image.compress(idata:generateMipmaps(), 'BC7')
+  test:assertEquals(7, mipped:getMipmapCount(), 'check compressed mipmap chain')
+  test:assertEquals(1, mipped:getWidth(7), 'check smallest mipmap width')
+  test:assertEquals(5488, mipped:getSize(), 'check compressed chain size')
+  local ok = pcall(love.image.compress, idata, 'rgba8')
+  test:assertFalse(ok, 'check uncompressed format rejected')
+  -- check the encoded bytes of a solid and a gradient block
+  local solid = love.image.newImageData(4, 4)
+  solid:mapPixel(function() return 16/255, 32/255, 64/255, 1 end)
+  local gradient = love.image.newImageData(4, 4)
+  gradient:mapPixel(function(x) return x/3, x/3, x/3, 1 end)
+  local blocks = {
+    DXT1 = {'0811081100000000', 'ffff00002d2d2d2d'},
+    BC7 = {'400402020181fe7f0000000000000000', '40c01ff007fcff7f51fa50fa50fa50fa'},
+    ETC2rgb = {'11224400ffff0000', '3d3d3ddc0f0f000f'},
+    ASTC4x4 = {'fcfdffffffffffff101020204040ffff', '53000bf40bf40bf40100aff00aaff00a'},
+  }
+  for format, expected in pairs(blocks) do
+    local solidhex = love.data.encode('string', 'hex', love.image.compress(solid, format, 1))
+    local gradienthex = love.data.encode('string', 'hex', love.image.compress(gradient, format, 1))
+    test:assertEquals(expected[1], solidhex, 'check ' .. format .. ' solid block')
+    test:assertEquals(expected[2], gradienthex, 'check ' .. format .. ' gradient block')
+  end
+end
+
+
 -- love.image.isCompressed
 -- @NOTE really we need to test each of the files listed here:
 -- https://love2d.org/wiki/CompressedImageFormat
@@ -118,6 +204,8 @@ end
 love.test.image.isCompressed = function(test)
   test:assertTrue(love.image.isCompressed('resources/love.dxt1'), 
     'check dxt1 valid compressed image')
+  test:assertTrue(love.image.isCompressed('resources/love.ktx2'),
+    'check ktx2 valid compressed image')
 end
 
 
@@ -125,6 +213,12 @@ end
 -- @NOTE this is just basic nil checking, objs have their own test method
 love.test.image.newCompressedData = function(test)
   test:assertObject(love.image.newCompressedData('resources/love.dxt1'))
+  local ktx2 = love.image.newCompressedData('resources/love.ktx2')
+  test:assertObject(ktx2)
+  test:assertEquals('DXT1', ktx2:getFormat(), 'check ktx2 format')
+  test:assertEquals(7, ktx2:getMipmapCount(), 'check ktx2 mipmap count')
+  test:assertEquals(64, ktx2:getWidth(1), 'check ktx2 base width')
+  test:assertEquals(1, ktx2:getWidth(7), 'check ktx2 smallest width')
 end
 
 
@@ -133,4 +227,44 @@ end
 love.test.image.newImageData = function(test)
   test:assertObject(love.image.newImageData('resources/love.png'))
   test:assertObject(love.image.newImageData(16, 16, 'rgba8', nil))
+  -- decoding only part of the file
+  local full = love.image.newImageData('resources/love.png')
+  local region = love.image.newImageData('resources/love.png', {
+    region = {8, 16, 32, 16}
+  })
+  test:assertObject(region)
+  test:assertEquals(32, region:getWidth(), 'check region width')
+  test:assertEquals(16, region:getHeight(), 'check region height')
+  local r1, g1, b1, a1 = full:getPixel(20, 25)
+  local r2, g2, b2, a2 = region:getPixel(12, 9)
+  test:assertEquals(r1, r2, 'check region pixel r')
+  test:assertEquals(g1, g2, 'check region pixel g')
+  test:assertEquals(b1, b2, 'check region pixel b')
+  test:assertEquals(a1, a2, 'check region pixel a')
+  local scaled = love.image.newImageData('resources/love.png', { scale = 0.5 })
+  test:assertEquals(32, scaled:getWidth(), 'check scaled width')
+  test:assertEquals(32, scaled:getHeight(), 'check scaled height')
+  local ok = pcall(love.image.newImageData, 'resources/love.png', {
+    region = {60, 0, 8, 8}
+  })
+  test:assertFalse(ok, 'check region outside image errors')
+  -- lossy webp regions decode only part of the image, but must match a
+  -- full decode cropped to the same rectangle
+  local webp = love.image.newImageData('resources/love.webp')
+  local webpregion = love.image.newImageData('resources/love.webp', {
+    region = {9, 13, 30, 21}
+  })
+  test:assertEquals(30, webpregion:getWidth(), 'check webp region width')
+  test:assertEquals(21, webpregion:getHeight(), 'check webp region height')
+  local mismatches = 0
+  for y=0,20 do
+    for x=0,29 do
+      local fr, fg, fb, fa = webp:getPixel(x + 9, y + 13)
+      local rr, rg, rb, ra = webpregion:getPixel(x, y)
+      if fr ~= rr or fg ~= rg or fb ~= rb or fa ~= ra then
+        mismatches = mismatches + 1
+      end
+    end
+  end
+  test:assertEquals(0, mismatches, 'check webp region matches cropped full decode')
 end
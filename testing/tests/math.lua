@@ -60,6 +60,21 @@ love.test.math.BezierCurve = function(test)
   test:assertEquals(196, #coords1, 'check coords')
   test:assertEquals(20, #coords2, 'check segment coords')
 
+  -- check adaptive rendering and range evaluation
+  local coarse = curve:renderAdaptive(1)
+  local fine = curve:renderAdaptive(0.01)
+  test:assertGreaterEqual(4, #coarse, 'check adaptive coords')
+  test:assertGreaterEqual(#coarse, #fine, 'check finer tolerance adds coords')
+  test:assertCoords({1, 1}, {fine[1], fine[2]}, 'check adaptive start')
+  test:assertCoords({3, 1}, {fine[#fine-1], fine[#fine]}, 'check adaptive end')
+  local range = curve:evaluateRange(0, 1, 3)
+  local mx, my = curve:evaluate(0.5)
+  test:assertEquals(6, #range, 'check range coords')
+  test:assertCoords({mx, my}, {range[3], range[4]}, 'check range midpoint')
+  local flattened = love.math.flattenBezierCurves({curve, segment}, 1)
+  test:assertEquals(2, #flattened, 'check flattened curves')
+  test:assertEquals(#coarse, #flattened[1], 'check flattened matches adaptive')
+
   -- check translation values
   px, py = curve:getControlPoint(2)
   test:assertCoords({3, 2}, {px, py}, 'check pretransform x/y')
@@ -104,6 +119,22 @@ love.test.math.RandomGenerator = function(test)
   test:assertNotEquals(rng1:random(), rng2:random(), 'check not matching states')
   test:assertNotEquals(rng1:randomNormal(), rng2:randomNormal(), 'check not matching states')
 
+  -- check bulk fills match sequential calls
+  local values = love.data.newByteData(4 * 4)
+  rng2:setState(rng1:getState())
+  rng1:fill(values, 4, 'integer', 10, 20)
+  test:assertEquals(rng2:random(10, 20), love.data.unpack('i4', values, 1), 'check integer fill')
+  test:assertEquals(rng2:random(10, 20), love.data.unpack('i4', values, 5), 'check integer fill 2')
+  rng2:setState(rng1:getState())
+  rng1:fill(values, 4, 'uniform')
+  local f1 = love.data.unpack('f', love.data.pack('string', 'f', rng2:random()))
+  test:assertEquals(f1, love.data.unpack('f', values, 1), 'check uniform fill')
+  rng1:setState(rng1:getState()) -- clears any cached normal value
+  rng2:setState(rng1:getState())
+  rng1:fill(values, 4, 'normal', 2, 5)
+  local n1 = love.data.unpack('f', love.data.pack('string', 'f', rng2:randomNormal(2, 5)))
+  test:assertEquals(n1, love.data.unpack('f', values, 1), 'check normal fill')
+
 end
 
 
@@ -155,6 +186,26 @@ love.test.math.Transform = function(test)
   local opx2, opy2 = inverseDestinationTransform:transformPoint(0, 0)
   test:assertCoords({opx1, opy1}, {opx2, opy2}, 'check inverse and inverseOf produce same values')
 
+  -- check transforming points in bulk matches single points
+  transform:reset()
+  transform:setTransformation(4, 2, math.pi / 2, 2, 3)
+  local points = {1, 1, -2, 5}
+  transform:transformPoints(points)
+  px, py = transform:transformPoint(-2, 5)
+  test:assertCoords({px, py}, {points[3], points[4]}, 'check transformPoints table')
+  transform:inverseTransformPoints(points)
+  test:assertRange(points[1], 0.999, 1.001, 'check inverseTransformPoints table x')
+  test:assertRange(points[2], 0.999, 1.001, 'check inverseTransformPoints table y')
+  local pointdata = love.data.newByteData(love.data.pack('data', 'ffff', 1, 1, -2, 5))
+  transform:transformPoints(pointdata, 2)
+  local dx1, dy1, dx2, dy2 = love.data.unpack('ffff', pointdata)
+  px, py = transform:transformPoint(1, 1)
+  test:assertCoords({px, py}, {dx1, dy1}, 'check transformPoints data')
+  transform:inverseTransformPoints(pointdata)
+  dx1, dy1, dx2, dy2 = love.data.unpack('ffff', pointdata)
+  test:assertRange(dx2, -2.001, -1.999, 'check inverseTransformPoints data x')
+  test:assertRange(dy2, 4.999, 5.001, 'check inverseTransformPoints data y')
+
   -- check matrix manipulation
   transform:setTransformation(0, 0, 0, 1, 1, 0, 0, 0, 0)
   transform:translate(4, 4)
@@ -301,6 +352,40 @@ love.test.math.newTransform = function(test)
 end
 
 
+-- love.math.noiseField
+love.test.math.noiseField = function(test)
+  -- a single octave matches individual noise calls
+  local field = love.data.newByteData(4 * 4 * 2)
+  love.math.noiseField('perlin', field, 4, 0.5, 0.25, 0.1, 0.2)
+  local expected = love.data.unpack('f', love.data.pack('string', 'f', love.math.perlinNoise(0.5 + 3 * 0.1, 0.25 + 0.2)))
+  test:assertEquals(expected, love.data.unpack('f', field, (4 + 3) * 4 + 1), 'check perlin field value')
+  -- fractal octaves stay in range and fill ImageData
+  local imgdata = love.image.newImageData(8, 8, 'r32f')
+  love.math.noiseField('simplex', imgdata, 0, 0, 0.1, 0.1, 4, 2, 0.5)
+  local r1 = imgdata:getPixel(1, 1)
+  local r2 = imgdata:getPixel(6, 6)
+  test:assertRange(r1, 0, 1, 'check simplex field range')
+  test:assertNotEquals(r1, r2, 'check simplex field varies')
+  -- filling row ranges separately matches filling the whole field
+  local whole = love.data.newByteData(16 * 8 * 4)
+  local parts = love.data.newByteData(16 * 8 * 4)
+  love.math.noiseField('simplex', whole, 16, 3.7, -1.3, 0.13, 0.07, 3)
+  love.math.noiseField('simplex', parts, 16, 3.7, -1.3, 0.13, 0.07, 3, 2, 0.5, 1, 3)
+  love.math.noiseField('simplex', parts, 16, 3.7, -1.3, 0.13, 0.07, 3, 2, 0.5, 4)
+  test:assertEquals(whole:getString(), parts:getString(), 'check row ranges match whole field')
+  -- rows outside the range are left untouched
+  local ranged = love.image.newImageData(8, 8, 'r32f')
+  love.math.noiseField('perlin', ranged, 0, 0, 0.1, 0.1, 1, 2, 0.5, 3, 2)
+  test:assertEquals(0, ranged:getPixel(4, 1), 'check row before range untouched')
+  test:assertEquals(0, ranged:getPixel(4, 4), 'check row after range untouched')
+  test:assertNotEquals(0, ranged:getPixel(4, 3), 'check row in range filled')
+  test:assertFalse(pcall(love.math.noiseField, 'perlin', ranged, 0, 0, 0.1, 0.1, 1, 2, 0.5, 9),
+    'check first row out of range')
+  test:assertFalse(pcall(love.math.noiseField, 'perlin', ranged, 0, 0, 0.1, 0.1, 1, 2, 0.5, 7, 3),
+    'check row count out of range')
+end
+
+
 -- love.math.perlinNoise
 love.test.math.perlinNoise = function(test)
   -- check some noise values
@@ -376,3 +461,28 @@ love.test.math.triangulate = function(test)
   test:assertEquals(3, #triangles1, 'check polygon triangles')
   test:assertEquals(3, #triangles2, 'check polygon triangles')
 end
+
+
+-- love.math.triangulateIndices
+love.test.math.triangulateIndices = function(test)
+  local square = {0, 0, 10, 0, 10, 10, 0, 10}
+  local indices1 = love.math.triangulateIndices(square)
+  test:assertEquals(6, #indices1, 'check polygon indices')
+  -- holes may use either winding
+  local hole1 = {3, 3, 3, 7, 7, 7, 7, 3}
+  local hole2 = {8, 1, 9, 1, 9, 2}
+  local indices2 = love.math.triangulateIndices(square, {hole1, hole2})
+  test:assertEquals((4 + 4 + 3 + 2 * 2 - 2) * 3, #indices2, 'check polygon with holes indices')
+  local points = {}
+  for _, ring in ipairs({square, hole1, hole2}) do
+    for i=1,#ring,2 do
+      table.insert(points, {ring[i], ring[i+1]})
+    end
+  end
+  local area = 0
+  for i=1,#indices2,3 do
+    local a, b, c = points[indices2[i]], points[indices2[i+1]], points[indices2[i+2]]
+    area = area + math.abs((b[1] - a[1]) * (c[2] - a[2]) - (b[2] - a[2]) * (c[1] - a[1])) / 2
+  end
+  test:assertRange(area, 100 - 16 - 0.5 - 0.001, 100 - 16 - 0.5 + 0.001, 'check triangulated area')
+end
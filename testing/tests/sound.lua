@@ -37,6 +37,40 @@ love.test.sound.Decoder = function(test)
   test:assertRange(clone:getDuration(), 0.06, 0.07, 'check cloned duration')
   test:assertEquals(44100, clone:getSampleRate(), 'check cloned sample rate')
 
+  -- check seeking is sample accurate
+  local full = love.sound.newSoundData('resources/click.ogg')
+  local seeker = love.sound.newDecoder('resources/click.ogg')
+  seeker:seek(1000/44100)
+  local seekdata = seeker:decode()
+  test:assertRange(seekdata:getSample(0, 1), full:getSample(1000, 1) - 0.0001,
+    full:getSample(1000, 1) + 0.0001, 'check seeked sample')
+
+  -- check mp3 seeking lands on the same samples as a full decode, and that
+  -- getting the duration doesn't move the decoder
+  local mp3full = love.sound.newSoundData('resources/tone.mp3')
+  local mp3 = love.sound.newDecoder('resources/tone.mp3', 2048)
+  local first = mp3:decode()
+  test:assertRange(mp3:getDuration(), 1.04, 1.05, 'check mp3 duration')
+  local nextchunk = mp3:decode()
+  local firstcount = first:getSampleCount()
+  test:assertEquals(mp3full:getSample(firstcount), nextchunk:getSample(0), 'check mp3 position kept')
+  for _, seconds in ipairs({0.75, 0.25, 0.5}) do
+    mp3:seek(seconds)
+    local chunk = mp3:decode()
+    local frame = seconds*44100
+    for i=0,chunk:getSampleCount()-1,97 do
+      test:assertEquals(mp3full:getSample(frame + i), chunk:getSample(i),
+        'check mp3 seek ' .. seconds .. ' sample ' .. i)
+    end
+  end
+
+  -- check float decoding
+  local fdecoder = love.sound.newDecoder('resources/click.ogg', nil, nil, 32)
+  test:assertEquals(32, fdecoder:getBitDepth(), 'check float bit depth')
+  test:assertEquals(32, fdecoder:clone():getBitDepth(), 'check cloned float bit depth')
+  local fdata = fdecoder:decode()
+  test:assertEquals(32, fdata:getBitDepth(), 'check float decoded bit depth')
+
 end
 
 
@@ -92,6 +126,39 @@ love.test.sound.SoundData = function(test)
   local slice = copy1:slice(0, count)
   test:assertEquals(count, slice:getSampleCount(), 'check slice length')
 
+  -- check float sound data
+  local fdata = love.sound.newSoundData(100, 44100, 32, 2)
+  test:assertEquals(32, fdata:getBitDepth(), 'check float bit depth')
+  test:assertEquals(100*4*2, fdata:getSize(), 'check float size')
+  fdata:setSample(10, 1, 1.5)
+  test:assertEquals(1.5, fdata:getSample(10, 1), 'check float sample is unclamped')
+
+  -- check gain and mixing
+  fdata:applyGain(0.5)
+  test:assertEquals(0.75, fdata:getSample(10, 1), 'check applied gain')
+  local fother = love.sound.newSoundData(100, 44100, 32, 2)
+  fother:setSample(10, 1, 0.5)
+  fdata:mix(fother, 0, 100, 0, 0.5)
+  test:assertEquals(1, fdata:getSample(10, 1), 'check mixed sample')
+  local idata = love.sound.newSoundData(100, 44100, 16, 2)
+  idata:mix(fdata, 0, 100, 0, 2)
+  test:assertEquals(1, idata:getSample(10, 1), 'check integer mix saturates')
+  local ok = pcall(fdata.mix, fdata, fother, 50, 2147483600, 50)
+  test:assertFalse(ok, 'check huge mix count rejected')
+  ok = pcall(fdata.applyGain, fdata, 0.5, 50, 2147483600)
+  test:assertFalse(ok, 'check huge gain count rejected')
+
+  -- check conversion and resampling
+  local mono = fdata:convert(16, 1)
+  test:assertEquals(16, mono:getBitDepth(), 'check converted bit depth')
+  test:assertEquals(1, mono:getChannelCount(), 'check converted channel count')
+  test:assertEquals(100, mono:getSampleCount(), 'check converted sample count')
+  test:assertRange(mono:getSample(10), 0.49, 0.51, 'check down-mixed sample')
+  local resampled = fdata:resample(22050)
+  test:assertEquals(50, resampled:getSampleCount(), 'check resampled sample count')
+  test:assertEquals(22050, resampled:getSampleRate(), 'check resampled sample rate')
+  test:assertEquals(1, resampled:getSample(5, 1), 'check resampled sample')
+
 end
 
 